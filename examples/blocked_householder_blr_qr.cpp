@@ -41,7 +41,7 @@ int main(int argc, char** argv) {
   timing::stopAndPrint("BLR-QR", 1);
   
   //Q has same structure as A but initialized with identity
-  Hierarchical Q(identity, randpts, m, n, b, eps, admis, p, q);
+  Hierarchical Q(A, FillType::Identity);
   left_multiply_blocked_reflector(A, T, Q, false);
 
   print("BLR-QR Accuracy");
@@ -56,8 +56,8 @@ int main(int argc, char** argv) {
   print("Compression Accuracy");
   print("Rel. L2 Error", l2_error(D, A), false);
 
-  Hierarchical Q(A);
-  Hierarchical R(A);
+  Hierarchical Q(A, FillType::Zero);
+  Hierarchical R(A, FillType::Zero);
   print("Blocked Modified Gram-Schmidt H-QR");
   print("Time");
   timing::start("H-QR");
@@ -69,7 +69,7 @@ int main(int argc, char** argv) {
   trmm(R, QR, FRANK::Side::Right, FRANK::Mode::Upper, 'n', 'n', 1.);
   print("Residual", l2_error(D, QR), false);
   
-  Hierarchical QtQ(zeros, randx, N, N, nleaf, eps, admis, nblocks, nblocks);
+  Hierarchical QtQ(A, FillType::Zero);
   const Hierarchical Qt = transpose(Q);
   gemm(Qt, Q, QtQ, 1, 0);
   print("Orthogonality", l2_error(Dense(identity, randx, N, N), QtQ), false);
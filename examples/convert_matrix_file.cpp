@@ -0,0 +1,23 @@
+#include "FRANK/FRANK.h"
+
+#include <cstring>
+#include <iostream>
+#include <string>
+
+using namespace FRANK;
+using namespace std;
+
+int main(int argc, char** argv) {
+  if (argc < 3) {
+    cerr << "Usage: " << argv[0] << " text_file binary_file [row|col]" << endl;
+    return 1;
+  }
+  const MatrixLayout ordering = (
+    argc > 3 && strcmp(argv[3], "col") == 0
+    ? MatrixLayout::ColumnMajor : MatrixLayout::RowMajor
+  );
+  timing::start("Convert");
+  convert_matrix_file(argv[1], argv[2], ordering);
+  timing::stopAndPrint("Convert");
+  return 0;
+}
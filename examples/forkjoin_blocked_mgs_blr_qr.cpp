@@ -43,8 +43,8 @@ int main(int argc, char** argv) {
   print("BLR Compression Accuracy");
   print("Rel. L2 Error", l2_error(D, A), false);
 
-  //Q and R have same structure as A but initially contain zeros
-  Hierarchical Q(zeros, randpts, m, n, b, eps, admis, p, q);
+  //Q has same structure as A, R is square, both initially contain zeros
+  Hierarchical Q(A, FillType::Zero);
   Hierarchical R(zeros, randpts, n, n, b, eps, admis, q, q);
   print("Forkjoin Blocked Modified Gram-Schmidt BLR-QR");
   print("Number of Threads: ", omp_get_max_threads());
@@ -78,7 +78,7 @@ int main(int argc, char** argv) {
   trmm(R, QR, FRANK::Side::Right, FRANK::Mode::Upper, 'n', 'n', 1.);
   print("Residual", l2_error(D, QR), false);
   //Orthogonality
-  Hierarchical QtQ(zeros, randpts, n, n, b, eps, admis, q, q);
+  Hierarchical QtQ(R, FillType::Zero);
   const Hierarchical Qt = transpose(Q);
   gemm(Qt, Q, QtQ, 1, 0);
   print("Orthogonality", l2_error(Dense(identity, {}, n, n), QtQ), false);
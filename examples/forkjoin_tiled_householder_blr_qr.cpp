@@ -70,7 +70,7 @@ int main(int argc, char** argv) {
   print("BLR-QR", toc-tic);
 
   //Q has same structure as A but initialized with identity
-  Hierarchical Q(identity, randpts, m, n, b, eps, admis, p, q);
+  Hierarchical Q(A, FillType::Identity);
   for(int64_t k = q-1; k >= 0; k--) {
     for(int64_t i = p-1; i > k; i--) {
       #pragma omp parallel for schedule(dynamic)
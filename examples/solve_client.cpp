@@ -0,0 +1,125 @@
+#include "FRANK/FRANK.h"
+#include "solve_server_protocol.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+
+using namespace FRANK;
+using Clock = std::chrono::steady_clock;
+
+// Load generator for solve_server. Each client computes b = A*x for random x
+// with a Matvec request, solves for x again with a Solve request and checks
+// the result.
+//
+// Usage: solve_client socket N [clients] [requests] [n_rhs] [shutdown]
+
+int connect_to(const std::string& socket_path) {
+  const int connection = socket(AF_UNIX, SOCK_STREAM, 0);
+  const sockaddr_un address = socket_address(socket_path);
+  if (
+    connection == -1
+    || connect(connection, reinterpret_cast<const sockaddr*>(&address), sizeof(address)) != 0
+  ) {
+    std::perror(socket_path.c_str());
+    std::exit(1);
+  }
+  return connection;
+}
+
+Dense request(const int connection, const Operation operation, const Dense& rhs) {
+  const MessageHeader header{operation, rhs.dim[0], rhs.dim[1]};
+  MessageHeader reply;
+  const uint64_t n_bytes = rhs.dim[0]*rhs.dim[1]*sizeof(double);
+  Dense result(rhs.dim[0], rhs.dim[1]);
+  if (
+    !write_all(connection, &header, sizeof(header))
+    || !write_all(connection, &rhs, n_bytes)
+    || !read_all(connection, &reply, sizeof(reply))
+    || reply.n_rows != rhs.dim[0]
+    || !read_all(connection, &result, n_bytes)
+  ) {
+    std::cerr << "Request failed" << std::endl;
+    std::exit(1);
+  }
+  return result;
+}
+
+int main(int argc, char** argv) {
+  FRANK::initialize();
+  if (argc < 3) {
+    std::cerr << "Usage: " << argv[0] << " socket N [clients] [requests]"
+              << " [n_rhs] [shutdown]" << std::endl;
+    return 1;
+  }
+  const std::string socket_path = argv[1];
+  const int64_t N = atoi(argv[2]);
+  const int64_t n_clients = argc > 3 ? atoi(argv[3]) : 8;
+  const int64_t n_requests = argc > 4 ? atoi(argv[4]) : 16;
+  const int64_t n_rhs = argc > 5 ? atoi(argv[5]) : 1;
+  const bool stop_server = argc > 6 && std::strcmp(argv[6], "shutdown") == 0;
+
+  std::mutex mutex;
+  double max_error = 0, max_latency = 0, total_latency = 0;
+  const Clock::time_point start = Clock::now();
+  std::vector<std::thread> clients;
+  for (int64_t c=0; c<n_clients; ++c) {
+    clients.emplace_back([&]() {
+      const int connection = connect_to(socket_path);
+      for (int64_t r=0; r<n_requests; ++r) {
+        const Dense x(random_uniform, {}, N, n_rhs);
+        const Clock::time_point sent = Clock::now();
+        const Dense b = request(connection, Operation::Matvec, x);
+        const Dense x_solved = request(connection, Operation::Solve, b);
+        const double latency = std::chrono::duration<double>(
+          Clock::now() - sent
+        ).count();
+        const double error = l2_error(x, x_solved);
+        std::lock_guard<std::mutex> lock(mutex);
+        max_error = std::max(max_error, error);
+        max_latency = std::max(max_latency, latency);
+        total_latency += latency;
+      }
+      close(connection);
+    });
+  }
+  for (std::thread& client : clients) client.join();
+  const double elapsed = std::chrono::duration<double>(Clock::now() - start).count();
+
+  const int64_t n_round_trips = n_clients * n_requests;
+  print("Client");
+  print("Rel. L2 Error", max_error, false);
+  print("Mean matvec+solve latency [s]", total_latency / n_round_trips, false);
+  print("Max matvec+solve latency [s]", max_latency, false);
+  print("Throughput [rhs/s]", 2 * n_round_trips * n_rhs / elapsed, false);
+
+  const int connection = connect_to(socket_path);
+  MessageHeader header{Operation::Statistics, 0, 0};
+  if (write_all(connection, &header, sizeof(header)) && read_all(connection, &header, sizeof(header))) {
+    std::string text(header.n_rows, '\0');
+    if (read_all(connection, &text[0], text.size())) {
+      print("Server");
+      std::cout << text;
+    }
+  }
+  if (stop_server) {
+    header = {Operation::Shutdown, 0, 0};
+    write_all(connection, &header, sizeof(header));
+    read_all(connection, &header, sizeof(header));
+  }
+  close(connection);
+  return 0;
+}
@@ -0,0 +1,400 @@
+#include "FRANK/FRANK.h"
+#include "solve_server_protocol.h"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cerrno>
+#include <condition_variable>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <deque>
+#include <fstream>
+#include <future>
+#include <iostream>
+#include <memory>
+#include <mutex>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+
+using namespace FRANK;
+using Clock = std::chrono::steady_clock;
+
+// Keeps an H-matrix and its LU factorization in memory and serves solve and
+// matrix-vector product requests over a Unix domain socket. Requests that
+// arrive while a batch is being computed are combined into a single
+// multi-RHS trsm or gemm.
+//
+// Usage: solve_server socket [N|operator_file] [nleaf] [eps] [max_batch]
+//                            [batch_delay_us]
+// With a number, a Laplace kernel matrix of that size is compressed. With a
+// file written by save(), the operator is loaded and its factorization is
+// checkpointed to operator_file.lu, so that a restarted server does not
+// factorize again. The size, modification time and checksum of the operator
+// file are kept in operator_file.lu.source, and the factorization is redone
+// when any of them changed. Requests with more than max_batch right hand sides
+// are rejected and their connection is closed.
+
+struct Request {
+  Operation operation;
+  Dense rhs;
+  std::promise<Dense> result;
+  Clock::time_point arrival;
+};
+
+struct Statistics {
+  int64_t requests = 0;
+  int64_t rhs = 0;
+  int64_t batches = 0;
+  double total_latency = 0;
+  double max_latency = 0;
+  double compute_time = 0;
+};
+
+class SolveServer {
+ public:
+  const Hierarchical& A;
+  const Hierarchical& L;
+  const Hierarchical& U;
+  const int64_t max_batch;
+  const std::chrono::microseconds batch_delay;
+  std::mutex mutex;
+  std::condition_variable request_ready;
+  std::deque<std::shared_ptr<Request>> queue;
+  // Set by a shutdown request, stops accepting connections
+  std::atomic<bool> stopping{false};
+  // Set once no more requests can arrive, stops the worker
+  bool finished = false;
+  Statistics statistics;
+  const Clock::time_point start = Clock::now();
+
+  SolveServer(
+    const Hierarchical& A, const Hierarchical& L, const Hierarchical& U,
+    const int64_t max_batch, const std::chrono::microseconds batch_delay
+  ) : A(A), L(L), U(U), max_batch(max_batch), batch_delay(batch_delay) {}
+
+  std::future<Dense> submit(const Operation operation, Dense&& rhs) {
+    std::shared_ptr<Request> request = std::make_shared<Request>();
+    request->operation = operation;
+    request->rhs = std::move(rhs);
+    request->arrival = Clock::now();
+    std::future<Dense> result = request->result.get_future();
+    {
+      std::lock_guard<std::mutex> lock(mutex);
+      queue.push_back(request);
+    }
+    request_ready.notify_one();
+    return result;
+  }
+
+  // Take up to max_batch right hand sides of the same operation as the oldest
+  // request
+  std::vector<std::shared_ptr<Request>> next_batch() {
+    std::unique_lock<std::mutex> lock(mutex);
+    request_ready.wait(lock, [this]() { return !queue.empty() || finished; });
+    if (queue.empty()) return {};
+    // Give concurrent clients a moment to add to the batch
+    request_ready.wait_for(lock, batch_delay, [this]() {
+      int64_t n_rhs = 0;
+      for (const std::shared_ptr<Request>& request : queue) {
+        n_rhs += request->rhs.dim[1];
+      }
+      return n_rhs >= max_batch || stopping;
+    });
+    std::vector<std::shared_ptr<Request>> batch;
+    const Operation operation = queue.front()->operation;
+    int64_t n_rhs = 0;
+    for (auto it=queue.begin(); it!=queue.end();) {
+      if (
+        (*it)->operation == operation
+        && (batch.empty() || n_rhs + (*it)->rhs.dim[1] <= max_batch)
+      ) {
+        n_rhs += (*it)->rhs.dim[1];
+        batch.push_back(*it);
+        it = queue.erase(it);
+      } else {
+        ++it;
+      }
+    }
+    return batch;
+  }
+
+  void run() {
+    while (true) {
+      std::vector<std::shared_ptr<Request>> batch = next_batch();
+      if (batch.empty()) return;
+      const Clock::time_point compute_start = Clock::now();
+      int64_t n_rhs = 0;
+      for (const std::shared_ptr<Request>& request : batch) {
+        n_rhs += request->rhs.dim[1];
+      }
+      // Gather all right hand sides as columns of one matrix
+      Dense B(get_n_rows(A), n_rhs);
+      int64_t offset = 0;
+      for (const std::shared_ptr<Request>& request : batch) {
+        const Dense& rhs = request->rhs;
+        for (int64_t i=0; i<rhs.dim[0]; ++i) {
+          for (int64_t j=0; j<rhs.dim[1]; ++j) {
+            B(i, offset+j) = rhs(i, j);
+          }
+        }
+        offset += rhs.dim[1];
+      }
+      Dense X;
+      if (batch[0]->operation == Operation::Solve) {
+        trsm(L, B, Mode::Lower);
+        trsm(U, B, Mode::Upper);
+        X = std::move(B);
+      } else {
+        X = Dense(get_n_rows(A), n_rhs);
+        gemm(A, B, X, 1, 0);
+      }
+      const Clock::time_point compute_end = Clock::now();
+      offset = 0;
+      for (const std::shared_ptr<Request>& request : batch) {
+        Dense result(request->rhs.dim[0], request->rhs.dim[1]);
+        X.copy_to(result, 0, offset);
+        offset += result.dim[1];
+        request->result.set_value(std::move(result));
+      }
+      std::lock_guard<std::mutex> lock(mutex);
+      statistics.batches++;
+      statistics.compute_time += std::chrono::duration<double>(
+        compute_end - compute_start
+      ).count();
+      for (const std::shared_ptr<Request>& request : batch) {
+        const double latency = std::chrono::duration<double>(
+          compute_end - request->arrival
+        ).count();
+        statistics.requests++;
+        statistics.rhs += request->rhs.dim[1];
+        statistics.total_latency += latency;
+        statistics.max_latency = std::max(statistics.max_latency, latency);
+      }
+    }
+  }
+
+  std::string report() {
+    std::lock_guard<std::mutex> lock(mutex);
+    const double elapsed = std::chrono::duration<double>(
+      Clock::now() - start
+    ).count();
+    const Statistics& s = statistics;
+    std::ostringstream out;
+    out << "requests " << s.requests << "\n"
+        << "right hand sides " << s.rhs << "\n"
+        << "batches " << s.batches << "\n"
+        << "mean batch size " << (s.batches > 0 ? double(s.rhs) / s.batches : 0) << "\n"
+        << "mean latency [s] " << (s.requests > 0 ? s.total_latency / s.requests : 0) << "\n"
+        << "max latency [s] " << s.max_latency << "\n"
+        << "compute time [s] " << s.compute_time << "\n"
+        << "throughput [rhs/s] " << s.rhs / elapsed << "\n";
+    return out.str();
+  }
+
+  void stop() {
+    stopping = true;
+    request_ready.notify_all();
+  }
+
+  void finish() {
+    {
+      std::lock_guard<std::mutex> lock(mutex);
+      finished = true;
+    }
+    request_ready.notify_all();
+  }
+};
+
+void serve_connection(SolveServer& server, const int connection, const int listener) {
+  MessageHeader header;
+  while (read_all(connection, &header, sizeof(header))) {
+    MessageHeader reply = header;
+    if (header.operation == Operation::Statistics) {
+      const std::string text = server.report();
+      reply.n_rows = text.size();
+      reply.n_cols = 0;
+      if (!write_all(connection, &reply, sizeof(reply))) break;
+      if (!write_all(connection, text.data(), text.size())) break;
+      continue;
+    }
+    if (header.operation == Operation::Shutdown) {
+      write_all(connection, &reply, sizeof(reply));
+      server.stop();
+      // Wake up the accept loop
+      shutdown(listener, SHUT_RDWR);
+      break;
+    }
+    // Check the size before allocating, a malformed header must not be able
+    // to exhaust the memory of the server
+    const bool valid = (
+      (header.operation == Operation::Solve || header.operation == Operation::Matvec)
+      && header.n_rows == get_n_rows(server.A)
+      && header.n_cols > 0 && header.n_cols <= server.max_batch
+    );
+    if (!valid) {
+      reply.n_rows = -1;
+      write_all(connection, &reply, sizeof(reply));
+      break;
+    }
+    Dense rhs(header.n_rows, header.n_cols);
+    if (!read_all(connection, &rhs, header.n_rows*header.n_cols*sizeof(double))) break;
+    const Dense result = server.submit(header.operation, std::move(rhs)).get();
+    if (!write_all(connection, &reply, sizeof(reply))) break;
+    if (!write_all(connection, &result, result.dim[0]*result.dim[1]*sizeof(double))) break;
+  }
+}
+
+// Thread serving one client. The socket is closed by the accept loop after
+// joining the thread, so that it is never reused while still referenced.
+struct Connection {
+  std::thread thread;
+  int socket;
+  std::shared_ptr<std::atomic<bool>> done;
+};
+
+// Identifies the operator file the checkpointed factorization belongs to
+std::string describe_source(const std::string& source, const Hierarchical& A) {
+  struct stat status;
+  if (stat(source.c_str(), &status) != 0) {
+    std::perror(source.c_str());
+    std::exit(1);
+  }
+  std::ostringstream out;
+  out << status.st_size << " " << status.st_mtim.tv_sec << "."
+      << status.st_mtim.tv_nsec << " " << fingerprint(A) << "\n";
+  return out.str();
+}
+
+std::string read_text(const std::string& filename) {
+  std::ifstream file(filename);
+  std::ostringstream out;
+  out << file.rdbuf();
+  return out.str();
+}
+
+int main(int argc, char** argv) {
+  FRANK::initialize();
+  if (argc < 2) {
+    std::cerr << "Usage: " << argv[0] << " socket [N|operator_file] [nleaf]"
+              << " [eps] [max_batch] [batch_delay_us]" << std::endl;
+    return 1;
+  }
+  const std::string socket_path = argv[1];
+  const std::string source = argc > 2 ? argv[2] : "1024";
+  const int64_t nleaf = argc > 3 ? atoi(argv[3]) : 32;
+  const double eps = argc > 4 ? atof(argv[4]) : 1e-8;
+  const int64_t max_batch = argc > 5 ? atoi(argv[5]) : 64;
+  const int64_t batch_delay = argc > 6 ? atoi(argv[6]) : 200;
+
+  timing::start("Setup");
+  Hierarchical A;
+  std::string checkpoint;
+  if (source.find_first_not_of("0123456789") == std::string::npos) {
+    const int64_t N = std::stoll(source);
+    const std::vector<std::vector<double>> randx{ get_sorted_random_vector(N) };
+    A = Hierarchical(laplacend, randx, N, N, nleaf, eps, 0, 2, 2);
+  } else {
+    A = Hierarchical(load(source));
+    checkpoint = source + ".lu";
+  }
+  Hierarchical A_work(A), L, U;
+  if (checkpoint.empty()) {
+    std::tie(L, U) = getrf(A_work);
+  } else {
+    const std::string description_file = checkpoint + ".source";
+    const std::string description = describe_source(source, A);
+    const std::string previous = read_text(description_file);
+    if (previous != description) {
+      if (!previous.empty()) print("Operator file changed, factorizing again");
+      std::remove(checkpoint.c_str());
+    }
+    std::tie(L, U) = getrf(A_work, checkpoint, 4);
+    std::ofstream(description_file) << description;
+  }
+  timing::stopAndPrint("Setup");
+
+  const int listener = socket(AF_UNIX, SOCK_STREAM, 0);
+  const sockaddr_un address = socket_address(socket_path);
+  unlink(socket_path.c_str());
+  if (
+    listener == -1
+    || bind(listener, reinterpret_cast<const sockaddr*>(&address), sizeof(address)) != 0
+    || listen(listener, 64) != 0
+  ) {
+    std::perror(socket_path.c_str());
+    return 1;
+  }
+  print("Listening on " + socket_path);
+
+  SolveServer server(
+    A, L, U, max_batch, std::chrono::microseconds(batch_delay)
+  );
+  std::thread worker(&SolveServer::run, &server);
+  std::vector<Connection> connections;
+  while (!server.stopping) {
+    const int client = accept(listener, nullptr, nullptr);
+    // Join the threads of clients that disconnected, so that the list only
+    // holds open connections and their descriptors are available again
+    for (auto it=connections.begin(); it!=connections.end();) {
+      if (*it->done) {
+        it->thread.join();
+        close(it->socket);
+        it = connections.erase(it);
+      } else {
+        ++it;
+      }
+    }
+    if (client == -1) {
+      const int error = errno;
+      if (server.stopping || error == EINTR || error == ECONNABORTED) continue;
+      std::perror("accept");
+      // Running out of descriptors or memory may be temporary, anything else
+      // means that the listener is unusable
+      if (
+        error != EMFILE && error != ENFILE && error != ENOBUFS && error != ENOMEM
+      ) {
+        server.stop();
+        break;
+      }
+      std::this_thread::sleep_for(std::chrono::milliseconds(100));
+      continue;
+    }
+    std::shared_ptr<std::atomic<bool>> done = std::make_shared<std::atomic<bool>>(false);
+    connections.push_back({
+      std::thread([&server, client, listener, done]() {
+        serve_connection(server, client, listener);
+        // Let the client see the end of the connection right away, the
+        // descriptor itself is closed once the thread is joined
+        shutdown(client, SHUT_RDWR);
+        *done = true;
+      }),
+      client, done
+    });
+  }
+  // Disconnect idle clients, requests in progress are still answered
+  for (const Connection& connection : connections) {
+    shutdown(connection.socket, SHUT_RD);
+  }
+  for (Connection& connection : connections) {
+    connection.thread.join();
+    close(connection.socket);
+  }
+  server.finish();
+  worker.join();
+  close(listener);
+  unlink(socket_path.c_str());
+  std::cout << server.report();
+  return 0;
+}
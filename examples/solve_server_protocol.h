@@ -0,0 +1,59 @@
+#ifndef FRANK_examples_solve_server_protocol_h
+#define FRANK_examples_solve_server_protocol_h
+
+#include <cstdint>
+#include <string>
+
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+
+// Messages exchanged over the Unix domain socket of solve_server. Every
+// request and reply starts with a MessageHeader. Solve and Matvec requests and
+// their replies continue with n_rows*n_cols doubles holding the right hand
+// sides (or results) row by row. A Statistics reply continues with n_rows
+// bytes of text. A reply with n_rows = -1 reports an invalid request, for
+// example one whose n_rows differs from the size of the operator or whose
+// n_cols exceeds the batch size of the server, after which the server closes
+// the connection.
+enum class Operation : int64_t { Solve, Matvec, Statistics, Shutdown };
+
+struct MessageHeader {
+  Operation operation;
+  int64_t n_rows;
+  int64_t n_cols;
+};
+
+inline bool read_all(const int socket_fd, void* data, const uint64_t n_bytes) {
+  char* bytes = static_cast<char*>(data);
+  uint64_t done = 0;
+  while (done < n_bytes) {
+    const ssize_t n = read(socket_fd, bytes+done, n_bytes-done);
+    if (n <= 0) return false;
+    done += n;
+  }
+  return true;
+}
+
+inline bool write_all(
+  const int socket_fd, const void* data, const uint64_t n_bytes
+) {
+  const char* bytes = static_cast<const char*>(data);
+  uint64_t done = 0;
+  while (done < n_bytes) {
+    const ssize_t n = send(socket_fd, bytes+done, n_bytes-done, MSG_NOSIGNAL);
+    if (n <= 0) return false;
+    done += n;
+  }
+  return true;
+}
+
+inline sockaddr_un socket_address(const std::string& path) {
+  sockaddr_un address{};
+  address.sun_family = AF_UNIX;
+  path.copy(address.sun_path, sizeof(address.sun_path)-1);
+  return address;
+}
+
+#endif // FRANK_examples_solve_server_protocol_h
@@ -87,7 +87,7 @@ int main(int argc, char** argv) {
   print("BLR-QR", toc-tic);
 
   //Q has same structure as A but initialized with identity
-  Hierarchical Q(identity, randpts, m, n, b, eps, admis, p, q);
+  Hierarchical Q(A, FillType::Identity);
   #pragma omp parallel
   {
     #pragma omp single
@@ -2,11 +2,19 @@
 #define FRANK_classes_h
 
 
+#include "FRANK/classes/basic_dense.h"
+#include "FRANK/classes/basic_low_rank.h"
 #include "FRANK/classes/dense.h"
+#include "FRANK/classes/diagonal.h"
 #include "FRANK/classes/empty.h"
 #include "FRANK/classes/hierarchical.h"
+#include "FRANK/classes/identity.h"
 #include "FRANK/classes/low_rank.h"
+#include "FRANK/classes/matrix_product.h"
 #include "FRANK/classes/matrix_proxy.h"
 #include "FRANK/classes/matrix.h"
+#include "FRANK/classes/mixed_precision_low_rank.h"
+#include "FRANK/classes/out_of_core_hierarchical.h"
+#include "FRANK/classes/permuted_hierarchical.h"
 
 #endif // FRANK_classes_h
@@ -0,0 +1,163 @@
+/**
+ * @file basic_dense.h
+ * @brief Include the `BasicDense` class template for non-`double` scalars.
+ *
+ * @copyright Copyright (c) 2020
+ */
+#ifndef FRANK_classes_basic_dense_h
+#define FRANK_classes_basic_dense_h
+
+#include "FRANK/classes/matrix.h"
+
+#include <array>
+#include <complex>
+#include <cstdint>
+#include <vector>
+
+
+/**
+ * @brief General namespace of the FRANK library
+ */
+namespace FRANK
+{
+
+class Dense;
+
+/**
+ * @brief Class template handling a dense matrix of scalar type \p T
+ *
+ * @tparam T
+ * Scalar type. The template is instantiated for `float`,
+ * `std::complex<float>` and `std::complex<double>`, which map to the \p s,
+ * \p c and \p z routines of BLAS and LAPACK respectively. `double` matrices
+ * are handled by `Dense`.
+ *
+ * Like `Dense`, elements are stored in row-major order. Unlike `Dense`, a
+ * `BasicDense` always owns its elements, no shared submatrices are created.
+ * Each instantiation is a subclass of `Matrix` and registered with the open
+ * multi-methods, so that it can be stored in a `Hierarchical` or
+ * `MatrixProxy` and used with type independent functions such as
+ * get_n_rows(), norm() or get_memory_usage(). An `SDense` can be converted
+ * back to `Dense` with Dense(const Matrix&).
+ *
+ * The operations available for `BasicDense` are gemm(), trsm() and getrf().
+ * `BasicLowRank` compresses blocks of the same scalar type, and a
+ * `Hierarchical` matrix built from such blocks can be multiplied with a
+ * `BasicDense` matrix by gemm(). The other operations on `LowRank` and
+ * `Hierarchical` matrices remain `double` only.
+ */
+template<typename T>
+class BasicDense : public Matrix {
+ public:
+  /**
+   * @brief Scalar type of the elements
+   */
+  using value_type = T;
+  /**
+   * @brief Dimension of the matrix {rows, columns}
+   */
+  std::array<int64_t, 2> dim = {0, 0};
+  /**
+   * @brief Stride of the array in memory, always equal to `dim[1]`
+   */
+  int64_t stride = 0;
+ private:
+  std::vector<T> data;
+ public:
+  // Special member functions
+  BasicDense() = default;
+
+  virtual ~BasicDense() = default;
+
+  BasicDense(const BasicDense& A) = default;
+
+  BasicDense& operator=(const BasicDense& A) = default;
+
+  BasicDense(BasicDense&& A) = default;
+
+  BasicDense& operator=(BasicDense&& A) = default;
+
+  /**
+   * @brief Construct a new `BasicDense` object given the desired size
+   *
+   * @param n_rows
+   * Number of rows of the new matrix.
+   * @param n_cols
+   * Number of columns of the new matrix.
+   *
+   * All elements are initialized to zero.
+   */
+  BasicDense(const int64_t n_rows, const int64_t n_cols=1);
+
+  /**
+   * @brief Convert a `Dense` matrix to scalar type \p T
+   *
+   * @param A
+   * `Dense` matrix to be converted.
+   *
+   * Elements are rounded to `float` or become the real parts of complex
+   * elements.
+   */
+  explicit BasicDense(const Dense& A);
+
+  /**
+   * @brief Access an element of the matrix
+   *
+   * @param i
+   * Row index.
+   * @param j
+   * Column index.
+   * @return T&
+   * Reference to the element at (\p i, \p j).
+   */
+  T& operator()(const int64_t i, const int64_t j);
+
+  /**
+   * @brief Access an element of the matrix
+   *
+   * @param i
+   * Row index.
+   * @param j
+   * Column index.
+   * @return const T&
+   * Reference to the element at (\p i, \p j).
+   */
+  const T& operator()(const int64_t i, const int64_t j) const;
+
+  /**
+   * @brief Get a pointer to the first element
+   *
+   * @return T*
+   * Pointer to the first element, to be passed to BLAS and LAPACK.
+   */
+  T* operator&();
+
+  /**
+   * @brief Get a pointer to the first element
+   *
+   * @return const T*
+   * Pointer to the first element, to be passed to BLAS and LAPACK.
+   */
+  const T* operator&() const;
+};
+
+extern template class BasicDense<float>;
+extern template class BasicDense<std::complex<float>>;
+extern template class BasicDense<std::complex<double>>;
+
+/**
+ * @brief Single precision real dense matrix
+ */
+using SDense = BasicDense<float>;
+/**
+ * @brief Single precision complex dense matrix
+ */
+using CDense = BasicDense<std::complex<float>>;
+/**
+ * @brief Double precision complex dense matrix
+ */
+using ZDense = BasicDense<std::complex<double>>;
+
+} // namespace FRANK
+
+#endif // FRANK_classes_basic_dense_h
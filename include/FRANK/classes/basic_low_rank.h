@@ -0,0 +1,143 @@
+/**
+ * @file basic_low_rank.h
+ * @brief Include the `BasicLowRank` class template for non-`double` scalars.
+ *
+ * @copyright Copyright (c) 2020
+ */
+#ifndef FRANK_classes_basic_low_rank_h
+#define FRANK_classes_basic_low_rank_h
+
+#include "FRANK/classes/basic_dense.h"
+#include "FRANK/classes/matrix.h"
+
+#include <array>
+#include <complex>
+#include <cstdint>
+
+
+/**
+ * @brief General namespace of the FRANK library
+ */
+namespace FRANK
+{
+
+/**
+ * @brief Class template handling a low-rank matrix of scalar type \p T
+ *
+ * @tparam T
+ * Scalar type. The template is instantiated for `float`,
+ * `std::complex<float>` and `std::complex<double>`, like `BasicDense`.
+ * `double` matrices are handled by `LowRank`.
+ *
+ * The matrix is stored as <tt>U*S*V</tt>, where \p S is a diagonal
+ * `BasicDense` of size \p rank. Like `BasicDense`, each instantiation is
+ * registered with the open multi-methods, so that it can be a block of a
+ * `Hierarchical` matrix, for example one built from a complex kernel with
+ * Hierarchical(const ClusterTree&, const MatrixInitializerComplexKernel&, const bool).
+ * Such matrices can be multiplied with `BasicDense` matrices by gemm().
+ */
+template<typename T>
+class BasicLowRank : public Matrix {
+ public:
+  /**
+   * @brief Scalar type of the elements
+   */
+  using value_type = T;
+  /**
+   * @brief Dimension of the matrix {rows, columns}
+   */
+  std::array<int64_t, 2> dim = {0, 0};
+  /**
+   * @brief Rank of the approximation
+   */
+  int64_t rank = 0;
+  /**
+   * @brief Relative error threshold used for the compression, zero for fixed
+   * rank
+   */
+  double eps = 0;
+  /**
+   * @brief Left singular vectors, `dim[0]` by #rank
+   */
+  BasicDense<T> U;
+  /**
+   * @brief Diagonal matrix of singular values, #rank by #rank
+   */
+  BasicDense<T> S;
+  /**
+   * @brief Right singular vectors, #rank by `dim[1]`
+   */
+  BasicDense<T> V;
+
+  // Special member functions
+  BasicLowRank() = default;
+
+  virtual ~BasicLowRank() = default;
+
+  BasicLowRank(const BasicLowRank& A) = default;
+
+  BasicLowRank& operator=(const BasicLowRank& A) = default;
+
+  BasicLowRank(BasicLowRank&& A) = default;
+
+  BasicLowRank& operator=(BasicLowRank&& A) = default;
+
+  /**
+   * @brief Compress a `BasicDense` matrix to a fixed rank
+   *
+   * @param A
+   * Matrix to be compressed.
+   * @param rank
+   * Rank of the new approximation, limited by the dimensions of \p A.
+   *
+   * The approximation is the truncated singular value decomposition of \p A.
+   */
+  BasicLowRank(const BasicDense<T>& A, const int64_t rank);
+
+  /**
+   * @brief Compress a `BasicDense` matrix to a relative error threshold
+   *
+   * @param A
+   * Matrix to be compressed.
+   * @param eps
+   * Relative error threshold.
+   *
+   * The rank is the smallest one for which the truncated singular value
+   * decomposition approximates \p A with an error of at most \p eps times the
+   * norm of \p A, both in the Frobenius norm.
+   */
+  BasicLowRank(const BasicDense<T>& A, const double eps);
+
+  /**
+   * @brief Construct a new `BasicLowRank` from its factors
+   *
+   * @param U
+   * Left factor, moved into the new instance.
+   * @param S
+   * Square middle factor, moved into the new instance.
+   * @param V
+   * Right factor, moved into the new instance.
+   */
+  BasicLowRank(BasicDense<T>&& U, BasicDense<T>&& S, BasicDense<T>&& V);
+};
+
+extern template class BasicLowRank<float>;
+extern template class BasicLowRank<std::complex<float>>;
+extern template class BasicLowRank<std::complex<double>>;
+
+/**
+ * @brief Single precision real low-rank matrix
+ */
+using SLowRank = BasicLowRank<float>;
+/**
+ * @brief Single precision complex low-rank matrix
+ */
+using CLowRank = BasicLowRank<std::complex<float>>;
+/**
+ * @brief Double precision complex low-rank matrix
+ */
+using ZLowRank = BasicLowRank<std::complex<double>>;
+
+} // namespace FRANK
+
+#endif // FRANK_classes_basic_low_rank_h
@@ -14,6 +14,7 @@
 #include <array>
 #include <cstdint>
 #include <memory>
+#include <string>
 #include <vector>
 
 
@@ -24,6 +25,7 @@ namespace FRANK
 {
 
 class IndexRange;
+class MappedFile;
 class Task;
 
 /**
@@ -31,6 +33,13 @@ class Task;
  *
  * In FRANK, only the `Dense` class handles actual matrix elements. All other
  * classes are composites of `Dense` matrices.
+ *
+ * Elements are always stored in row-major order, there is no column-major
+ * layout. Since a row-major matrix is the column-major transpose of the same
+ * matrix, qr(), rq() and svd() call the transposed LAPACK routines in their
+ * native column-major layout and need no copies. getrf(), geqp3(), larfb()
+ * and tpmqrt() have no such dual and go through `LAPACK_ROW_MAJOR`, for which
+ * LAPACKE transposes the matrix into scratch memory and back.
  */
 class Dense : public Matrix {
   // TODO Find way to avoid using friend here! Best not to rely on it.
@@ -53,6 +62,9 @@ class Dense : public Matrix {
  private:
   // Handler of the representation in memory
   std::shared_ptr<std::vector<double>> data;
+  // Handler of a file backed representation. Exactly one of data and mapping
+  // is set.
+  std::shared_ptr<MappedFile> mapping;
   // Relative position inside a possible larger array in memory.
   std::array<int64_t, 2> rel_start = {0, 0};
   // Pointer used to speed up the indexing into submatrices. Will point to the
@@ -90,6 +102,9 @@ class Dense : public Matrix {
    * Reference to the modified `Dense` object.
    *
    * Make the left hand side of the operator a deep copy of the right hand side.
+   * If the left hand side already has the same dimensions and is the sole
+   * owner of a contiguous buffer, that buffer is reused instead of allocating a
+   * new one.
    */
   Dense& operator=(const Dense& A);
 
@@ -149,6 +164,46 @@ class Dense : public Matrix {
    */
   Dense(const int64_t n_rows, const int64_t n_cols=1);
 
+  /**
+   * @brief Construct a new `Dense` object stored in a memory-mapped file
+   *
+   * @param n_rows
+   * Number of rows of the new matrix.
+   * @param n_cols
+   * Number of columns of the new matrix.
+   * @param filename
+   * File backing the matrix. Existing files are truncated. If empty, an
+   * anonymous temporary file is used, which is removed with the last `Dense`
+   * instance sharing it.
+   * @param access
+   * Expected access pattern of the whole matrix, passed on to `madvise()`.
+   *
+   * All elements are initialized to 0. The file is created sparse and pages are
+   * only read into memory when touched, so the matrix can be larger than the
+   * available memory. `stride` is rounded up to a whole number of pages.
+   *
+   * The matrix works with all operations and can be split into views like any
+   * other `Dense` matrix. Copies and results of operations however are regular
+   * `Dense` matrices in memory. Assigning a `Dense` matrix of the same size to
+   * a memory-mapped matrix writes into the file.
+   */
+  Dense(
+    const int64_t n_rows, const int64_t n_cols, const std::string& filename,
+    const MemoryAccess access=MemoryAccess::Normal
+  );
+
+  /**
+   * @brief Construct a new `Dense` object on an existing mapping
+   *
+   * @param mapping
+   * Mapping holding the elements of the matrix, usually a window created by
+   * load().
+   *
+   * No elements are copied. The matrix shares the mapping and behaves like
+   * one constructed with a file name.
+   */
+  explicit Dense(const std::shared_ptr<MappedFile>& mapping);
+
   // TODO Add overload where vector doesn't need to be passed. That function
   // should forward to this one with a 0-sized vector. This is to make
   // initialization with functions like identity and random_uniform easier.
@@ -201,12 +256,13 @@ class Dense : public Matrix {
   );
 
   /**
-   * @brief Construct a new `Dense` object from a textfile
+   * @brief Construct a new `Dense` object from a text or binary matrix file
    *
    * @param filename
    * Path to file that contain the dense matrix
    * @param ordering
-   * Ordering of matrix elements within the text file
+   * Ordering of matrix elements within the text file. Ignored for binary
+   * matrix files.
    * @param n_rows
    * Number of rows of the new matrix.
    * @param n_cols
@@ -215,6 +271,8 @@ class Dense : public Matrix {
    * Row offset
    * @param col_start
    * Column offset
+   *
+   * See `MatrixInitializerFile` for the supported formats.
    */
   Dense(
     const std::string filename, const MatrixLayout ordering,
@@ -320,6 +378,22 @@ class Dense : public Matrix {
   const double* operator&() const;
 
   // Utility methods
+  /**
+   * @brief Truncate the matrix to its leading submatrix
+   *
+   * @param n_rows
+   * New row dimension less than or equal to the current row dimension.
+   * @param n_cols
+   * New column dimension less than or equal to the current column dimension.
+   *
+   * If this instance is the sole owner of a contiguous buffer, the leading
+   * submatrix is compacted to the front of that buffer without allocating.
+   * Otherwise, the leading submatrix is copied into a new buffer so that other
+   * instances sharing the old one are not affected. Memory-mapped matrices are
+   * always copied into regular memory.
+   */
+  void truncate(const int64_t n_rows, const int64_t n_cols);
+
   /**
    * @brief Create a shallow copy with a shared memory representation
    *
@@ -345,6 +419,32 @@ class Dense : public Matrix {
    */
   bool is_submatrix() const;
 
+  /**
+   * @brief Check if this `Dense` instance is stored in a memory-mapped file
+   *
+   * @return true if the elements are backed by a file
+   * @return false if the elements are stored in regular memory
+   */
+  bool is_mapped() const;
+
+  /**
+   * @brief Give the kernel a hint on how the elements will be accessed
+   *
+   * @param access
+   * Expected access pattern.
+   *
+   * The advice applies to all pages from the first to the last element of
+   * this matrix. For a view split along rows of a matrix whose rows are padded
+   * to whole pages these are exactly the pages of the view, so that it can
+   * for example be prefetched with `MemoryAccess::WillNeed` before it is
+   * factorized, and released with `MemoryAccess::DontNeed` afterwards. A view
+   * split along columns spans the other columns of its rows as well, and
+   * matrices with rows shorter than a page share pages with their neighbours,
+   * so the advice then also reaches elements outside of this matrix. Does
+   * nothing for matrices that are not memory-mapped.
+   */
+  void advise(const MemoryAccess access) const;
+
   // TODO Consider adding conversion operator to uint64_t. Risky though...
   /**
    * @brief Get the shared-unique id of this `Dense` instance
@@ -0,0 +1,77 @@
+/**
+ * @file diagonal.h
+ * @brief Include the `Diagonal` matrix class.
+ *
+ * @copyright Copyright (c) 2020
+ */
+#ifndef FRANK_classes_diagonal_h
+#define FRANK_classes_diagonal_h
+
+#include "FRANK/classes/dense.h"
+#include "FRANK/classes/matrix.h"
+
+#include <array>
+#include <cstdint>
+#include <utility>
+
+
+/**
+ * @brief General namespace of the FRANK library
+ */
+namespace FRANK
+{
+
+/**
+ * @brief Class representing a square diagonal matrix
+ *
+ * Only the diagonal elements are stored, as a `Dense` vector. Products
+ * with a `Diagonal` are specialized to row or column scalings.
+ */
+class Diagonal : public Matrix {
+ public:
+  /**
+   * @brief Dimension of the matrix {rows, columns}
+   */
+  std::array<int64_t, 2> dim = {0, 0};
+  /**
+   * @brief Diagonal elements stored as a `Dense` vector of length `dim[0]`
+   */
+  Dense diag;
+
+  // Special member functions
+  Diagonal() = default;
+
+  virtual ~Diagonal() = default;
+
+  Diagonal(const Diagonal& A) = default;
+
+  Diagonal& operator=(const Diagonal& A) = default;
+
+  Diagonal(Diagonal&& A) = default;
+
+  Diagonal& operator=(Diagonal&& A) = default;
+
+  /**
+   * @brief Construct a new `Diagonal` object of order \p n with zero diagonal
+   *
+   * @param n
+   * Number of rows and columns of the diagonal matrix.
+   */
+  explicit Diagonal(const int64_t n) : dim{n, n}, diag(n, 1) {}
+
+  /**
+   * @brief Construct a new `Diagonal` object from a vector of diagonal elements
+   *
+   * @param d
+   * Row or column vector containing the diagonal elements. It will be moved
+   * into #diag, which should then only be accessed through
+   * `Dense::operator[]`.
+   */
+  explicit Diagonal(Dense&& d)
+  : dim{d.dim[0] == 1 ? d.dim[1] : d.dim[0], d.dim[0] == 1 ? d.dim[1] : d.dim[0]},
+    diag(std::move(d)) {}
+};
+
+} // namespace FRANK
+
+#endif // FRANK_classes_diagonal_h
@@ -10,9 +10,12 @@
 #include "FRANK/definitions.h"
 #include "FRANK/classes/matrix.h"
 #include "FRANK/classes/matrix_proxy.h"
+#include "FRANK/classes/initialization_helpers/geometry.h"
 
 #include <array>
+#include <complex>
 #include <cstdint>
+#include <string>
 #include <tuple>
 #include <vector>
 
@@ -26,6 +29,7 @@ namespace FRANK
 class Dense;
 class ClusterTree;
 class MatrixInitializer;
+class MatrixInitializerComplexKernel;
 
 /**
  * @brief Flexible class handling any kind of block-structured matrix.
@@ -114,6 +118,54 @@ class Hierarchical : public Matrix {
     const bool fixed_rank=true
   );
 
+  /**
+   * @brief Construct a new `Hierarchical` matrix using a previously built
+   * matrix to speed up compression
+   *
+   * @param node
+   * `ClusterTree` describing the desired structure of the `Hierarchical`
+   * matrix.
+   * @param initializer
+   * Matrix element initializer. Several different initializers are available.
+   * @param previous
+   * Matrix built for a similar problem, for example with slightly different
+   * parameters or moved points, from the same \p node.
+   * @param fixed_rank
+   * Whether to use fixed rank for the compression (`true`) or use fixed accuracy/threshold (`false`).
+   *
+   * Intended for sequences of similar matrices. Admissible blocks for which
+   * \p previous holds a `LowRank` block of the same size are compressed
+   * starting from its basis, see MatrixInitializer::get_compressed_representation(const ClusterTree&, const bool, const LowRank&) const.
+   * All other blocks are built as by Hierarchical(const ClusterTree&, const MatrixInitializer&, const bool).
+   */
+  Hierarchical(
+    const ClusterTree& node,
+    const MatrixInitializer& initializer,
+    const Hierarchical& previous,
+    const bool fixed_rank=true
+  );
+
+  /**
+   * @brief Construct a new complex `Hierarchical` matrix
+   *
+   * @param node
+   * `ClusterTree` describing the desired structure of the `Hierarchical`
+   * matrix.
+   * @param initializer
+   * Initializer for a complex valued kernel.
+   * @param fixed_rank
+   * Whether to use fixed rank for the compression (`true`) or use fixed accuracy/threshold (`false`).
+   *
+   * Same recursion as Hierarchical(const ClusterTree&, const MatrixInitializer&, const bool),
+   * but admissible blocks become `ZLowRank` and inadmissible leaves `ZDense`.
+   * Such matrices can be multiplied with `ZDense` matrices by gemm().
+   */
+  Hierarchical(
+    const ClusterTree& node,
+    const MatrixInitializerComplexKernel& initializer,
+    const bool fixed_rank=true
+  );
+
   /**
    * @brief Construct a new `Hierarchical` matrix from a kernel and parameters
    * using a fixed rank for the `LowRank` block approximation.
@@ -121,7 +173,7 @@ class Hierarchical : public Matrix {
    * @param kernel
    * Kernel used to compute matrix entries from together with \p params.
    * @param params
-   * Vector with parameters used as input to the kernel.
+   * `Geometry` with parameters used as input to the kernel.
    * @param n_rows
    * Number of rows of the new matrix.
    * @param n_cols
@@ -171,7 +223,7 @@ class Hierarchical : public Matrix {
       const std::vector<std::vector<double>>& params,
       const int64_t row_start, const int64_t col_start
     ),
-    const std::vector<std::vector<double>> params,
+    const Geometry params,
     const int64_t n_rows, const int64_t n_cols,
     const int64_t rank,
     const int64_t nleaf,
@@ -188,7 +240,7 @@ class Hierarchical : public Matrix {
    * @param kernel
    * Kernel used to compute matrix entries from together with \p params.
    * @param params
-   * Vector with parameters used as input to the kernel.
+   * `Geometry` with parameters used as input to the kernel.
    * @param n_rows
    * Number of rows of the new matrix.
    * @param n_cols
@@ -238,7 +290,59 @@ class Hierarchical : public Matrix {
       const std::vector<std::vector<double>>& params,
       const int64_t row_start, const int64_t col_start
     ),
-    const std::vector<std::vector<double>> params,
+    const Geometry params,
+    const int64_t n_rows, const int64_t n_cols,
+    const int64_t nleaf,
+    const double eps,
+    const double admis=0,
+    const int64_t n_row_blocks=2, const int64_t n_col_blocks=2,
+    const AdmisType admis_type=AdmisType::PositionBased,
+    const int64_t row_start=0, const int64_t col_start=0
+  );
+
+  /**
+   * @brief Construct a new complex `Hierarchical` matrix from a complex valued
+   * kernel and parameters using a relative error threshold for the `ZLowRank`
+   * block approximation.
+   *
+   * @param kernel
+   * Complex valued kernel, for example helmholtznd_complex().
+   * @param params
+   * `Geometry` with parameters used as input to the kernel.
+   * @param n_rows
+   * Number of rows of the new matrix.
+   * @param n_cols
+   * Number of columns of the new matrix.
+   * @param nleaf
+   * Maximum size for leaf level submatrices.
+   * @param eps
+   * Fixed error threshold used for any `ZLowRank` approximations.
+   * @param admis
+   * Admissibility in terms of distance from the diagonal of the matrix on the
+   * current recursion level (for `AdmisType::PositionBased`) or admissibility constant
+   * (for `AdmisType::GeometryBased`)
+   * @param n_row_blocks
+   * Number of blocks rows of the new `Hierarchical` matrix.
+   * @param n_col_blocks
+   * Number of blocks columns of the new `Hierarchical` matrix.
+   * @param admis_type
+   * Either `AdmisType::PositionBased` or `AdmisType::GeometryBased`
+   * @param row_start
+   * Starting index into the vector \p params of the rows of the new matrix.
+   * @param col_start
+   * Starting index into the vector \p params of the columns of the new matrix.
+   *
+   * Complex counterpart of the kernel constructor with \p eps, building the
+   * blocks with a `MatrixInitializerComplexKernel`.
+   */
+  Hierarchical(
+    void (*kernel)(
+      std::complex<double>* A,
+      const uint64_t A_rows, const uint64_t A_cols, const uint64_t A_stride,
+      const std::vector<std::vector<double>>& params,
+      const int64_t row_start, const int64_t col_start
+    ),
+    const Geometry params,
     const int64_t n_rows, const int64_t n_cols,
     const int64_t nleaf,
     const double eps,
@@ -273,7 +377,7 @@ class Hierarchical : public Matrix {
    * @param col_start
    * Starting index into the columns of \p A.
    * @param params
-   * Vector containing the underlying geometry information of the input `Dense` matrix
+   * `Geometry` containing the underlying geometry information of the input `Dense` matrix
    * @param admis_type
    * Either `AdmisType::PositionBased` or `AdmisType::GeometryBased`
    *
@@ -297,7 +401,7 @@ class Hierarchical : public Matrix {
     const double admis=0,
     const int64_t n_row_blocks=2, const int64_t n_col_blocks=2,
     const int64_t row_start=0, const int64_t col_start=0,
-    const std::vector<std::vector<double>> params={},
+    const Geometry params={},
     const AdmisType admis_type=AdmisType::PositionBased
   );
 
@@ -326,7 +430,7 @@ class Hierarchical : public Matrix {
    * @param col_start
    * Starting index into the columns of \p A.
    * @param params
-   * Vector containing the underlying geometry information of the input `Dense` matrix
+   * `Geometry` containing the underlying geometry information of the input `Dense` matrix
    * @param admis_type
    * Either `AdmisType::PositionBased` or `AdmisType::GeometryBased`
    *
@@ -350,10 +454,138 @@ class Hierarchical : public Matrix {
     const double admis=0,
     const int64_t n_row_blocks=2, const int64_t n_col_blocks=2,
     const int64_t row_start=0, const int64_t col_start=0,
-    const std::vector<std::vector<double>> params={},
+    const Geometry params={},
+    const AdmisType admis_type=AdmisType::PositionBased
+  );
+
+  /**
+   * @brief Construct a new `Hierarchical` matrix from a matrix file
+   * using a fixed rank for the `LowRank` block approximation.
+   *
+   * @param filename
+   * Path to a text or binary matrix file.
+   * @param ordering
+   * Ordering of matrix elements within a text file. Ignored for binary files.
+   * @param n_rows
+   * Number of rows of the new matrix.
+   * @param n_cols
+   * Number of columns of the new matrix.
+   * @param rank
+   * Fixed rank used for any `LowRank` approximations.
+   * @param nleaf
+   * Maximum size for leaf level submatrices.
+   * @param admis
+   * Admissibility in terms of distance from the diagonal of the matrix on the
+   * current recursion level (for `AdmisType::PositionBased`) or admissibility constant
+   * (for `AdmisType::GeometryBased`)
+   * @param n_row_blocks
+   * Number of blocks rows of the new `Hierarchical` matrix.
+   * @param n_col_blocks
+   * Number of blocks columns of the new `Hierarchical` matrix.
+   * @param row_start
+   * Row offset into the matrix stored in the file.
+   * @param col_start
+   * Column offset into the matrix stored in the file.
+   * @param params
+   * `Geometry` containing the underlying geometry information of the matrix
+   * @param admis_type
+   * Either `AdmisType::PositionBased` or `AdmisType::GeometryBased`
+   *
+   * Each leaf block reads only its own elements from the file, so the matrix
+   * stored in the file is never held in memory as a whole. Binary matrix files
+   * (see `MatrixFileHeader`) are memory-mapped and should be preferred for
+   * large matrices, since text files are parsed again for every block.
+   */
+  Hierarchical(
+    const std::string filename, const MatrixLayout ordering,
+    const int64_t n_rows, const int64_t n_cols,
+    const int64_t rank,
+    const int64_t nleaf,
+    const double admis=0,
+    const int64_t n_row_blocks=2, const int64_t n_col_blocks=2,
+    const int64_t row_start=0, const int64_t col_start=0,
+    const Geometry params={},
+    const AdmisType admis_type=AdmisType::PositionBased
+  );
+
+  /**
+   * @brief Construct a new `Hierarchical` matrix from a matrix file
+   * using a relative error threshold for the `LowRank` block approximation.
+   *
+   * @param filename
+   * Path to a text or binary matrix file.
+   * @param ordering
+   * Ordering of matrix elements within a text file. Ignored for binary files.
+   * @param n_rows
+   * Number of rows of the new matrix.
+   * @param n_cols
+   * Number of columns of the new matrix.
+   * @param nleaf
+   * Maximum size for leaf level submatrices.
+   * @param eps
+   * Fixed error threshold used for any `LowRank` approximations.
+   * @param admis
+   * Admissibility in terms of distance from the diagonal of the matrix on the
+   * current recursion level (for `AdmisType::PositionBased`) or admissibility constant
+   * (for `AdmisType::GeometryBased`)
+   * @param n_row_blocks
+   * Number of blocks rows of the new `Hierarchical` matrix.
+   * @param n_col_blocks
+   * Number of blocks columns of the new `Hierarchical` matrix.
+   * @param row_start
+   * Row offset into the matrix stored in the file.
+   * @param col_start
+   * Column offset into the matrix stored in the file.
+   * @param params
+   * `Geometry` containing the underlying geometry information of the matrix
+   * @param admis_type
+   * Either `AdmisType::PositionBased` or `AdmisType::GeometryBased`
+   *
+   * Each leaf block reads only its own elements from the file, so the matrix
+   * stored in the file is never held in memory as a whole. Binary matrix files
+   * (see `MatrixFileHeader`) are memory-mapped and should be preferred for
+   * large matrices, since text files are parsed again for every block.
+   */
+  Hierarchical(
+    const std::string filename, const MatrixLayout ordering,
+    const int64_t n_rows, const int64_t n_cols,
+    const int64_t nleaf,
+    const double eps,
+    const double admis=0,
+    const int64_t n_row_blocks=2, const int64_t n_col_blocks=2,
+    const int64_t row_start=0, const int64_t col_start=0,
+    const Geometry params={},
     const AdmisType admis_type=AdmisType::PositionBased
   );
 
+  /**
+   * @brief Construct a new `Hierarchical` matrix with the block structure of
+   * another one and trivial content
+   *
+   * @param A
+   * `Hierarchical` matrix whose block structure is copied.
+   * @param fill
+   * Content of the new matrix, either `FillType::Zero` or
+   * `FillType::Identity`.
+   * @param rank
+   * Rank of the `LowRank` blocks of the new matrix.
+   *
+   * Every `Dense` block of \p A is replaced by a `Dense` block of the same size
+   * and every `LowRank` block by a `LowRank` block of the same size and
+   * relative error threshold, while `Hierarchical` blocks are recursed into.
+   * For `FillType::Identity`, ones are placed on the diagonal of the whole
+   * matrix. `LowRank` blocks hold zero content of rank \p rank, unless they
+   * intersect the diagonal, in which case they represent their part of the
+   * identity exactly.
+   *
+   * No kernel is evaluated and no compression is performed, which makes this
+   * constructor much cheaper than building a matrix of zeros or an identity
+   * matrix from a kernel when the block structure is already available.
+   */
+  Hierarchical(
+    const Hierarchical& A, const FillType fill, const int64_t rank=0
+  );
+
   /**
    * @brief Access elements of `Hierarchical` with a pair of indices
    *
@@ -452,6 +684,63 @@ class Hierarchical : public Matrix {
   MatrixProxy& operator()(const int64_t i, const int64_t j);
 };
 
+/**
+ * @brief Amount of work done by update_points()
+ */
+struct UpdateStatistics {
+  /**
+   * @brief Number of `Dense` blocks whose elements were assigned again
+   */
+  int64_t n_dense = 0;
+  /**
+   * @brief Number of `LowRank` blocks that were compressed again
+   */
+  int64_t n_low_rank = 0;
+  /**
+   * @brief Number of matrix elements in the rebuilt blocks
+   */
+  int64_t n_rebuilt_elements = 0;
+  /**
+   * @brief Number of matrix elements of the whole matrix
+   */
+  int64_t n_elements = 0;
+};
+
+/**
+ * @brief Rebuild the blocks of a `Hierarchical` matrix affected by a change of
+ * some of its points
+ *
+ * @param A
+ * Matrix built from \p node, for example with
+ * Hierarchical(const ClusterTree&, const MatrixInitializer&, const bool).
+ * Modified in place.
+ * @param node
+ * `ClusterTree` that \p A was built from.
+ * @param initializer
+ * Initializer for the updated points.
+ * @param changed
+ * Indices of the rows and columns whose points changed, in any order.
+ * @param fixed_rank
+ * Whether the `LowRank` blocks use fixed rank (`true`) or fixed accuracy
+ * (`false`), as when \p A was built.
+ * @return UpdateStatistics
+ * Number of blocks and elements that were rebuilt.
+ *
+ * Only the leaf blocks whose rows or columns contain a changed index are
+ * rebuilt: `Dense` blocks are assigned from \p initializer again and `LowRank`
+ * blocks are compressed again. All other blocks are kept. The block structure,
+ * and thus the admissibility of all blocks, stays the same as when \p A was
+ * built, so \p initializer is not asked for admissibility. This is suitable
+ * when points move by small distances, such as in a time step. When points move
+ * far enough to change which blocks should be admissible, \p A needs to be
+ * built again.
+ */
+UpdateStatistics update_points(
+  Hierarchical& A, const ClusterTree& node,
+  const MatrixInitializer& initializer,
+  std::vector<int64_t> changed, const bool fixed_rank=true
+);
+
 } // namespace FRANK
 
 #endif // FRANK_classes_hierarchical_h
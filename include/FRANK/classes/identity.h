@@ -0,0 +1,60 @@
+/**
+ * @file identity.h
+ * @brief Include the `Identity` matrix class.
+ *
+ * @copyright Copyright (c) 2020
+ */
+#ifndef FRANK_classes_identity_h
+#define FRANK_classes_identity_h
+
+#include "FRANK/classes/matrix.h"
+
+#include <array>
+#include <cstdint>
+
+
+/**
+ * @brief General namespace of the FRANK library
+ */
+namespace FRANK
+{
+
+/**
+ * @brief Class representing an implicit square identity matrix
+ *
+ * No elements are stored. Operations involving an `Identity` are specialized
+ * so that products and sums reduce to copies, scalings or updates of the
+ * diagonal, instead of materializing the identity as a `Dense` matrix.
+ */
+class Identity : public Matrix {
+ public:
+  /**
+   * @brief Dimension of the matrix {rows, columns}
+   */
+  std::array<int64_t, 2> dim = {0, 0};
+
+  // Special member functions
+  Identity() = default;
+
+  virtual ~Identity() = default;
+
+  Identity(const Identity& A) = default;
+
+  Identity& operator=(const Identity& A) = default;
+
+  Identity(Identity&& A) = default;
+
+  Identity& operator=(Identity&& A) = default;
+
+  /**
+   * @brief Construct a new `Identity` object of order \p n
+   *
+   * @param n
+   * Number of rows and columns of the identity matrix.
+   */
+  explicit Identity(const int64_t n) : dim{n, n} {}
+};
+
+} // namespace FRANK
+
+#endif // FRANK_classes_identity_h
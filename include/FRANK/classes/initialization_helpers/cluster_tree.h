@@ -8,6 +8,7 @@
 #define FRANK_classes_initialization_helpers_cluster_tree_h
 
 #include "FRANK/classes/initialization_helpers/index_range.h"
+#include "FRANK/classes/initialization_helpers/index_tree.h"
 
 #include <array>
 #include <cstdint>
@@ -128,6 +129,48 @@ class ClusterTree {
     ClusterTree* parent=nullptr
   );
 
+  /**
+   * @brief Construct a new `ClusterTree` object from the tensor product of two
+   * `IndexTree`s
+   *
+   * @param row_tree
+   * `IndexTree` used for the rows, for example from geometric_bisection().
+   * @param col_tree
+   * `IndexTree` used for the columns.
+   * @param level
+   * Level of the new `ClusterTree` node within the `ClusterTree`.
+   * @param i_rel
+   * Relative position along the row splits within the parent `ClusterTree`
+   * node.
+   * @param j_rel
+   * Relative position along the column splits within the parent `ClusterTree`
+   * node.
+   * @param i_abs
+   * Absolute position along the row splits of the new `ClusterTree` node on its
+   * level.
+   * @param j_abs
+   * Absolute position along the column splits of the new `ClusterTree` node on
+   * its level.
+   * @param parent
+   * Pointer to the parent node of this new `ClusterTree` node. `nullptr` if the
+   * it is to be the root.
+   *
+   * A node is split into the children of both index trees, or only into those
+   * of one of them if the other is a leaf. #nleaf is set to the largest leaf
+   * of either tree and, as for uniform splits, blocks whose rows and columns
+   * both fit into #nleaf become leaves. The index trees should thus have all
+   * their leaves on the same level, as those built by geometric_bisection().
+   * As the splits follow the geometry rather than the index, use
+   * `AdmisType::GeometryBased` admissibility for these trees.
+   */
+  ClusterTree(
+    const IndexTree& row_tree, const IndexTree& col_tree,
+    const int64_t level=0,
+    const int64_t i_rel=0, const int64_t j_rel=0,
+    const int64_t i_abs=0, const int64_t j_abs=0,
+    ClusterTree* parent=nullptr
+  );
+
   /**
    * @brief Return iterator to first child
    *
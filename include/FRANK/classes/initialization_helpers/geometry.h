@@ -0,0 +1,101 @@
+/**
+ * @file geometry.h
+ * @brief Include the `Geometry` class sharing point coordinates between
+ * initializers.
+ *
+ * @copyright Copyright (c) 2020
+ */
+#ifndef FRANK_classes_initialization_helpers_geometry_h
+#define FRANK_classes_initialization_helpers_geometry_h
+
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+
+/**
+ * @brief General namespace of the FRANK library
+ */
+namespace FRANK
+{
+
+/**
+ * @brief Immutable, shared handle to the coordinates of a set of points
+ *
+ * The coordinates are stored once, with one vector per axis as expected by the
+ * kernel functions:
+ * ```
+ * axis\point   p1  p2  p3 ... pn
+ *   x          x1  x2  x3 ... xn
+ *   y          y1  y2  y3 ... yn
+ *   z          z1  z2  z3 ... zn
+ * ...
+ * ```
+ * Copies of a `Geometry` share the same coordinates, so that it can be passed
+ * by value to `Hierarchical` constructors and initializers without copying the
+ * points. Since the class converts implicitly from and to
+ * `std::vector<std::vector<double>>`, existing code passing coordinates
+ * directly continues to work, at the cost of one copy into the shared storage.
+ * To avoid that copy as well, move the coordinates into a `Geometry` once and
+ * pass it instead.
+ */
+class Geometry {
+ private:
+  std::shared_ptr<const std::vector<std::vector<double>>> points;
+ public:
+  // Special member functions
+  Geometry();
+
+  ~Geometry() = default;
+
+  Geometry(const Geometry& A) = default;
+
+  Geometry& operator=(const Geometry& A) = default;
+
+  Geometry(Geometry&& A) = default;
+
+  Geometry& operator=(Geometry&& A) = default;
+
+  /**
+   * @brief Construct a new `Geometry` from coordinates
+   *
+   * @param coords
+   * Coordinates with one vector per axis. Pass an rvalue to move them into the
+   * shared storage without copying.
+   */
+  Geometry(std::vector<std::vector<double>> coords);
+
+  /**
+   * @brief Get the shared coordinates
+   *
+   * @return const std::vector<std::vector<double>>&
+   * Coordinates with one vector per axis, valid as long as any copy of this
+   * `Geometry` exists.
+   */
+  const std::vector<std::vector<double>>& coords() const;
+
+  /**
+   * @brief Access the coordinates where kernels expect them
+   */
+  operator const std::vector<std::vector<double>>&() const;
+
+  /**
+   * @brief Get the number of axes
+   *
+   * @return int64_t
+   * Dimension of the points, zero for an empty `Geometry`.
+   */
+  int64_t dim() const;
+
+  /**
+   * @brief Get the number of points
+   *
+   * @return int64_t
+   * Number of points, zero for an empty `Geometry`.
+   */
+  int64_t n_points() const;
+};
+
+} // namespace FRANK
+
+#endif // FRANK_classes_initialization_helpers_geometry_h
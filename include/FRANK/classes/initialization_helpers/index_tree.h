@@ -0,0 +1,155 @@
+/**
+ * @file index_tree.h
+ * @brief Include the `IndexTree` class and the geometric bisection that builds
+ * it from a point cloud.
+ *
+ * @copyright Copyright (c) 2020
+ */
+#ifndef FRANK_classes_initialization_helpers_index_tree_h
+#define FRANK_classes_initialization_helpers_index_tree_h
+
+#include "FRANK/classes/initialization_helpers/index_range.h"
+
+#include <cstdint>
+#include <vector>
+
+
+/**
+ * @brief General namespace of the FRANK library
+ */
+namespace FRANK
+{
+
+/**
+ * @brief Direction along which geometric_bisection() splits a cluster
+ */
+enum class BisectionType {
+  /**
+   * @brief Split along the longest edge of the bounding box (k-d tree).
+   */
+  LongestAxis,
+  /**
+   * @brief Split along the principal axis of the points (PCA tree).
+   */
+  PrincipalAxis
+};
+
+/**
+ * @brief Hierarchical split of an `IndexRange`
+ *
+ * Every node covers a contiguous range of indices and its children split that
+ * range into consecutive parts. Unlike the splits made by `ClusterTree` itself,
+ * the parts can have different sizes and the leaves different depths.
+ */
+class IndexTree {
+ public:
+  /**
+   * @brief `IndexRange` covered by this node.
+   */
+  IndexRange range;
+  /**
+   * @brief Consecutive parts of #range, empty for leaves.
+   */
+  std::vector<IndexTree> children;
+
+  // Special member functions
+  IndexTree() = default;
+
+  ~IndexTree() = default;
+
+  IndexTree(const IndexTree& A) = default;
+
+  IndexTree& operator=(const IndexTree& A) = default;
+
+  IndexTree(IndexTree&& A) = default;
+
+  IndexTree& operator=(IndexTree&& A) = default;
+
+  /**
+   * @brief Construct a new leaf `IndexTree` node
+   *
+   * @param range
+   * `IndexRange` covered by the node.
+   */
+  IndexTree(const IndexRange range);
+
+  /**
+   * @brief Check if the node is a leaf
+   *
+   * @return true
+   * If the node has no children.
+   * @return false
+   * If the node has children.
+   */
+  bool is_leaf() const;
+
+  /**
+   * @brief Get the number of levels below this node
+   *
+   * @return int64_t
+   * Zero for a leaf, otherwise one more than the deepest child.
+   */
+  int64_t depth() const;
+
+  /**
+   * @brief Get the size of the largest leaf below this node
+   *
+   * @return int64_t
+   * Largest length of the `IndexRange` of any leaf.
+   */
+  int64_t max_leaf_size() const;
+};
+
+/**
+ * @brief Cluster points by recursive geometric bisection
+ *
+ * @param x
+ * Points to be clustered, stored as for sortByMortonIndex() with one vector of
+ * coordinates per axis. Reordered so that the points of every cluster are
+ * contiguous.
+ * @param perm
+ * Resized to the number of points. After the call, `perm[i]` is the original
+ * index of the point now at position `i`, as for sortByMortonIndex().
+ * @param nleaf
+ * Maximum number of points in a leaf cluster.
+ * @param type
+ * Direction along which clusters are split.
+ * @return IndexTree
+ * Binary tree of the clusters. All leaves are on the first level on which no
+ * cluster has more than \p nleaf points.
+ *
+ * Every cluster is split at the median along the split direction, so that both
+ * halves contain the same number of points (up to one). The first half gets
+ * the extra point, as in IndexRange::split(), so that the blocks of the
+ * resulting matrices have the same sizes as with uniform splits and can be
+ * combined with `Dense` matrices split uniformly. Only the order of the points
+ * is adapted to the geometry.
+ *
+ * For non-uniform point clouds, the clusters have smaller bounding boxes than
+ * those obtained by splitting a sorted index range uniformly, so that more
+ * blocks are admissible and the ranks of the admissible blocks are lower. The
+ * result can be used on both sides of the `ClusterTree` constructor taking
+ * `IndexTree`s together with an initializer for the reordered points and
+ * `AdmisType::GeometryBased` admissibility:
+ * ```
+ * std::vector<int64_t> perm;
+ * const IndexTree tree = geometric_bisection(x, perm, nleaf);
+ * const ClusterTree cluster_tree(tree, tree);
+ * MatrixInitializerKernel initializer(
+ *   laplacend, x, admis, eps, 0, AdmisType::GeometryBased
+ * );
+ * initializer.find_admissible_blocks(cluster_tree);
+ * const Hierarchical A(cluster_tree, initializer, false);
+ * ```
+ * Row and column `i` of `A` then correspond to point `perm[i]` of the
+ * original ordering.
+ */
+IndexTree geometric_bisection(
+  std::vector<std::vector<double>>& x, std::vector<int64_t>& perm,
+  const int64_t nleaf,
+  const BisectionType type=BisectionType::PrincipalAxis
+);
+
+} // namespace FRANK
+
+#endif // FRANK_classes_initialization_helpers_index_tree_h
@@ -14,9 +14,12 @@
 #include "FRANK/definitions.h"
 #include "FRANK/classes/dense.h"
 #include "FRANK/classes/low_rank.h"
+#include "FRANK/classes/initialization_helpers/geometry.h"
 #include "FRANK/classes/initialization_helpers/index_range.h"
 
+#include <array>
 #include <cstdint>
+#include <map>
 #include <tuple>
 #include <vector>
 
@@ -50,10 +53,35 @@ class MatrixInitializer {
   const double admis;
   const double eps;
   const int64_t rank;
-  const std::vector<std::vector<double>> params;
+  const Geometry params;
   const AdmisType admis_type;
 
-  void find_admissible_blocks(const ClusterTree& node);
+  /**
+   * @brief Axis-aligned bounding box of the points of a cluster
+   */
+  struct BoundingBox {
+    std::vector<double> min;
+    std::vector<double> max;
+  };
+  /**
+   * @brief Bounding boxes of the clusters, keyed by {start, n}
+   */
+  std::map<std::array<int64_t, 2>, BoundingBox> bounding_boxes;
+  /**
+   * @brief Geometry-based admissibility of the blocks, keyed by
+   * {row start, number of rows, column start, number of columns}
+   */
+  std::map<std::array<int64_t, 4>, bool> admissibility;
+  /**
+   * @brief Number of blocks compressed starting from a previous basis
+   */
+  mutable int64_t n_warm_starts = 0;
+
+  BoundingBox get_bounding_box(const IndexRange& range) const;
+
+  void compute_bounding_boxes(const ClusterTree& node);
+
+  bool is_admissible(const BoundingBox& row_box, const BoundingBox& col_box) const;
 
  public:
   // Special member functions
@@ -79,14 +107,14 @@ class MatrixInitializer {
    * @param rank
    * Fixed rank to be used for approximating admissible submatrices. Ignored if eps &ne; 0
    * @param params
-   * Vector containing parameters used as input to the kernel
-   * and as coordinate of particles
+   * `Geometry` containing parameters used as input to the kernel
+   * and as coordinate of particles. Shared with the caller, not copied.
    * @param admis_type
    * Either AdmisType::PositionBased (Default) or AdmisType::GeometryBased
    */
   MatrixInitializer(
     const double admis, const double eps, const int64_t rank,
-    const std::vector<std::vector<double>> params={},
+    const Geometry params={},
     const AdmisType admis_type=AdmisType::PositionBased
   );
 
@@ -137,6 +165,36 @@ class MatrixInitializer {
    */
   LowRank get_compressed_representation(const ClusterTree& node, const bool fixed_rank) const;
 
+  /**
+   * @brief Get a compressed representation of an admissible `ClusterTree`
+   * node, starting from the basis of a previous approximation
+   *
+   * @param node
+   * `ClusterTree` node to be represented by a `LowRank` approximation.
+   * @param fixed_rank
+   * Whether to use fixed rank for the compression (`true`) or use fixed accuracy/threshold (`false`).
+   * @param previous
+   * Approximation of the same block of a similar matrix, for example one
+   * built from slightly different parameters.
+   * @return LowRank
+   * `LowRank` approximation representing \p node.
+   *
+   * For fixed accuracy, the column basis of \p previous is used as it is if
+   * it approximates the new block within the same error threshold as
+   * truncated_geqp3(): no column of the error may be larger than `eps` times
+   * the norm of the block. Otherwise a single step of subspace iteration
+   * started from it is tried. An accepted basis is then truncated as far as
+   * the same threshold allows. For fixed rank, the subspace iteration step is
+   * always taken. If neither basis is accurate enough, or if \p previous has a
+   * lower rank than needed, the block is compressed from scratch as by
+   * get_compressed_representation(const ClusterTree&, const bool) const.
+   * Accepting a basis only requires a few products with the block, which is
+   * much cheaper than a pivoted QR decomposition.
+   */
+  LowRank get_compressed_representation(
+    const ClusterTree& node, const bool fixed_rank, const LowRank& previous
+  ) const;
+
   /**
    * @brief Check if a `ClusterTree` node is admissible
    *
@@ -149,7 +207,44 @@ class MatrixInitializer {
    */
   bool is_admissible(const ClusterTree& node) const;
 
-  virtual std::vector<std::vector<double>> get_coords_range(const IndexRange& range) const;
+  /**
+   * @brief Precompute the admissibility of all nodes of a `ClusterTree`
+   *
+   * @param root
+   * Root of the `ClusterTree` that will be used for construction.
+   *
+   * Only has an effect for `AdmisType::GeometryBased`. The bounding boxes of
+   * all row and column clusters are computed once, bottom-up from the leaves,
+   * and the admissibility of all blocks is then evaluated in parallel and
+   * cached, so that is_admissible() only needs to look it up. Without this,
+   * is_admissible() computes the bounding boxes of both clusters from all of
+   * their points for every block it is called for. The `Hierarchical`
+   * constructors creating their own `ClusterTree` call this method; call it
+   * before passing a `ClusterTree` to the `Hierarchical` constructor directly.
+   * Each call discards the results cached for the previous tree, so that only
+   * \p root is looked up afterwards; other trees fall back to computing the
+   * admissibility from the points.
+   */
+  void find_admissible_blocks(const ClusterTree& root);
+
+  /**
+   * @brief Get the points used by the initializer
+   *
+   * @return const Geometry&
+   * Coordinates shared with the `Geometry` passed to the constructor. Index
+   * them with the start of an `IndexRange` to get the points of a cluster.
+   */
+  const Geometry& get_geometry() const;
+
+  /**
+   * @brief Get the number of blocks compressed starting from a previous basis
+   *
+   * @return int64_t
+   * Number of calls of get_compressed_representation(const ClusterTree&,
+   * const bool, const LowRank&) const that used the basis of the previous
+   * approximation instead of compressing the block from scratch.
+   */
+  int64_t get_n_warm_starts() const;
 
 };
 
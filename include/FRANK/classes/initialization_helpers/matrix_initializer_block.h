@@ -58,13 +58,13 @@ class MatrixInitializerBlock : public MatrixInitializer {
    * @param rank
    * Fixed rank to be used for approximating admissible submatrices. Ignored if eps &ne; 0
    * @param params
-   * Vector containing the underlying geometry information of the input `Dense` matrix
+   * `Geometry` containing the underlying geometry information of the input `Dense` matrix
    * @param admis_type
    * Either `AdmisType::PositionBased` or `AdmisType::GeometryBased`
    */
   MatrixInitializerBlock(
     Dense&& A, const double admis, const double eps, const int64_t rank,
-    const std::vector<std::vector<double>> params, const AdmisType admis_type
+    const Geometry params, const AdmisType admis_type
   );
 
   /**
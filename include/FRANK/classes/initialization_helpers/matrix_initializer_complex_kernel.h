@@ -0,0 +1,157 @@
+/**
+ * @file matrix_initializer_complex_kernel.h
+ * @brief Include the `MatrixInitializerComplexKernel` class
+ *
+ * @copyright Copyright (c) 2020
+ */
+#ifndef FRANK_classes_initialization_helpers_matrix_initializer_complex_kernel_h
+#define FRANK_classes_initialization_helpers_matrix_initializer_complex_kernel_h
+
+#include "FRANK/definitions.h"
+#include "FRANK/classes/basic_dense.h"
+#include "FRANK/classes/basic_low_rank.h"
+#include "FRANK/classes/dense.h"
+#include "FRANK/classes/initialization_helpers/matrix_initializer.h"
+
+#include <complex>
+#include <cstdint>
+#include <vector>
+
+
+/**
+ * @brief General namespace of the FRANK library
+ */
+namespace FRANK
+{
+
+class ClusterTree;
+class IndexRange;
+
+/**
+ * @brief `MatrixInitializer` specialization that initializes matrix elements from a
+ * complex valued kernel and parameters
+ *
+ * Admissibility is decided from the parameters exactly as for
+ * `MatrixInitializerKernel`. Blocks are built as `ZDense` and `ZLowRank` by
+ * get_complex_dense_representation() and
+ * get_complex_compressed_representation(), which is what
+ * Hierarchical(const ClusterTree&, const MatrixInitializerComplexKernel&, const bool)
+ * uses.
+ */
+class MatrixInitializerComplexKernel : public MatrixInitializer {
+ private:
+  void (*kernel)(
+    std::complex<double>* A,
+    const uint64_t A_rows, const uint64_t A_cols, const uint64_t A_stride,
+    const std::vector<std::vector<double>>& params,
+    const int64_t row_start, const int64_t col_start
+  ) = nullptr;
+ public:
+
+  // Special member functions
+  MatrixInitializerComplexKernel() = delete;
+
+  ~MatrixInitializerComplexKernel() = default;
+
+  MatrixInitializerComplexKernel(const MatrixInitializerComplexKernel& A) = delete;
+
+  MatrixInitializerComplexKernel& operator=(
+    const MatrixInitializerComplexKernel& A
+  ) = delete;
+
+  MatrixInitializerComplexKernel(MatrixInitializerComplexKernel&& A) = delete;
+
+  MatrixInitializerComplexKernel& operator=(
+    MatrixInitializerComplexKernel&& A
+  ) = delete;
+
+  /**
+   * @brief Construct a new `MatrixInitializerComplexKernel` object
+   *
+   * @param kernel
+   * Complex valued kernel to be used to assign matrix elements.
+   * @param params
+   * `Geometry` with parameters used as input to the kernel.
+   * @param admis
+   * Distance-to-diagonal or standard admissibility condition constant.
+   * @param eps
+   * Fixed error threshold used for approximating admissible submatrices.
+   * @param rank
+   * Fixed rank to be used for approximating admissible submatrices. Ignored if eps &ne; 0
+   * @param admis_type
+   * Either AdmisType::PositionBased or AdmisType::GeometryBased
+   */
+  MatrixInitializerComplexKernel(
+    void (*kernel)(
+      std::complex<double>* A, uint64_t A_rows, uint64_t A_cols, uint64_t A_stride,
+      const std::vector<std::vector<double>>& params,
+      int64_t row_start, int64_t col_start
+    ),
+    const Geometry params,
+    const double admis, const double eps, const int64_t rank, const AdmisType admis_type
+  );
+
+  /**
+   * @brief Specialization for assigning matrix elements
+   *
+   * @param A
+   * Matrix whose elements are to be assigned.
+   * @param row_range
+   * Row range of \p A. The start of the `IndexRange` within the root
+   * level `Hierarchical` matrix.
+   * @param col_range
+   * Column range of \p A. The start of the `IndexRange` within the root
+   * level `Hierarchical` matrix.
+   *
+   * Only succeeds where the kernel is real valued. A kernel value with a
+   * nonzero imaginary part cannot be stored in a `Dense` matrix and aborts the
+   * program; use fill_complex_representation() instead.
+   */
+  void fill_dense_representation(
+    Dense& A, const IndexRange& row_range, const IndexRange& col_range
+  ) const override;
+
+  /**
+   * @brief Assign complex matrix elements
+   *
+   * @param A
+   * Matrix whose elements are to be assigned.
+   * @param row_range
+   * Row range of \p A within the root level `Hierarchical` matrix.
+   * @param col_range
+   * Column range of \p A within the root level `Hierarchical` matrix.
+   */
+  void fill_complex_representation(
+    ZDense& A, const IndexRange& row_range, const IndexRange& col_range
+  ) const;
+
+  /**
+   * @brief Get a complex dense representation of a block
+   *
+   * @param node
+   * `ClusterTree` node of the block.
+   * @return ZDense
+   * Block with the complex kernel values.
+   */
+  ZDense get_complex_dense_representation(const ClusterTree& node) const;
+
+  /**
+   * @brief Get a complex low-rank representation of an admissible block
+   *
+   * @param node
+   * `ClusterTree` node of the block.
+   * @param fixed_rank
+   * If true, the rank passed to the constructor is used, otherwise the error
+   * threshold.
+   * @return ZLowRank
+   * Truncated singular value decomposition of the block.
+   */
+  ZLowRank get_complex_compressed_representation(
+    const ClusterTree& node, const bool fixed_rank
+  ) const;
+};
+
+} // namespace FRANK
+
+
+#endif // FRANK_classes_initialization_helpers_matrix_initializer_complex_kernel_h
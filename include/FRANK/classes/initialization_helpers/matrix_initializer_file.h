@@ -5,8 +5,11 @@
 #include "FRANK/classes/dense.h"
 #include "FRANK/classes/initialization_helpers/matrix_initializer.h"
 
+#include <array>
 #include <cstdint>
+#include <memory>
 #include <string>
+#include <vector>
 
 /**
  * @brief General namespace of the FRANK library
@@ -19,12 +22,25 @@ class IndexRange;
 
 /**
  * @brief `MatrixInitializer` specialization that initializes matrix elements from a
- * dense matrix written in a text file
+ * dense matrix written in a text file or a binary matrix file
+ *
+ * Binary matrix files (see `MatrixFileHeader`) are memory-mapped once on
+ * construction and each block is copied directly from the mapping. Text files
+ * are parsed from the start for every block, which is only suitable for small
+ * matrices. convert_matrix_file() converts text files to binary files.
  */
 class MatrixInitializerFile : public MatrixInitializer {
  private:
-  const std::string filename;
-  const MatrixLayout ordering;
+  std::string filename;
+  MatrixLayout ordering;
+  std::array<int64_t, 2> file_dim = {0, 0};
+  // Read-only mapping of a binary matrix file, null for text files
+  std::shared_ptr<char> mapping;
+  const double* values = nullptr;
+
+  void fill_from_text(
+    Dense& A, const IndexRange& row_range, const IndexRange& col_range
+  ) const;
  public:
   // Special member functions
   MatrixInitializerFile() = delete;
@@ -45,9 +61,37 @@ class MatrixInitializerFile : public MatrixInitializer {
    * @param filename
    * Path to file that contain the `Dense` matrix
    * @param ordering
-   * Ordering of matrix elements within the text file
+   * Ordering of matrix elements within the text file. Ignored for binary
+   * files, which store their ordering in the header.
+   * @param admis
+   * Admissibility in terms of distance from the diagonal of the matrix on the
+   * current recursion level (for `AdmisType::PositionBased`) or admissibility constant
+   * (for `AdmisType::GeometryBased`)
+   * @param eps
+   * Fixed error threshold used for approximating admissible submatrices.
+   * @param rank
+   * Fixed rank to be used for approximating admissible submatrices. Ignored if eps &ne; 0
+   * @param params
+   * `Geometry` containing the underlying geometry information of the matrix
+   * @param admis_type
+   * Either `AdmisType::PositionBased` or `AdmisType::GeometryBased`
+   *
+   * The format of the file is detected from its first bytes.
+   */
+  MatrixInitializerFile(
+    const std::string filename, const MatrixLayout ordering,
+    const double admis=0, const double eps=0, const int64_t rank=0,
+    const Geometry params={},
+    const AdmisType admis_type=AdmisType::PositionBased
+  );
+
+  /**
+   * @brief Check whether the file is a memory-mapped binary matrix file
+   *
+   * @return bool
+   * False for text files.
    */
-  MatrixInitializerFile(const std::string filename, const MatrixLayout ordering);
+  bool is_binary() const;
 
   /**
    * @brief Specialization for assigning matrix elements
@@ -59,8 +103,9 @@ class MatrixInitializerFile : public MatrixInitializer {
    * @param col_range
    * Column range of \p A. The start of the `IndexRange` within the dense matrix file
    *
-   * Traverse the text file and read elements of the corresponding \p row_range and \p col_range.
-   * This method can fetch a specific submatrix from a textfile by skipping certain elements when needed.
+   * For binary files, the rows (or columns) of the submatrix are copied from
+   * the mapping. For text files, traverse the file and read elements of the
+   * corresponding \p row_range and \p col_range, skipping elements when needed.
    */
   void fill_dense_representation(
     Dense& A, const IndexRange& row_range, const IndexRange& col_range
@@ -57,7 +57,7 @@ class MatrixInitializerKernel : public MatrixInitializer {
    * @param kernel
    * Kernel to be used to assign matrix elements.
    * @param params
-   * Vector with parameters used as input to the kernel.
+   * `Geometry` with parameters used as input to the kernel.
    * @param admis
    * Distance-to-diagonal or standard admissibility condition constant.
    * @param eps
@@ -73,7 +73,7 @@ class MatrixInitializerKernel : public MatrixInitializer {
       const std::vector<std::vector<double>>& params,
       int64_t row_start, int64_t col_start
     ),
-    const std::vector<std::vector<double>> params,
+    const Geometry params,
     const double admis, const double eps, const int64_t rank, const AdmisType admis_type
   );
 
@@ -0,0 +1,127 @@
+/**
+ * @file matrix_product.h
+ * @brief Include the `MatrixProduct` class.
+ *
+ * @copyright Copyright (c) 2020
+ */
+#ifndef FRANK_classes_matrix_product_h
+#define FRANK_classes_matrix_product_h
+
+#include <cstdint>
+#include <vector>
+
+
+/**
+ * @brief General namespace of the FRANK library
+ */
+namespace FRANK
+{
+
+class Dense;
+
+/**
+ * @brief Lazy product of a chain of `Dense` matrices
+ *
+ * A `MatrixProduct` only records its factors and whether each of them is
+ * transposed. Nothing is computed until the product is evaluated into a
+ * destination, either through evaluate() or by converting it to a `Dense`
+ * matrix. At that point, the order of the multiplications is chosen by
+ * solving the matrix chain ordering problem for the dimensions of the factors,
+ * so that chains such as `U*S*V` with very different ranks and sizes are
+ * computed with the fewest floating point operations.
+ *
+ * The factors are referenced, not copied. They must thus outlive the
+ * `MatrixProduct` and must not alias the destination of evaluate().
+ */
+class MatrixProduct {
+ private:
+  std::vector<const Dense*> factors;
+  std::vector<bool> trans;
+ public:
+  // Special member functions
+  MatrixProduct() = delete;
+
+  ~MatrixProduct() = default;
+
+  MatrixProduct(const MatrixProduct& A) = default;
+
+  MatrixProduct& operator=(const MatrixProduct& A) = default;
+
+  MatrixProduct(MatrixProduct&& A) = default;
+
+  MatrixProduct& operator=(MatrixProduct&& A) = default;
+
+  /**
+   * @brief Start a product chain with a single factor
+   *
+   * @param A
+   * First factor of the chain.
+   * @param TransA
+   * \p true if <tt>transpose(A)</tt> is to be used.
+   */
+  explicit MatrixProduct(const Dense& A, const bool TransA=false);
+
+  /**
+   * @brief Append a factor to the right end of the chain
+   *
+   * @param B
+   * Factor to be appended.
+   * @param TransB
+   * \p true if <tt>transpose(B)</tt> is to be used.
+   * @return MatrixProduct&
+   * Reference to the extended chain.
+   */
+  MatrixProduct& times(const Dense& B, const bool TransB=false);
+
+  /**
+   * @brief Get the number of rows of the product
+   *
+   * @return int64_t
+   * Number of rows of the product.
+   */
+  int64_t n_rows() const;
+
+  /**
+   * @brief Get the number of columns of the product
+   *
+   * @return int64_t
+   * Number of columns of the product.
+   */
+  int64_t n_cols() const;
+
+  /**
+   * @brief Get the number of multiply-add operations of the chosen order
+   *
+   * @return int64_t
+   * Sum of <tt>m*k*n</tt> over all multiplications done by evaluate().
+   */
+  int64_t cost() const;
+
+  /**
+   * @brief Evaluate the product into a destination
+   *
+   * @param C
+   * `Dense` matrix of size n_rows() x n_cols().
+   * @param alpha
+   * Scalar factor of the product.
+   * @param beta
+   * Scalar factor of the previous content of \p C.
+   *
+   * Computes <tt>C = alpha*op(A_1)*...*op(A_n) + beta*C</tt>. The last
+   * multiplication writes directly into \p C, only the intermediate products
+   * of the chosen order are allocated.
+   */
+  void evaluate(Dense& C, const double alpha=1, const double beta=0) const;
+
+  /**
+   * @brief Evaluate the product into a new `Dense` matrix
+   *
+   * @return Dense
+   * Result of the product.
+   */
+  operator Dense() const;
+};
+
+} // namespace FRANK
+
+#endif // FRANK_classes_matrix_product_h
@@ -0,0 +1,229 @@
+/**
+ * @file mixed_precision_low_rank.h
+ * @brief Include the `MixedPrecisionLowRank` matrix class.
+ *
+ * @copyright Copyright (c) 2020
+ */
+#ifndef FRANK_classes_mixed_precision_low_rank_h
+#define FRANK_classes_mixed_precision_low_rank_h
+
+#include "FRANK/classes/matrix.h"
+
+#include <array>
+#include <cstdint>
+#include <vector>
+
+
+/**
+ * @brief General namespace of the FRANK library
+ */
+namespace FRANK
+{
+
+class Dense;
+class IndexRange;
+class LowRank;
+
+/**
+ * @brief Class handling a low-rank matrix stored with a precision per singular triplet
+ *
+ * The matrix is stored as a sum of singular triplets
+ * <tt>s_i * u_i * v_i</tt>. The singular values are kept in double precision,
+ * while each pair of singular vectors is stored in the lowest of double,
+ * single or bfloat16 (a `float` with its mantissa truncated to 7 bits)
+ * precision that keeps the rounding error of the triplet within a given
+ * tolerance. Triplets with small singular values thus need less memory and
+ * bandwidth.
+ *
+ * gemm() multiplies the matrix directly from the stored singular vectors,
+ * widening those of one precision at a time to double precision, see
+ * multiply_right() and multiply_left(). The matrix can be split into blocks of
+ * the same type, but operations that write into it are not supported.
+ */
+class MixedPrecisionLowRank : public Matrix {
+ public:
+  /**
+   * @brief Dimension of the matrix {rows, columns}
+   */
+  std::array<int64_t, 2> dim = {0, 0};
+  /**
+   * @brief Number of singular triplets stored in {double, single, bfloat16}
+   * precision
+   *
+   * Triplets are ordered by decreasing precision, so the first `rank[0]`
+   * triplets are those stored in double precision.
+   */
+  std::array<int64_t, 3> rank = {0, 0, 0};
+ private:
+  std::vector<double> S;
+  // Singular vectors of each precision, one contiguous vector after another
+  std::vector<double> U_double, V_double;
+  std::vector<float> U_single, V_single;
+  std::vector<uint16_t> U_bfloat16, V_bfloat16;
+
+  // Row-major rank[g] x n panel of the singular vectors u_i (left) or v_i of
+  // precision g. Vectors not in double precision are widened into buffer.
+  const double* get_panel(
+    const bool left, const int64_t g, std::vector<double>& buffer
+  ) const;
+
+  // All singular vectors u_i (left) or v_i widened to a rank x n Dense matrix
+  Dense get_vectors(const bool left) const;
+ public:
+  // Special member functions
+  MixedPrecisionLowRank() = default;
+
+  virtual ~MixedPrecisionLowRank() = default;
+
+  MixedPrecisionLowRank(const MixedPrecisionLowRank& A) = default;
+
+  MixedPrecisionLowRank& operator=(const MixedPrecisionLowRank& A) = default;
+
+  MixedPrecisionLowRank(MixedPrecisionLowRank&& A) = default;
+
+  MixedPrecisionLowRank& operator=(MixedPrecisionLowRank&& A) = default;
+
+  /**
+   * @brief Construct a new `MixedPrecisionLowRank` from a `LowRank` matrix
+   *
+   * @param A
+   * `LowRank` matrix to be stored.
+   * @param tol
+   * Absolute tolerance for the error introduced by the reduced precision, in
+   * the Frobenius norm.
+   *
+   * The middle factor of \p A is diagonalized with an SVD first, so that \p A
+   * need not come from an SVD. The tolerance is then split evenly between the
+   * singular triplets.
+   */
+  MixedPrecisionLowRank(const LowRank& A, const double tol);
+
+  /**
+   * @brief Get the total rank of the matrix
+   *
+   * @return int64_t
+   * Number of singular triplets over all precisions.
+   */
+  int64_t total_rank() const;
+
+  /**
+   * @brief Convert the matrix back to a `LowRank` in double precision
+   *
+   * @return LowRank
+   * `LowRank` matrix with a diagonal middle factor.
+   */
+  LowRank decompress() const;
+
+  /**
+   * @brief Multiply the matrix from the right by a `Dense` matrix
+   *
+   * @param B
+   * Second factor of the product.
+   * @param C
+   * Matrix the product is added to.
+   * @param alpha
+   * Scalar to multiply the product with.
+   * @param beta
+   * Scalar to multiply \p C with before the product is added.
+   * @param TransA
+   * \p true if the transpose of this matrix will be used, \p false otherwise.
+   * @param TransB
+   * \p true if \p transpose(B) will be used, \p false otherwise.
+   *
+   * Computes <tt>C = alpha*op(A)*op(B) + beta*C</tt> for this matrix `A`. The
+   * singular vectors are used in their stored precision, one precision at a
+   * time, so that no `LowRank` copy of the matrix is formed.
+   */
+  void multiply_right(
+    const Dense& B, Dense& C,
+    const double alpha, const double beta,
+    const bool TransA, const bool TransB
+  ) const;
+
+  /**
+   * @brief Multiply the matrix from the left by a `Dense` matrix
+   *
+   * @param A
+   * First factor of the product.
+   * @param C
+   * Matrix the product is added to.
+   * @param alpha
+   * Scalar to multiply the product with.
+   * @param beta
+   * Scalar to multiply \p C with before the product is added.
+   * @param TransA
+   * \p true if \p transpose(A) will be used, \p false otherwise.
+   * @param TransB
+   * \p true if the transpose of this matrix will be used, \p false otherwise.
+   *
+   * Computes <tt>C = alpha*op(A)*op(B) + beta*C</tt> for this matrix `B`.
+   */
+  void multiply_left(
+    const Dense& A, Dense& C,
+    const double alpha, const double beta,
+    const bool TransA, const bool TransB
+  ) const;
+
+  /**
+   * @brief Get the product with a `Dense` matrix from the right as a `LowRank`
+   * matrix
+   *
+   * @param B
+   * Second factor of the product.
+   * @param alpha
+   * Scalar to multiply the product with.
+   * @param TransA
+   * \p true if the transpose of this matrix will be used, \p false otherwise.
+   * @param TransB
+   * \p true if \p transpose(B) will be used, \p false otherwise.
+   * @return LowRank
+   * <tt>alpha*op(A)*op(B)</tt> for this matrix `A`, with the left singular
+   * vectors of `op(A)` as first factor.
+   */
+  LowRank multiply_right(
+    const Dense& B, const double alpha, const bool TransA, const bool TransB
+  ) const;
+
+  /**
+   * @brief Get the product with a `Dense` matrix from the left as a `LowRank`
+   * matrix
+   *
+   * @param A
+   * First factor of the product.
+   * @param alpha
+   * Scalar to multiply the product with.
+   * @param TransA
+   * \p true if \p transpose(A) will be used, \p false otherwise.
+   * @param TransB
+   * \p true if the transpose of this matrix will be used, \p false otherwise.
+   * @return LowRank
+   * <tt>alpha*op(A)*op(B)</tt> for this matrix `B`, with the right singular
+   * vectors of `op(B)` as third factor.
+   */
+  LowRank multiply_left(
+    const Dense& A, const double alpha, const bool TransA, const bool TransB
+  ) const;
+
+  /**
+   * @brief Split the matrix according to row and column index ranges
+   *
+   * @param row_ranges
+   * Set of non-overlapping ranges whose union is the full row index range of
+   * the matrix.
+   * @param col_ranges
+   * Set of non-overlapping ranges whose union is the full column index range
+   * of the matrix.
+   * @return std::vector<MixedPrecisionLowRank>
+   * Blocks of the matrix in row-major order. Each block keeps the singular
+   * values and the precision of each triplet, and holds copies of the parts of
+   * the singular vectors it needs.
+   */
+  std::vector<MixedPrecisionLowRank> split(
+    const std::vector<IndexRange>& row_ranges,
+    const std::vector<IndexRange>& col_ranges
+  ) const;
+};
+
+} // namespace FRANK
+
+#endif // FRANK_classes_mixed_precision_low_rank_h
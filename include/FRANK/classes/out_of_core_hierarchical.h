@@ -0,0 +1,350 @@
+/**
+ * @file out_of_core_hierarchical.h
+ * @brief Include the `OutOfCoreHierarchical` class for factorizations that do
+ * not fit into memory.
+ *
+ * @copyright Copyright (c) 2020
+ */
+#ifndef FRANK_classes_out_of_core_hierarchical_h
+#define FRANK_classes_out_of_core_hierarchical_h
+
+#include "FRANK/definitions.h"
+#include "FRANK/classes/matrix.h"
+#include "FRANK/classes/matrix_proxy.h"
+
+#include <array>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+
+/**
+ * @brief General namespace of the FRANK library
+ */
+namespace FRANK
+{
+
+class ClusterTree;
+class Hierarchical;
+class Matrix;
+class MatrixInitializer;
+
+/**
+ * @brief I/O statistics of an `OutOfCoreHierarchical` matrix
+ */
+struct OutOfCoreStatistics {
+  /**
+   * @brief Number of bytes read back from the spill file
+   */
+  uint64_t bytes_read = 0;
+  /**
+   * @brief Number of bytes written to the spill file
+   */
+  uint64_t bytes_written = 0;
+  /**
+   * @brief Number of blocks read back from the spill file
+   */
+  int64_t blocks_read = 0;
+  /**
+   * @brief Number of blocks written to the spill file
+   */
+  int64_t blocks_written = 0;
+  /**
+   * @brief Number of blocks that were already in memory when they were needed
+   */
+  int64_t hits = 0;
+  /**
+   * @brief Number of blocks that had to be waited for
+   */
+  int64_t misses = 0;
+  /**
+   * @brief Time in seconds the computation spent waiting for I/O
+   */
+  double stall_time = 0;
+  /**
+   * @brief Largest amount of memory in bytes held by resident blocks
+   */
+  uint64_t peak_memory = 0;
+};
+
+class BlockStore;
+struct BlockHandle;
+
+/**
+ * @brief Leaf block of an `OutOfCoreHierarchical` matrix
+ *
+ * Stands in for a `Dense` or `LowRank` leaf of the `Hierarchical` structure of
+ * an `OutOfCoreHierarchical` matrix. The block itself is held by the spill
+ * store of the matrix, either in memory or serialized to disk. Copies share
+ * the same block, which is freed with the last copy.
+ *
+ * Operations do not need to know about this class: gemm(), trsm(), getrf(),
+ * `operator+=()` and `operator*=()` read the block back if needed and keep it
+ * in memory while they use it, see `ResidentBlock`.
+ */
+class SpilledBlock : public Matrix {
+ public:
+  /**
+   * @brief Dimension of the block {rows, columns}
+   */
+  std::array<int64_t, 2> dim = {0, 0};
+  /**
+   * @brief Entry of the block in its spill store
+   */
+  std::shared_ptr<BlockHandle> handle;
+
+  // Special member functions
+  SpilledBlock() = default;
+
+  virtual ~SpilledBlock() = default;
+
+  SpilledBlock(const SpilledBlock& A) = default;
+
+  SpilledBlock& operator=(const SpilledBlock& A) = default;
+
+  SpilledBlock(SpilledBlock&& A) = default;
+
+  SpilledBlock& operator=(SpilledBlock&& A) = default;
+
+  /**
+   * @brief Add a block to a spill store
+   *
+   * @param store
+   * Spill store of the matrix.
+   * @param A
+   * Block to be moved into the store. It may be written to disk right away if
+   * the memory budget of the store is exceeded.
+   */
+  SpilledBlock(const std::shared_ptr<BlockStore>& store, MatrixProxy&& A);
+
+  /**
+   * @brief Get the block, reading it from disk if needed
+   *
+   * @return MatrixProxy&
+   * Reference to the block, valid until the matching release().
+   *
+   * The block is pinned in memory until release() is called. Assigning to the
+   * returned `MatrixProxy` replaces the block.
+   */
+  MatrixProxy& acquire() const;
+
+  /**
+   * @brief Unpin the block acquired before
+   *
+   * @param modified
+   * Whether the block was modified. Modified blocks are written back to disk
+   * when they are evicted.
+   */
+  void release(const bool modified=false) const;
+
+  /**
+   * @brief Add the `L` factor of this block to the same spill store
+   *
+   * @param L
+   * Lower triangular factor computed from this block.
+   * @return SpilledBlock
+   * New leaf holding \p L, in the entry reserved for it by
+   * OutOfCoreHierarchical::plan_getrf() if there is one.
+   */
+  SpilledBlock add_lower_factor(MatrixProxy&& L) const;
+};
+
+/**
+ * @brief Keeps a block in memory while an operation uses it
+ *
+ * If the block is a `SpilledBlock`, it is read back from disk if needed and
+ * pinned in memory until the `ResidentBlock` is destroyed. Any other block is
+ * passed through unchanged.
+ */
+class ResidentBlock {
+ private:
+  const SpilledBlock* spilled = nullptr;
+  Matrix* block = nullptr;
+  bool modified = false;
+ public:
+  // Special member functions
+  ResidentBlock() = delete;
+
+  ~ResidentBlock();
+
+  ResidentBlock(const ResidentBlock& A) = delete;
+
+  ResidentBlock& operator=(const ResidentBlock& A) = delete;
+
+  ResidentBlock(ResidentBlock&& A) = delete;
+
+  ResidentBlock& operator=(ResidentBlock&& A) = delete;
+
+  /**
+   * @brief Make a block resident
+   *
+   * @param A
+   * Block to be used.
+   * @param modified
+   * Whether the operation modifies the block, so that it has to be written
+   * back to disk when it is evicted.
+   */
+  ResidentBlock(const Matrix& A, const bool modified=false);
+
+  /**
+   * @brief Get the block in memory
+   *
+   * @return Matrix&
+   * The block held by the `SpilledBlock`, or the block passed to the
+   * constructor.
+   */
+  Matrix& get() const;
+};
+
+/**
+ * @brief Hierarchical matrix whose leaf blocks are spilled to disk under a
+ * memory budget
+ *
+ * The matrix keeps the `Hierarchical` structure of the matrix in memory, with
+ * each `Dense` and `LowRank` leaf replaced by a `SpilledBlock`. The leaves are
+ * either held in memory or serialized to a spill file on local disk, and are
+ * evicted whenever the memory used by resident leaves would exceed the budget.
+ * The usual recursive algorithms for `Hierarchical` matrices then run on the
+ * structure, reading each leaf back when an operation uses it.
+ *
+ * getrf(OutOfCoreHierarchical&) and trsm(const OutOfCoreHierarchical&, Dense&,
+ * const Mode) follow the traversal of the recursive getrf and trsm to plan the
+ * order in which leaves are used. A background thread uses the plan to read
+ * leaves ahead of their use and to write evicted leaves back while the
+ * computation continues. The leaf evicted is the one whose next use lies
+ * furthest in the future. Leaves that are not modified after being read back
+ * are dropped without writing them again.
+ */
+class OutOfCoreHierarchical {
+ public:
+  /**
+   * @brief Number of block rows and columns of the top level
+   */
+  std::array<int64_t, 2> dim = {0, 0};
+  /**
+   * @brief `Hierarchical` structure of the matrix, holding `U` after getrf()
+   */
+  MatrixProxy upper;
+  /**
+   * @brief `Hierarchical` structure of `L` after getrf(), empty before
+   */
+  MatrixProxy lower;
+ private:
+  std::shared_ptr<BlockStore> store;
+  std::vector<int64_t> n_rows, n_cols;
+ public:
+  // Special member functions
+  OutOfCoreHierarchical() = delete;
+
+  ~OutOfCoreHierarchical();
+
+  OutOfCoreHierarchical(const OutOfCoreHierarchical& A) = delete;
+
+  OutOfCoreHierarchical& operator=(const OutOfCoreHierarchical& A) = delete;
+
+  OutOfCoreHierarchical(OutOfCoreHierarchical&& A);
+
+  OutOfCoreHierarchical& operator=(OutOfCoreHierarchical&& A);
+
+  /**
+   * @brief Take over the blocks of a `Hierarchical` matrix
+   *
+   * @param A
+   * `Hierarchical` matrix to be moved from.
+   * @param memory_budget
+   * Memory in bytes that resident leaf blocks may use. Leaves in use by an
+   * operation are never evicted, so the budget is exceeded if it cannot hold
+   * the operands of a single leaf operation.
+   * @param directory
+   * Directory of the spill file. If empty, `TMPDIR` or `/tmp` is used. The
+   * file is removed right after it is created.
+   * @param lookahead
+   * Number of planned leaf accesses that are read ahead of their use.
+   */
+  OutOfCoreHierarchical(
+    Hierarchical&& A, const uint64_t memory_budget,
+    const std::string& directory="", const int64_t lookahead=8
+  );
+
+  /**
+   * @brief Construct the leaf blocks from a cluster tree one at a time
+   *
+   * @param node
+   * Root of the cluster tree.
+   * @param initializer
+   * Initializer for the blocks, as for the `Hierarchical` matrix constructors.
+   * @param fixed_rank
+   * If true, admissible blocks are compressed to a fixed rank, otherwise to a
+   * fixed accuracy.
+   * @param memory_budget
+   * Memory in bytes that resident leaf blocks may use.
+   * @param directory
+   * Directory of the spill file.
+   * @param lookahead
+   * Number of planned leaf accesses that are read ahead of their use.
+   *
+   * Leaves are spilled while the matrix is constructed, so the whole matrix
+   * never needs to fit into memory.
+   */
+  OutOfCoreHierarchical(
+    const ClusterTree& node,
+    const MatrixInitializer& initializer,
+    const bool fixed_rank,
+    const uint64_t memory_budget,
+    const std::string& directory="",
+    const int64_t lookahead=8
+  );
+
+  /**
+   * @brief Plan the leaf accesses of getrf(OutOfCoreHierarchical&)
+   *
+   * Follows the recursion of getrf() on \p upper without computing anything,
+   * and passes the order in which leaves will be used to the spill store. The
+   * leaves of `L` that the factorization will create are reserved, so that
+   * their later uses are planned as well. Uses that do not follow the plan are
+   * allowed, but are not prefetched.
+   */
+  void plan_getrf() const;
+
+  /**
+   * @brief Plan the leaf accesses of trsm(const OutOfCoreHierarchical&, Dense&,
+   * const Mode)
+   *
+   * @param uplo
+   * `Mode::Lower` to plan the solve with \p lower, `Mode::Upper` with \p upper.
+   */
+  void plan_trsm(const Mode uplo) const;
+
+  /**
+   * @brief Get the number of rows of a top level block row
+   *
+   * @param i
+   * Block row index.
+   * @return int64_t
+   * Number of rows of the blocks in block row \p i.
+   */
+  int64_t get_n_rows(const int64_t i) const;
+
+  /**
+   * @brief Get the number of columns of a top level block column
+   *
+   * @param j
+   * Block column index.
+   * @return int64_t
+   * Number of columns of the blocks in block column \p j.
+   */
+  int64_t get_n_cols(const int64_t j) const;
+
+  /**
+   * @brief Get the I/O statistics accumulated so far
+   *
+   * @return OutOfCoreStatistics
+   * Copy of the statistics.
+   */
+  OutOfCoreStatistics get_statistics() const;
+};
+
+} // namespace FRANK
+
+#endif // FRANK_classes_out_of_core_hierarchical_h
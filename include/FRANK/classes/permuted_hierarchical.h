@@ -0,0 +1,137 @@
+/**
+ * @file permuted_hierarchical.h
+ * @brief Include the `PermutedHierarchical` class for `Hierarchical` matrices
+ * built on reordered points.
+ *
+ * @copyright Copyright (c) 2020
+ */
+#ifndef FRANK_classes_permuted_hierarchical_h
+#define FRANK_classes_permuted_hierarchical_h
+
+#include "FRANK/definitions.h"
+#include "FRANK/classes/hierarchical.h"
+#include "FRANK/classes/initialization_helpers/index_tree.h"
+
+#include <cstdint>
+#include <vector>
+
+
+/**
+ * @brief General namespace of the FRANK library
+ */
+namespace FRANK
+{
+
+class Dense;
+
+/**
+ * @brief `Hierarchical` matrix whose rows and columns are stored in a different
+ * order than that of its points
+ *
+ * Reordering the points, for example with sortByMortonIndex() or
+ * geometric_bisection(), is what makes the blocks of a kernel matrix
+ * compressible. This class keeps the permutation together with the matrix, so
+ * that right hand sides and solutions are always given in the original order
+ * of the points. gemm(const PermutedHierarchical&, const Dense&, Dense&,
+ * const double, const double), trsm(const PermutedHierarchical&, Dense&,
+ * const Mode) and getrf(PermutedHierarchical&) reorder the rows of their
+ * `Dense` operands in place before and after using #A.
+ *
+ * The class is not a subclass of `Matrix`. Use #A directly for operations
+ * that do not involve vectors in the original order.
+ */
+class PermutedHierarchical {
+ public:
+  /**
+   * @brief Matrix in the reordered (clustered) order
+   */
+  Hierarchical A;
+  /**
+   * @brief Original index of row and column `i` of #A, as returned by
+   * sortByMortonIndex() and geometric_bisection()
+   */
+  std::vector<int64_t> perm;
+ private:
+  std::vector<int64_t> inverse;
+  // First index of every cycle of perm that moves rows
+  std::vector<int64_t> cycles;
+ public:
+  // Special member functions
+  PermutedHierarchical() = default;
+
+  ~PermutedHierarchical() = default;
+
+  PermutedHierarchical(const PermutedHierarchical& A) = default;
+
+  PermutedHierarchical& operator=(const PermutedHierarchical& A) = default;
+
+  PermutedHierarchical(PermutedHierarchical&& A) = default;
+
+  PermutedHierarchical& operator=(PermutedHierarchical&& A) = default;
+
+  /**
+   * @brief Construct a new `PermutedHierarchical` from a matrix in reordered
+   * order
+   *
+   * @param A
+   * Matrix whose row and column `i` belong to point `perm[i]`. Moved into the
+   * new instance.
+   * @param perm
+   * Permutation of the points, see #perm.
+   */
+  PermutedHierarchical(Hierarchical&& A, const std::vector<int64_t>& perm);
+
+  /**
+   * @brief Construct a new `PermutedHierarchical` from a kernel on points that
+   * are reordered by geometric_bisection()
+   *
+   * @param kernel
+   * Kernel used to compute matrix entries from together with \p params.
+   * @param params
+   * Points in their original order, with one vector of coordinates per axis.
+   * @param nleaf
+   * Maximum size of leaf level submatrices.
+   * @param eps
+   * Fixed error threshold used for approximating admissible submatrices.
+   * @param admis
+   * Admissibility constant of `AdmisType::GeometryBased` admissibility.
+   * @param type
+   * Direction along which clusters are split.
+   */
+  PermutedHierarchical(
+    void (*kernel)(
+      double* A, const uint64_t A_rows, const uint64_t A_cols, const uint64_t A_stride,
+      const std::vector<std::vector<double>>& params,
+      const int64_t row_start, const int64_t col_start
+    ),
+    std::vector<std::vector<double>> params,
+    const int64_t nleaf, const double eps, const double admis=1,
+    const BisectionType type=BisectionType::PrincipalAxis
+  );
+
+  /**
+   * @brief Reorder the rows of a matrix from the original into the order of #A
+   *
+   * @param B
+   * Matrix with one row per point, reordered in place.
+   *
+   * The permutation is applied cycle by cycle, so only a single row is ever
+   * held in addition to \p B. Matrices with several columns are reordered by
+   * several threads, each moving its own range of columns.
+   */
+  void to_permuted(Dense& B) const;
+
+  /**
+   * @brief Reorder the rows of a matrix from the order of #A into the original
+   * order
+   *
+   * @param B
+   * Matrix with one row per point, reordered in place. Inverse of
+   * to_permuted().
+   */
+  void to_original(Dense& B) const;
+};
+
+} // namespace FRANK
+
+#endif // FRANK_classes_permuted_hierarchical_h
@@ -19,10 +19,13 @@ typedef std::tuple<Dense, Dense, Dense> DenseTriplet;
 typedef std::tuple<Dense, std::vector<int64_t>> DenseIndexSetPair;
 typedef std::tuple<double, double> DoublePair;
 
+// Element order of matrix files, Dense itself is always row-major
 enum class MatrixLayout { RowMajor, ColumnMajor };
 enum class Side { Left, Right };
 enum class Mode { Upper, Lower };
 enum class AdmisType { PositionBased, GeometryBased };
+enum class FillType { Zero, Identity };
+enum class MemoryAccess { Normal, Sequential, Random, WillNeed, DontNeed };
 
 } // namespace FRANK
 
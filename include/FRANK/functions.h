@@ -1,6 +1,7 @@
 #ifndef FRANK_functions_h
 #define FRANK_functions_h
 
+#include <complex>
 #include <cstdint>
 #include <vector>
 
@@ -223,6 +224,36 @@ void helmholtznd(
   const int64_t row_start, const int64_t col_start
 );
 
+/**
+ * @brief Complex valued kernel function for N-dimensional helmholtz
+ *
+ * @param A
+ * Array to be filled with entries
+ * @param A_rows
+ * Number of rows of \p A
+ * @param A_cols
+ * Number of columns of \p A
+ * @param A_stride
+ * Stride of \p A
+ * @param x
+ * 2D vector that holds geometry information: list of N-dimensional coordinates
+ * @param row_start
+ * Row offset (if generating a submatrix)
+ * @param col_start
+ * Column offset (if generating a submatrix)
+ *
+ * Assigns <tt>exp(i*r)/(r+1e-3)</tt> with the distance \p r of the two points,
+ * the oscillatory kernel of the Helmholtz equation with unit wave number. This
+ * function is used as kernel to generate matrix with
+ * `MatrixInitializerComplexKernel`.
+ */
+void helmholtznd_complex(
+  std::complex<double>* A,
+  const uint64_t A_rows, const uint64_t A_cols, const uint64_t A_stride,
+  const std::vector<std::vector<double>>& x,
+  const int64_t row_start, const int64_t col_start
+);
+
 } // namespace FRANK
 
 #endif // FRANK_functions_h
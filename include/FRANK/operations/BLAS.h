@@ -2,6 +2,7 @@
 #define FRANK_operations_BLAS_h
 
 #include "FRANK/definitions.h"
+#include "FRANK/classes/basic_dense.h"
 #include "FRANK/classes/dense.h"
 
 
@@ -11,7 +12,10 @@
 namespace FRANK
 {
 
+class Hierarchical;
 class Matrix;
+class OutOfCoreHierarchical;
+class PermutedHierarchical;
 
 /**
  * @brief Perform in-place matrix-matrix multiplication
@@ -52,6 +56,30 @@ void gemm(
   const bool TransA=false, const bool TransB=false
 );
 
+/**
+ * @brief Multiply a `PermutedHierarchical` matrix with vectors in the original
+ * order of its points
+ *
+ * @param A
+ * `PermutedHierarchical` matrix
+ * @param B
+ * `Dense` matrix with one row per point, in the original order
+ * @param C
+ * `Dense` matrix with one row per point, in the original order
+ * @param alpha
+ * Scalar value
+ * @param beta
+ * Scalar value
+ *
+ * Computes <tt>C = alpha*A*B + beta*C</tt>. \p C is reordered in place before
+ * and after the product with PermutedHierarchical::A. \p B is constant, so its
+ * rows are gathered into a reordered copy.
+ */
+void gemm(
+  const PermutedHierarchical& A, const Dense& B, Dense& C,
+  const double alpha=1, const double beta=1
+);
+
 /**
  * @brief Perform matrix-matrix multiplication
  *
@@ -200,6 +228,153 @@ void trmm(
  */
 void trsm(const Matrix& A, Matrix& B, const Mode uplo, const Side side=Side::Left);
 
+/**
+ * @brief Perform in-place matrix-matrix multiplication of `BasicDense` matrices
+ *
+ * @tparam T
+ * Scalar type of the matrices.
+ * @param A
+ * `BasicDense` instance
+ * @param B
+ * `BasicDense` instance
+ * @param C
+ * `BasicDense` instance
+ * @param alpha
+ * Scalar value
+ * @param beta
+ * Scalar value
+ * @param TransA
+ * \p true if \p transpose(A) will be used, \p false otherwise
+ * @param TransB
+ * \p true if \p transpose(B) will be used, \p false otherwise
+ *
+ * Same as gemm() for `Dense` matrices, using the \p sgemm, \p cgemm or
+ * \p zgemm subroutine of BLAS depending on \p T. Transposition does not
+ * conjugate complex elements.
+ */
+template<typename T>
+void gemm(
+  const BasicDense<T>& A, const BasicDense<T>& B, BasicDense<T>& C,
+  const typename BasicDense<T>::value_type alpha=1,
+  const typename BasicDense<T>::value_type beta=1,
+  const bool TransA=false, const bool TransB=false
+);
+
+/**
+ * @brief Perform matrix-matrix multiplication of `BasicDense` matrices
+ *
+ * @tparam T
+ * Scalar type of the matrices.
+ * @param A
+ * `BasicDense` instance
+ * @param B
+ * `BasicDense` instance
+ * @param alpha
+ * Scalar value
+ * @param TransA
+ * \p true if \p transpose(A) will be used, \p false otherwise
+ * @param TransB
+ * \p true if \p transpose(B) will be used, \p false otherwise
+ *
+ * @return BasicDense<T>
+ * New matrix containing <tt>alpha*op(A)*op(B)</tt>.
+ */
+template<typename T>
+BasicDense<T> gemm(
+  const BasicDense<T>& A, const BasicDense<T>& B,
+  const typename BasicDense<T>::value_type alpha=1,
+  const bool TransA=false, const bool TransB=false
+);
+
+/**
+ * @brief Multiply a `Hierarchical` matrix with `BasicDense` blocks and a
+ * `BasicDense` matrix
+ *
+ * @tparam T
+ * Scalar type of the matrices.
+ * @param A
+ * `Hierarchical` instance whose leaves are `BasicDense<T>` or
+ * `BasicLowRank<T>`, for example one built from a complex kernel.
+ * @param B
+ * `BasicDense` instance
+ * @param C
+ * `BasicDense` instance
+ * @param alpha
+ * Scalar value
+ * @param beta
+ * Scalar value
+ *
+ * This function performs the matrix-matrix operation
+ *
+ * <tt>C = alpha*A*B + beta*C</tt>
+ *
+ * block by block, without splitting \p B and \p C into submatrices.
+ */
+template<typename T>
+void gemm(
+  const Hierarchical& A, const BasicDense<T>& B, BasicDense<T>& C,
+  const typename BasicDense<T>::value_type alpha=1,
+  const typename BasicDense<T>::value_type beta=1
+);
+
+/**
+ * @brief Solve triangular system of equations represented by `BasicDense` matrices
+ *
+ * @tparam T
+ * Scalar type of the matrices.
+ * @param A
+ * A (lower or upper) triangular `BasicDense` matrix
+ * @param B
+ * `BasicDense` instance
+ * @param uplo
+ * \p Mode::Upper if \p A is an upper triangular matrix, \p Mode::Lower if lower triangular
+ * @param side
+ * \p Side::Left if \p A is multiplied from the left of \p X, \p Side::Right if multiplied from the right of \p X
+ *
+ * Same as trsm() for `Dense` matrices, that is \p A has a unit diagonal if
+ * \p uplo is Mode::Lower, using the \p strsm, \p ctrsm or \p ztrsm
+ * subroutine of BLAS depending on \p T.
+ */
+template<typename T>
+void trsm(
+  const BasicDense<T>& A, BasicDense<T>& B,
+  const Mode uplo, const Side side=Side::Left
+);
+
+/**
+ * @brief Solve with a factor of an out-of-core LU factorization
+ *
+ * @param A
+ * `OutOfCoreHierarchical` matrix factorized with getrf(OutOfCoreHierarchical&).
+ * @param B
+ * Right hand side in memory, overwritten by the solution.
+ * @param uplo
+ * \p Mode::Lower to solve with the unit lower triangular factor, \p Mode::Upper
+ * to solve with the upper triangular factor.
+ *
+ * Solves <tt>L*X = B</tt> or <tt>U*X = B</tt> with trsm(const Matrix&,
+ * Matrix&, const Mode, const Side), reading the leaf blocks of \p A ahead of
+ * the order the recursion needs them in.
+ */
+void trsm(const OutOfCoreHierarchical& A, Dense& B, const Mode uplo);
+
+/**
+ * @brief Solve with a factor of a `PermutedHierarchical` matrix
+ *
+ * @param A
+ * Triangular factor returned by getrf(PermutedHierarchical&).
+ * @param B
+ * Right hand side with one row per point in the original order, overwritten
+ * by the solution in the original order.
+ * @param uplo
+ * \p Mode::Lower to solve with the unit lower triangular factor, \p Mode::Upper
+ * to solve with the upper triangular factor.
+ *
+ * The rows of \p B are reordered in place before and after the solve, without
+ * copying \p B.
+ */
+void trsm(const PermutedHierarchical& A, Dense& B, const Mode uplo);
+
 } // namespace FRANK
 
 #endif // FRANK_operations_BLAS_h
@@ -1,7 +1,10 @@
 #ifndef FRANK_operations_LAPACK_h
 #define FRANK_operations_LAPACK_h
 
+#include "FRANK/classes/basic_dense.h"
+
 #include <cstdint>
+#include <string>
 #include <tuple>
 #include <vector>
 
@@ -16,6 +19,8 @@ class Matrix;
 class MatrixProxy;
 class Dense;
 class Hierarchical;
+class OutOfCoreHierarchical;
+class PermutedHierarchical;
 
 /**
  * @brief Compute LU factorization of a general matrix
@@ -39,6 +44,121 @@ class Hierarchical;
  */
 std::tuple<MatrixProxy, MatrixProxy> getrf(Matrix& A);
 
+/**
+ * @brief Compute LU factorization of a `Hierarchical` matrix with checkpoints
+ *
+ * @param A
+ * Square `Hierarchical` matrix to be factorized. Modified on finish.
+ * @param checkpoint_filename
+ * File holding the progress of the factorization, see save_checkpoint().
+ * @param checkpoint_interval
+ * Number of block columns of \p A factorized between checkpoints.
+ *
+ * @return Tuple of `MatrixProxy` instances containing the lower and upper triangular factors
+ *
+ * Same as getrf(Matrix&), except that the partial factors are written to
+ * \p checkpoint_filename after every \p checkpoint_interval block columns
+ * and after the last one, together with the fingerprint() of \p A. If the
+ * file already exists and holds the fingerprint of \p A, the factorization
+ * resumes from it instead of starting from \p A, so that an interrupted run
+ * can be restarted with the same arguments; the contents of \p A are then
+ * replaced by those of the checkpoint. A checkpoint of a completed
+ * factorization thus returns the factors without further work. Checkpoints
+ * written for any other matrix are ignored and overwritten.
+ */
+std::tuple<MatrixProxy, MatrixProxy> getrf(
+  Hierarchical& A, const std::string checkpoint_filename,
+  const int64_t checkpoint_interval=1
+);
+
+/**
+ * @brief Compute LU factorization of a `BasicDense` matrix
+ *
+ * @tparam T
+ * Scalar type of \p A.
+ * @param A
+ * M-by-N `BasicDense` matrix to be factorized. Modified on finish.
+ *
+ * @return Tuple of `BasicDense` matrices containing the lower and upper triangular factors
+ *
+ * Same as getrf(Matrix&) for a `Dense` matrix, using the \p sgetrf,
+ * \p cgetrf or \p zgetrf subroutine of LAPACK depending on \p T.
+ */
+template<typename T>
+std::tuple<BasicDense<T>, BasicDense<T>> getrf(BasicDense<T>& A);
+
+/**
+ * @brief Compute the LU factorization of an out-of-core block matrix in place
+ *
+ * @param A
+ * Square `OutOfCoreHierarchical` matrix to be factorized. Holds both factors
+ * on finish.
+ *
+ * Runs getrf(Matrix&) on the `Hierarchical` structure of \p A, without
+ * pivoting. The order in which the recursion uses the leaf blocks is passed to
+ * the spill store first, see OutOfCoreHierarchical::plan_getrf(), so that
+ * leaves are read ahead and evicted leaves are written back while the leaf
+ * operations run.
+ *
+ * On finish, OutOfCoreHierarchical::lower holds `L` and
+ * OutOfCoreHierarchical::upper holds `U`. Use trsm(const
+ * OutOfCoreHierarchical&, Dense&, const Mode) to solve with the factors.
+ */
+void getrf(OutOfCoreHierarchical& A);
+
+/**
+ * @brief Compute the LU factorization of a `PermutedHierarchical` matrix
+ *
+ * @param A
+ * Square `PermutedHierarchical` matrix to be factorized. Modified on finish.
+ * @return std::tuple<PermutedHierarchical, PermutedHierarchical>
+ * `L` and `U` factors of PermutedHierarchical::A, with the same permutation as
+ * \p A.
+ *
+ * The factorization is that of the reordered matrix, so no permutation is
+ * needed here. Solve with trsm(const PermutedHierarchical&, Dense&, const Mode)
+ * using right hand sides in the original order.
+ */
+std::tuple<PermutedHierarchical, PermutedHierarchical> getrf(
+  PermutedHierarchical& A
+);
+
+/**
+ * @brief Solve a linear system with a single precision LU factorization and iterative refinement
+ *
+ * @param A
+ * N-by-N `Matrix` of the system, typically `Hierarchical`. Not modified.
+ * @param b
+ * N-by-NRHS `Dense` right hand side.
+ * @param tol
+ * Refinement stops once the residual <tt>||b - A*x||</tt> is at most
+ * \p tol times <tt>||b||</tt>.
+ * @param max_iter
+ * Maximum number of refinement iterations per factorization.
+ *
+ * @return Tuple containing the solution \p x, the total number of refinement
+ * iterations performed, whether the double precision factorization was
+ * needed and whether the residual reached \p tol
+ *
+ * The `Dense` blocks of a copy of \p A are converted with
+ * to_single_precision() and factorized with getrf(), which halves their
+ * memory and runs their factorization in single precision. The solution is
+ * then refined against \p A in double precision, each iteration applying the
+ * single precision factors to the residual.
+ *
+ * If the residual does not at least halve in an iteration, or \p max_iter
+ * iterations are not enough, the refinement is considered stalled. \p A is
+ * then factorized in double precision and the refinement continues from the
+ * current solution with those factors, similar to <tt>dsgesv</tt> of LAPACK.
+ * If that refinement stalls as well, for example because \p A is too
+ * ill-conditioned, the last solution is returned and reported as not
+ * converged.
+ */
+std::tuple<Dense, int64_t, bool, bool> dsgesv(
+  const Matrix& A, const Dense& b,
+  const double tol=1e-14, const int64_t max_iter=30
+);
+
 /**
  * @brief Compute one-sided interpolative decomposition (ID) of a `Dense` matrix
  *
@@ -3,6 +3,7 @@
 
 #include "FRANK/classes/dense.h"
 #include "FRANK/classes/matrix.h"
+#include "FRANK/classes/matrix_product.h"
 #include "FRANK/classes/matrix_proxy.h"
 
 
@@ -79,6 +80,34 @@ MatrixProxy operator-(const Matrix& A, const Matrix& B);
  */
 Matrix& operator*=(Matrix& A, const double b);
 
+/**
+ * @brief Defines multiplication operator between two `Dense` matrices
+ *
+ * @param A
+ * `Dense` instance
+ * @param B
+ * `Dense` instance
+ *
+ * @return MatrixProduct
+ * Lazy product <tt>A*B</tt>, which is only computed when it is evaluated or
+ * converted to a `Dense` matrix
+ */
+MatrixProduct operator*(const Dense& A, const Dense& B);
+
+/**
+ * @brief Appends a `Dense` matrix to a lazy product chain
+ *
+ * @param AB
+ * `MatrixProduct` instance
+ * @param C
+ * `Dense` instance
+ *
+ * @return MatrixProduct
+ * Lazy product <tt>AB*C</tt>. The evaluation order of the whole chain is
+ * decided when it is evaluated, not by the order of the operators.
+ */
+MatrixProduct operator*(MatrixProduct AB, const Dense& C);
+
 } // namespace FRANK
 
 #endif // FRANK_operations_arithmetic_h
@@ -152,9 +152,12 @@ int64_t find_svd_truncation_rank(const Dense& S, const double eps);
  * @param level
  * Recursion level of the morton quadtree
  * @param perm
- * Row (and column) permutation for dense matrix that uses the original ordering
+ * Row (and column) permutation for dense matrix that uses the original ordering.
+ * Resized to the number of points.
  *
  * The parameter \p level controls the depth of quadtree, i.e. the number of different boxes that will be created is 2<sup>level+1</sup>.
+ * Morton indices are stored in 64 bits, so \p level is limited to 64/dim (and 32) levels.
+ * Points in the same box keep their relative order. The indices are sorted with a radix sort, which uses several threads for large numbers of points.
  *
  * The n-dimensional points is assumed to be stored as follows
  * ```
@@ -253,6 +256,52 @@ Hierarchical split(const Matrix& A, const Hierarchical& like, const bool copy=fa
  */
 MatrixProxy shallow_copy(const Matrix& A);
 
+/**
+ * @brief Get a copy of a matrix with its `Dense` blocks in single precision
+ *
+ * @param A
+ * `Matrix` instance
+ *
+ * @return
+ * Copy of \p A in which every `Dense` block is converted to `SDense`
+ *
+ * `LowRank` and other blocks are copied as they are, since operations on them
+ * are only available in double precision. The result can be factorized with
+ * getrf(), which then runs the `Dense` block operations in single precision.
+ *
+ * Definitions may differ depending on the types of the parameters.
+ * Definition for each combination of types (subclasses of `Matrix`) is implemented as a specialization of \OMM.
+ * The multi-dispatcher then will select the correct implementation based on the types of parameters given at runtime.
+ * Read \ext_FRANK for more information.
+ */
+MatrixProxy to_single_precision(const Matrix& A);
+
+/**
+ * @brief Get a copy of a matrix with each block stored in the lowest sufficient precision
+ *
+ * @param A
+ * `Matrix` instance
+ * @param eps
+ * Relative error in the Frobenius norm that may be introduced by storing
+ * blocks in reduced precision.
+ *
+ * @return
+ * Copy of \p A in which `LowRank` blocks are converted to
+ * `MixedPrecisionLowRank` and `Dense` blocks to `SDense` where possible
+ *
+ * The admissible error <tt>eps*||A||</tt> is distributed over the blocks in
+ * proportion to their size. Blocks whose contribution to the norm of \p A is
+ * small, typically those far from the diagonal, thus end up in lower precision.
+ * The result can be used with gemm() for matrix-vector products, which
+ * decompress the blocks to double precision on the fly.
+ *
+ * Definitions may differ depending on the types of the parameters.
+ * Definition for each combination of types (subclasses of `Matrix`) is implemented as a specialization of \OMM.
+ * The multi-dispatcher then will select the correct implementation based on the types of parameters given at runtime.
+ * Read \ext_FRANK for more information.
+ */
+MatrixProxy adapt_precision(const Matrix& A, const double eps);
+
 /**
  * @brief Compute the L2 (Frobenius) norm of a matrix
  *
@@ -307,6 +356,25 @@ MatrixProxy transpose(const Matrix&);
  */
 MatrixProxy resize(const Matrix&, const int64_t n_rows, const int64_t n_cols);
 
+/**
+ * @brief Resize a `Dense` matrix that is no longer needed by the caller
+ *
+ * @param A
+ * `Dense` matrix to be resized, left in a moved-from state
+ * @param n_rows
+ * New row dimension less than or equal to the current row dimension of \p A
+ * @param n_cols
+ * New column dimension less than or equal to the current column dimension of \p A
+ *
+ * @return Dense
+ * Leading \p n_rows x \p n_cols submatrix of \p A
+ *
+ * Unlike the overload for `const Matrix&`, this truncates \p A in place via
+ * Dense::truncate() and moves it into the return value, so no memory is
+ * allocated when \p A owns its buffer exclusively.
+ */
+Dense resize(Dense&& A, const int64_t n_rows, const int64_t n_cols);
+
 } // namespace FRANK
 
 #endif // FRANK_operations_misc_h
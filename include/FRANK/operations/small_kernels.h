@@ -0,0 +1,97 @@
+/**
+ * @file small_kernels.h
+ * @brief Kernels for very small `Dense` matrices.
+ *
+ * The `Dense` specializations of gemm(), trmm(), trsm() and qr() dispatch to
+ * these kernels when all involved dimensions are at most
+ * FRANK::SMALL_KERNEL_MAX_DIM. For such sizes, which are typical for the `S`
+ * factor of a `LowRank` matrix or the `T` and `R` factors of blocked QR
+ * factorizations, the call overhead of BLAS and the transposition done by the
+ * row-major LAPACKE interface dominate the actual computation.
+ *
+ * Each kernel is a template over the inner (or triangular) dimension, so that
+ * its innermost loops have compile-time trip counts. All instantiations from 1
+ * to FRANK::SMALL_KERNEL_MAX_DIM are compiled, and the matching one is
+ * selected at runtime.
+ *
+ * @copyright Copyright (c) 2020
+ */
+#ifndef FRANK_operations_small_kernels_h
+#define FRANK_operations_small_kernels_h
+
+#include "FRANK/definitions.h"
+
+#include <cstdint>
+
+
+/**
+ * @brief General namespace of the FRANK library
+ */
+namespace FRANK
+{
+
+/**
+ * @brief Largest dimension for which the small kernels are used
+ */
+constexpr int64_t SMALL_KERNEL_MAX_DIM = 32;
+
+/**
+ * @brief Small-matrix version of gemm() for `Dense` matrices
+ *
+ * @return bool
+ * \p true if the operation was performed, \p false if any dimension is zero
+ * or exceeds FRANK::SMALL_KERNEL_MAX_DIM and BLAS should be used instead.
+ *
+ * Parameters and semantics are the same as for gemm().
+ */
+bool small_gemm(
+  const Dense& A, const Dense& B, Dense& C,
+  const double alpha, const double beta,
+  const bool TransA, const bool TransB
+);
+
+/**
+ * @brief Small-matrix version of trmm() for `Dense` matrices
+ *
+ * @return bool
+ * \p true if the operation was performed, \p false if any dimension is zero
+ * or exceeds FRANK::SMALL_KERNEL_MAX_DIM and BLAS should be used instead.
+ *
+ * Parameters and semantics are the same as for trmm().
+ */
+bool small_trmm(
+  const Dense& A, Dense& B,
+  const Side side, const Mode uplo, const char& trans, const char& diag,
+  const double alpha
+);
+
+/**
+ * @brief Small-matrix version of trsm() for `Dense` matrices
+ *
+ * @return bool
+ * \p true if the operation was performed, \p false if any dimension is zero
+ * or exceeds FRANK::SMALL_KERNEL_MAX_DIM and BLAS should be used instead.
+ *
+ * Parameters and semantics are the same as for trsm(), that is \p A is taken
+ * to have a unit diagonal if \p uplo is Mode::Lower.
+ */
+bool small_trsm(const Dense& A, Dense& B, const Mode uplo, const Side side);
+
+/**
+ * @brief Small-matrix version of qr() for `Dense` matrices
+ *
+ * @return bool
+ * \p true if the factorization was performed, \p false if any dimension is
+ * zero or exceeds FRANK::SMALL_KERNEL_MAX_DIM and LAPACK should be used
+ * instead.
+ *
+ * Parameters and semantics are the same as for qr(). The unblocked Householder
+ * algorithm of LAPACK's <tt>dgeqr2</tt> and <tt>dorg2r</tt> is used, so that
+ * \p A is left in the same state and the factors have the same signs as with
+ * LAPACK.
+ */
+bool small_qr(Dense& A, Dense& Q, Dense& R);
+
+} // namespace FRANK
+
+#endif // FRANK_operations_small_kernels_h
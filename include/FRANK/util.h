@@ -7,8 +7,11 @@
 #include "FRANK/util/get_memory_usage.h"
 #include "FRANK/util/initialize.h"
 #include "FRANK/util/l2_error.h"
+#include "FRANK/util/mapped_file.h"
+#include "FRANK/util/matrix_file.h"
 #include "FRANK/util/omm_error_handler.h"
 #include "FRANK/util/print.h"
+#include "FRANK/util/serialization.h"
 #include "FRANK/util/timer.h"
 #include "FRANK/util/geometry_file.h"
 
@@ -0,0 +1,198 @@
+/**
+ * @file mapped_file.h
+ * @brief Include the `MappedFile` class used as backing store of `Dense`.
+ *
+ * @copyright Copyright (c) 2020
+ */
+#ifndef FRANK_util_mapped_file_h
+#define FRANK_util_mapped_file_h
+
+#include "FRANK/definitions.h"
+
+#include <array>
+#include <cstdint>
+#include <memory>
+#include <string>
+
+
+namespace FRANK
+{
+
+/**
+ * @brief Shared, file backed memory mapping holding the elements of a `Dense`
+ * matrix
+ *
+ * The file is extended to its full size with `ftruncate()`, so that it is
+ * created sparse: no disk space is used and no page is touched until an
+ * element is written. Pages are then read and written back by the kernel on
+ * demand, allowing matrices larger than the physical memory.
+ *
+ * If no file name is given, an anonymous file is created in `TMPDIR` (or
+ * `/tmp`) and unlinked right away, so that it disappears with the mapping.
+ * Named files are kept after the mapping is destroyed.
+ *
+ * A `MappedFile` can also be a window onto part of a larger mapping created
+ * with map_file(), which it keeps alive. This is used to load serialized
+ * matrices without copying their elements.
+ *
+ * Errors from the system calls are fatal and abort the program, in the same
+ * way as missing \OMM specializations.
+ */
+class MappedFile {
+ public:
+  /**
+   * @brief Dimension {rows, columns} of the matrix stored in the mapping
+   */
+  std::array<int64_t, 2> dim;
+  /**
+   * @brief Row stride in elements
+   *
+   * Rows of at least one page are padded to a whole number of pages, shorter
+   * rows are stored without padding.
+   */
+  int64_t stride;
+ private:
+  // Owner of the mapping, which is unmapped once the last window is destroyed
+  std::shared_ptr<char> region;
+  double* data_ptr = nullptr;
+  // Whether this is a window onto a mapping created elsewhere
+  bool is_window = false;
+ public:
+  MappedFile() = delete;
+
+  ~MappedFile() = default;
+
+  MappedFile(const MappedFile& A) = delete;
+
+  MappedFile& operator=(const MappedFile& A) = delete;
+
+  MappedFile(MappedFile&& A) = delete;
+
+  MappedFile& operator=(MappedFile&& A) = delete;
+
+  /**
+   * @brief Map a file large enough for a matrix of the given size
+   *
+   * @param n_rows
+   * Number of rows of the matrix.
+   * @param n_cols
+   * Number of columns of the matrix.
+   * @param filename
+   * Path to the file. Existing files are truncated. If empty, an anonymous
+   * temporary file is used.
+   */
+  MappedFile(
+    const int64_t n_rows, const int64_t n_cols, const std::string& filename
+  );
+
+  /**
+   * @brief Create a window onto a matrix stored in an existing mapping
+   *
+   * @param region
+   * Mapping returned by map_file().
+   * @param data
+   * First element of the matrix within \p region, stored in row-major order
+   * without padding.
+   * @param n_rows
+   * Number of rows of the matrix.
+   * @param n_cols
+   * Number of columns of the matrix.
+   */
+  MappedFile(
+    const std::shared_ptr<char>& region, double* data,
+    const int64_t n_rows, const int64_t n_cols
+  );
+
+  /**
+   * @brief Get a pointer to the first element of the mapping
+   *
+   * @return double*
+   * Pointer to the first element, page aligned unless this is a window.
+   */
+  double* data() const;
+
+  /**
+   * @brief Get the size of the mapping
+   *
+   * @return uint64_t
+   * Number of `double` elements in the mapping, `dim[0]*stride`.
+   */
+  uint64_t size() const;
+
+  /**
+   * @brief Give the kernel a hint on how a part of the mapping will be used
+   *
+   * @param begin
+   * Pointer to the first element of the range.
+   * @param n_elements
+   * Number of elements in the range.
+   * @param access
+   * Expected access pattern, see `MemoryAccess`.
+   *
+   * The range is widened to whole pages before calling `madvise()`, so that
+   * elements outside of it sharing these pages are affected as well. Failure
+   * is not an error since the advice does not change the contents of the
+   * mapping.
+   *
+   * For windows, which may be private copy-on-write mappings created by
+   * map_file(), `MemoryAccess::DontNeed` pages the range out with
+   * `MADV_PAGEOUT` instead of dropping it, so that modified elements are kept.
+   * It does nothing where `MADV_PAGEOUT` is not available.
+   */
+  void advise(
+    const double* begin, const uint64_t n_elements, const MemoryAccess access
+  ) const;
+};
+
+/**
+ * @brief Create an anonymous temporary file
+ *
+ * @param directory
+ * Directory of the file. If empty, `TMPDIR` or `/tmp` is used.
+ * @return int
+ * File descriptor opened for reading and writing.
+ *
+ * The file is unlinked right after it is created, so that it is removed once
+ * the descriptor is closed.
+ */
+int create_temporary_file(const std::string& directory);
+
+/**
+ * @brief Map a whole existing file privately into memory
+ *
+ * @param filename
+ * Path to the file.
+ * @param n_bytes
+ * Set to the size of the file.
+ * @return std::shared_ptr<char>
+ * Start of the mapping, which is unmapped with the last copy of the pointer.
+ * Null if the file cannot be opened or is empty.
+ *
+ * The mapping is readable and writable, but copy-on-write: changes are never
+ * written back to the file.
+ */
+std::shared_ptr<char> map_file(const std::string& filename, uint64_t& n_bytes);
+
+/**
+ * @brief Map a whole POSIX shared memory object privately into memory
+ *
+ * @param name
+ * Name of the object as passed to `shm_open()`, starting with a slash.
+ * @param n_bytes
+ * Set to the size of the object.
+ * @return std::shared_ptr<char>
+ * Start of the mapping, which is unmapped with the last copy of the pointer.
+ * Null if the object does not exist or is empty.
+ *
+ * As with map_file(), the mapping is readable and writable, but copy-on-write.
+ * Pages that are only read are those of the object, so that all processes
+ * mapping it use the same physical memory. A page that is written is copied
+ * first, and the change is never seen by the object or other processes.
+ */
+std::shared_ptr<char> map_shared_memory(
+  const std::string& name, uint64_t& n_bytes
+);
+
+} // namespace FRANK
+
+#endif // FRANK_util_mapped_file_h
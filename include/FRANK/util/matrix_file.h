@@ -0,0 +1,113 @@
+/**
+ * @file matrix_file.h
+ * @brief Include functions for writing binary matrix files.
+ *
+ * @copyright Copyright (c) 2020
+ */
+#ifndef FRANK_util_matrix_file_h
+#define FRANK_util_matrix_file_h
+
+#include "FRANK/definitions.h"
+
+#include <cstdint>
+#include <string>
+
+
+namespace FRANK
+{
+
+/**
+ * @brief Header at the start of a binary matrix file
+ *
+ * Binary matrix file format
+ * ```
+ * "FRANKMAT"            8 bytes
+ * n_rows                int64_t
+ * n_cols                int64_t
+ * layout                int64_t, 0 for row major and 1 for column major
+ * a11 a12 ... amn       n_rows*n_cols doubles in the given layout
+ * ```
+ * All values are stored in native byte order. Since the header is 32 bytes
+ * long, the elements are aligned when the file is memory-mapped.
+ */
+struct MatrixFileHeader {
+  /**
+   * @brief Identifies the file as binary matrix file
+   */
+  char magic[8];
+  /**
+   * @brief Number of rows of the matrix
+   */
+  int64_t n_rows;
+  /**
+   * @brief Number of columns of the matrix
+   */
+  int64_t n_cols;
+  /**
+   * @brief Ordering of the elements, 0 for row major and 1 for column major
+   */
+  int64_t layout;
+
+  /**
+   * @brief Create a header for a matrix of the given size
+   */
+  MatrixFileHeader(
+    const int64_t n_rows, const int64_t n_cols, const MatrixLayout ordering
+  );
+
+  /**
+   * @brief Check whether the header was read from a binary matrix file
+   *
+   * @return bool
+   * True if the magic string matches and the layout is valid.
+   */
+  bool is_valid() const;
+
+  /**
+   * @brief Get the ordering of the elements
+   */
+  MatrixLayout get_layout() const;
+};
+
+/**
+ * @brief Write a `Dense` matrix to a binary matrix file
+ *
+ * @param A
+ * Matrix to be written.
+ * @param filename
+ * Path to the file. Existing files are overwritten.
+ * @param ordering
+ * Ordering of the elements within the file.
+ *
+ * The file can be read with the `Dense` and `Hierarchical` file constructors,
+ * see `MatrixFileHeader` for the format.
+ */
+void write_matrix_file(
+  const Dense& A, const std::string filename,
+  const MatrixLayout ordering=MatrixLayout::RowMajor
+);
+
+/**
+ * @brief Convert a text matrix file to a binary matrix file
+ *
+ * @param text_filename
+ * Path to the text file, a line with the number of rows and columns followed
+ * by the elements separated by white space.
+ * @param binary_filename
+ * Path to the binary file. Existing files are overwritten.
+ * @param ordering
+ * Ordering of the elements within the text file, which is kept in the binary
+ * file.
+ *
+ * The text file is parsed once from start to end and the elements are
+ * streamed to the binary file, so that the matrix does not need to fit into
+ * memory.
+ */
+void convert_matrix_file(
+  const std::string text_filename, const std::string binary_filename,
+  const MatrixLayout ordering
+);
+
+} // namespace FRANK
+
+#endif // FRANK_util_matrix_file_h
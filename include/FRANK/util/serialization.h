@@ -0,0 +1,211 @@
+/**
+ * @file serialization.h
+ * @brief Include functions for storing matrices in a compact binary format and
+ * loading them back.
+ *
+ * @copyright Copyright (c) 2020
+ */
+#ifndef FRANK_util_serialization_h
+#define FRANK_util_serialization_h
+
+#include "FRANK/definitions.h"
+#include "FRANK/classes/matrix_proxy.h"
+
+#include <cstdint>
+#include <string>
+#include <tuple>
+#include <vector>
+
+
+namespace FRANK
+{
+
+class Matrix;
+
+/**
+ * @brief Append the binary representation of a matrix to a buffer
+ *
+ * @param A
+ * `Dense`, `LowRank`, `Hierarchical` or `Empty` matrix. `Hierarchical`
+ * matrices are stored recursively with all their blocks.
+ * @param buffer
+ * Buffer to which the representation is appended.
+ *
+ * The representation holds the block structure followed by the raw elements of
+ * each `Dense` matrix in row-major order. Numbers are stored in native byte
+ * order as 8 byte values, so elements stay aligned in a memory-mapped file.
+ */
+void serialize(const Matrix& A, std::vector<char>& buffer);
+
+/**
+ * @brief Reconstruct a matrix from its binary representation
+ *
+ * @param position
+ * Start of the representation written by serialize(). Moved past its end.
+ * @return MatrixProxy
+ * Copy of the serialized matrix.
+ */
+MatrixProxy deserialize(const char*& position);
+
+/**
+ * @brief Write a matrix to a binary file
+ *
+ * @param A
+ * Matrix to be written, see serialize().
+ * @param filename
+ * Path to the file. Existing files are replaced.
+ * @param checksum
+ * If true, a checksum of the data is stored, which load() can verify.
+ *
+ * Unlike write_JSON(), the file contains all data of the matrix, so that an
+ * expensive compression or factorization does not need to be repeated.
+ */
+void save(const Matrix& A, const std::string filename, const bool checksum=true);
+
+/**
+ * @brief Load a matrix written by save() without copying its elements
+ *
+ * @param filename
+ * Path to the file.
+ * @param verify
+ * If true, the checksum stored by save() is verified. This reads the whole
+ * file.
+ * @return MatrixProxy
+ * The matrix, with the same structure as the matrix that was saved.
+ *
+ * The file is memory-mapped privately and every `Dense` matrix (including the
+ * bases of `LowRank` matrices) is a view into the mapping, so that loading
+ * only reconstructs the block structure and pages are read on first access.
+ * The matrices can be modified; modified pages are copied in memory and never
+ * written back to the file.
+ *
+ * Missing, truncated or corrupt files are fatal errors.
+ */
+MatrixProxy load(const std::string filename, const bool verify=false);
+
+/**
+ * @brief Write several matrices and the progress of an algorithm to a file
+ *
+ * @param matrices
+ * Matrices to be written.
+ * @param step
+ * Number of completed steps of the algorithm writing the checkpoint.
+ * @param filename
+ * Path to the file.
+ * @param checksum
+ * If true, a checksum of the data is stored.
+ * @param fingerprint
+ * Identifies the input the checkpoint was computed from, usually obtained
+ * with fingerprint(). Read back with checkpoint_fingerprint().
+ *
+ * The file is written under a temporary name and then renamed, so that an
+ * interruption never leaves a partially written checkpoint behind. Matrices
+ * loaded from a previous checkpoint of the same name stay valid.
+ */
+void save_checkpoint(
+  const std::vector<const Matrix*>& matrices, const int64_t step,
+  const std::string filename, const bool checksum=true,
+  const uint64_t fingerprint=0
+);
+
+/**
+ * @brief Read the fingerprint stored by save_checkpoint()
+ *
+ * @param filename
+ * Path to the file.
+ * @return uint64_t
+ * Fingerprint passed to save_checkpoint(), zero if the file does not exist or
+ * is not a matrix file.
+ *
+ * Only the header of the file is read, so that a checkpoint written for a
+ * different input can be detected before it is loaded.
+ */
+uint64_t checkpoint_fingerprint(const std::string filename);
+
+/**
+ * @brief Compute a fingerprint of the contents of a matrix
+ *
+ * @param A
+ * Matrix built from `Dense`, `LowRank`, `Empty` and `Hierarchical` blocks.
+ * @return uint64_t
+ * 64 bit FNV-1a hash of the serialized matrix, which equals the checksum
+ * save() stores for \p A.
+ *
+ * Reads every element of \p A once without building the serialized matrix
+ * in memory. Used to tie checkpoints to the matrix they were computed from.
+ */
+uint64_t fingerprint(const Matrix& A);
+
+/**
+ * @brief Load matrices written by save_checkpoint()
+ *
+ * @param filename
+ * Path to the file.
+ * @param verify
+ * If true, the checksum is verified.
+ * @return std::tuple<std::vector<MatrixProxy>, int64_t>
+ * Matrices in the order they were saved, see load(), and the number of
+ * completed steps. No matrices and zero steps if the file does not exist.
+ */
+std::tuple<std::vector<MatrixProxy>, int64_t> load_checkpoint(
+  const std::string filename, const bool verify=false
+);
+
+/**
+ * @brief Publish matrices in a POSIX shared memory object
+ *
+ * @param matrices
+ * Matrices to be published, for example a compressed operator or its `L` and
+ * `U` factors.
+ * @param name
+ * Name of the object as passed to `shm_open()`, starting with a slash. An
+ * existing object of the same name is replaced; processes attached to it keep
+ * the old matrices.
+ * @param checksum
+ * If true, a checksum of the data is stored, which attach() can verify.
+ *
+ * The matrices are stored in the same format as by save_checkpoint(). The
+ * object stays in memory until unpublish() is called or the system is
+ * restarted, even after the publishing process exits. Attaching while the
+ * object is being written is an error, so publish before starting the
+ * processes that attach.
+ */
+void publish(
+  const std::vector<const Matrix*>& matrices, const std::string name,
+  const bool checksum=true
+);
+
+/**
+ * @brief Attach to matrices published with publish()
+ *
+ * @param name
+ * Name passed to publish().
+ * @param verify
+ * If true, the checksum is verified. This reads the whole object.
+ * @return std::vector<MatrixProxy>
+ * Matrices in the order they were published.
+ *
+ * As with load(), every `Dense` matrix is a view into a copy-on-write mapping
+ * of the object. As long as the matrices are only read, for example in gemm()
+ * for matrix-vector products or in trsm() for solves with published factors,
+ * all processes attached to the same object use a single copy of the data in
+ * physical memory. The matrices may also be modified: each page that is
+ * written is copied first, so changes are private to the matrices returned by
+ * this call and never reach the object or other processes.
+ */
+std::vector<MatrixProxy> attach(const std::string name, const bool verify=false);
+
+/**
+ * @brief Remove a shared memory object created by publish()
+ *
+ * @param name
+ * Name passed to publish().
+ *
+ * Processes that are attached keep their mappings until they release the
+ * matrices.
+ */
+void unpublish(const std::string name);
+
+} // namespace FRANK
+
+#endif // FRANK_util_serialization_h
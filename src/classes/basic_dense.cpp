@@ -0,0 +1,50 @@
+#include "FRANK/classes/basic_dense.h"
+
+#include "FRANK/classes/dense.h"
+
+#include <cassert>
+#include <complex>
+#include <cstdint>
+
+
+namespace FRANK
+{
+
+template<typename T>
+BasicDense<T>::BasicDense(const int64_t n_rows, const int64_t n_cols)
+: dim{n_rows, n_cols}, stride(n_cols), data(n_rows*n_cols, T(0)) {}
+
+template<typename T>
+BasicDense<T>::BasicDense(const Dense& A) : BasicDense(A.dim[0], A.dim[1]) {
+  for (int64_t i=0; i<dim[0]; i++) {
+    for (int64_t j=0; j<dim[1]; j++) {
+      (*this)(i, j) = static_cast<T>(A(i, j));
+    }
+  }
+}
+
+template<typename T>
+T& BasicDense<T>::operator()(const int64_t i, const int64_t j) {
+  assert(i < dim[0]);
+  assert(j < dim[1]);
+  return data[i*stride+j];
+}
+
+template<typename T>
+const T& BasicDense<T>::operator()(const int64_t i, const int64_t j) const {
+  assert(i < dim[0]);
+  assert(j < dim[1]);
+  return data[i*stride+j];
+}
+
+template<typename T>
+T* BasicDense<T>::operator&() { return data.data(); }
+
+template<typename T>
+const T* BasicDense<T>::operator&() const { return data.data(); }
+
+template class BasicDense<float>;
+template class BasicDense<std::complex<float>>;
+template class BasicDense<std::complex<double>>;
+
+} // namespace FRANK
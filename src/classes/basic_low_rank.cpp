@@ -0,0 +1,114 @@
+#include "FRANK/classes/basic_low_rank.h"
+
+#include "FRANK/classes/basic_dense.h"
+
+#ifdef USE_MKL
+#include <mkl.h>
+#else
+#include <lapacke.h>
+#endif
+
+#include <algorithm>
+#include <cmath>
+#include <complex>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+
+namespace FRANK
+{
+
+// Scalar type specific LAPACK routines for BasicLowRank. A is overwritten.
+void basic_gesvd(
+  const int64_t m, const int64_t n, float* A, const int64_t lda,
+  float* S, float* U, const int64_t ldu, float* VT, const int64_t ldvt,
+  float* superb
+) {
+  LAPACKE_sgesvd(
+    LAPACK_ROW_MAJOR, 'S', 'S', m, n, A, lda, S, U, ldu, VT, ldvt, superb
+  );
+}
+
+void basic_gesvd(
+  const int64_t m, const int64_t n, std::complex<float>* A, const int64_t lda,
+  float* S, std::complex<float>* U, const int64_t ldu,
+  std::complex<float>* VT, const int64_t ldvt, float* superb
+) {
+  LAPACKE_cgesvd(
+    LAPACK_ROW_MAJOR, 'S', 'S', m, n,
+    reinterpret_cast<lapack_complex_float*>(A), lda, S,
+    reinterpret_cast<lapack_complex_float*>(U), ldu,
+    reinterpret_cast<lapack_complex_float*>(VT), ldvt, superb
+  );
+}
+
+void basic_gesvd(
+  const int64_t m, const int64_t n, std::complex<double>* A, const int64_t lda,
+  double* S, std::complex<double>* U, const int64_t ldu,
+  std::complex<double>* VT, const int64_t ldvt, double* superb
+) {
+  LAPACKE_zgesvd(
+    LAPACK_ROW_MAJOR, 'S', 'S', m, n,
+    reinterpret_cast<lapack_complex_double*>(A), lda, S,
+    reinterpret_cast<lapack_complex_double*>(U), ldu,
+    reinterpret_cast<lapack_complex_double*>(VT), ldvt, superb
+  );
+}
+
+// Truncated SVD of A. If eps is positive, the rank is chosen so that the
+// discarded singular values add up to at most eps times the norm of A. Empty
+// matrices yield an empty factorization of rank 0.
+template<typename T>
+BasicLowRank<T> truncated_svd(
+  const BasicDense<T>& A, const int64_t max_rank, const double eps
+) {
+  using real_type = decltype(std::abs(T()));
+  const int64_t m = A.dim[0], n = A.dim[1], k = std::min(m, n);
+  if (k == 0) {
+    return BasicLowRank<T>(BasicDense<T>(m, 0), BasicDense<T>(0, 0), BasicDense<T>(0, n));
+  }
+  BasicDense<T> A_copy(A), U(m, k), VT(k, n);
+  std::vector<real_type> s(k), superb(std::max<int64_t>(1, k-1));
+  basic_gesvd(
+    m, n, &A_copy, A_copy.stride, s.data(), &U, U.stride, &VT, VT.stride,
+    superb.data()
+  );
+  int64_t rank = std::max<int64_t>(1, std::min(max_rank, k));
+  if (eps > 0) {
+    // tail[r] is the squared error of truncating to rank r
+    std::vector<double> tail(k+1, 0);
+    for (int64_t i=k-1; i>=0; --i) tail[i] = tail[i+1] + double(s[i])*s[i];
+    rank = 1;
+    while (rank < k && tail[rank] > eps*eps*tail[0]) ++rank;
+  }
+  BasicDense<T> U_r(m, rank), S_r(rank, rank), V_r(rank, n);
+  for (int64_t i=0; i<m; ++i) {
+    std::copy(&U + i*U.stride, &U + i*U.stride + rank, &U_r + i*U_r.stride);
+  }
+  for (int64_t i=0; i<rank; ++i) S_r(i, i) = T(s[i]);
+  std::copy(&VT, &VT + rank*VT.stride, &V_r);
+  return BasicLowRank<T>(std::move(U_r), std::move(S_r), std::move(V_r));
+}
+
+template<typename T>
+BasicLowRank<T>::BasicLowRank(const BasicDense<T>& A, const int64_t rank)
+: BasicLowRank(truncated_svd(A, rank, 0)) {}
+
+template<typename T>
+BasicLowRank<T>::BasicLowRank(const BasicDense<T>& A, const double eps)
+: BasicLowRank(truncated_svd(A, std::min(A.dim[0], A.dim[1]), eps)) {
+  this->eps = eps;
+}
+
+template<typename T>
+BasicLowRank<T>::BasicLowRank(
+  BasicDense<T>&& U, BasicDense<T>&& S, BasicDense<T>&& V
+) : dim{U.dim[0], V.dim[1]}, rank(S.dim[0]),
+    U(std::move(U)), S(std::move(S)), V(std::move(V)) {}
+
+template class BasicLowRank<float>;
+template class BasicLowRank<std::complex<float>>;
+template class BasicLowRank<std::complex<double>>;
+
+} // namespace FRANK
@@ -1,24 +1,34 @@
 #include "FRANK/classes/dense.h"
 
+#include "FRANK/classes/basic_dense.h"
+#include "FRANK/classes/diagonal.h"
 #include "FRANK/classes/empty.h"
 #include "FRANK/classes/hierarchical.h"
+#include "FRANK/classes/identity.h"
 #include "FRANK/classes/low_rank.h"
 #include "FRANK/classes/matrix.h"
+#include "FRANK/classes/mixed_precision_low_rank.h"
+#include "FRANK/classes/matrix_product.h"
 #include "FRANK/classes/matrix_proxy.h"
 #include "FRANK/classes/initialization_helpers/index_range.h"
 #include "FRANK/classes/initialization_helpers/matrix_initializer_file.h"
+#include "FRANK/operations/arithmetic.h"
 #include "FRANK/operations/BLAS.h"
 #include "FRANK/operations/misc.h"
 #include "FRANK/util/omm_error_handler.h"
 #include "FRANK/util/print.h"
+#include "FRANK/util/mapped_file.h"
 #include "FRANK/util/timer.h"
 
 #include "yorel/yomm2/cute.hpp"
 using yorel::yomm2::virtual_;
 
+#include <algorithm>
+#include <atomic>
 #include <cassert>
 #include <cstdint>
 #include <cstdlib>
+#include <string>
 #include <utility>
 #include <vector>
 
@@ -26,7 +36,8 @@ using yorel::yomm2::virtual_;
 namespace FRANK
 {
 
-uint64_t next_unique_id = 0;
+// Atomic since blocks may be created by the I/O thread of OutOfCoreHierarchical
+std::atomic<uint64_t> next_unique_id = 0;
 
 declare_method(
   void, fill_dense_from, (virtual_<const Matrix&>, virtual_<Matrix&>)
@@ -43,11 +54,19 @@ Dense::Dense(const Dense& A)
 
 Dense& Dense::operator=(const Dense& A) {
   Matrix::operator=(A);
+  // Buffers shared with other instances (including A) must not be written to
+  const bool reuse = (
+    (mapping ? mapping.use_count() : data.use_count()) == 1
+    && dim == A.dim && !is_submatrix()
+  );
   dim = A.dim;
-  stride = A.stride;
-  data = std::make_shared<std::vector<double>>(dim[0]*dim[1], 0);
+  if (!reuse) {
+    data = std::make_shared<std::vector<double>>(dim[0]*dim[1], 0);
+    mapping.reset();
+    stride = dim[1];
+  }
   rel_start = {0, 0};
-  data_ptr = (*data).data();
+  data_ptr = mapping ? mapping->data() : (*data).data();
   fill_dense_from(A, *this);
   unique_id = next_unique_id++;
   return *this;
@@ -71,7 +90,11 @@ define_method(void, fill_dense_from, (const Hierarchical& A, Dense& B)) {
 }
 
 define_method(void, fill_dense_from, (const LowRank& A, Dense& B)) {
-  gemm(gemm(A.U, A.S), A.V, B, 1, 0);
+  (A.U * A.S * A.V).evaluate(B, 1, 0);
+}
+
+define_method(void, fill_dense_from, (const MixedPrecisionLowRank& A, Dense& B)) {
+  fill_dense_from(A.decompress(), B);
 }
 
 define_method(void, fill_dense_from, (const Dense& A, Dense& B)) {
@@ -80,12 +103,36 @@ define_method(void, fill_dense_from, (const Dense& A, Dense& B)) {
   A.copy_to(B);
 }
 
+define_method(void, fill_dense_from, (const SDense& A, Dense& B)) {
+  assert(A.dim[0] == B.dim[0]);
+  assert(A.dim[1] == B.dim[1]);
+  for (int64_t i=0; i<B.dim[0]; i++) {
+    for (int64_t j=0; j<B.dim[1]; j++) {
+      B(i, j) = A(i, j);
+    }
+  }
+}
+
 define_method(void, fill_dense_from, ([[maybe_unused]] const Empty& A, Dense& B)) {
   assert(A.dim[0] == B.dim[0]);
   assert(A.dim[1] == B.dim[1]);
   B = 0.0;
 }
 
+define_method(void, fill_dense_from, ([[maybe_unused]] const Identity& A, Dense& B)) {
+  assert(A.dim[0] == B.dim[0]);
+  assert(A.dim[1] == B.dim[1]);
+  B = 0.0;
+  for (int64_t i=0; i<B.dim[0]; i++) B(i, i) = 1;
+}
+
+define_method(void, fill_dense_from, (const Diagonal& A, Dense& B)) {
+  assert(A.dim[0] == B.dim[0]);
+  assert(A.dim[1] == B.dim[1]);
+  B = 0.0;
+  for (int64_t i=0; i<B.dim[0]; i++) B(i, i) = A.diag[i];
+}
+
 define_method(void, fill_dense_from, (const Matrix& A, Matrix& B)) {
   omm_error_handler("fill_dense_from", {A, B}, __FILE__, __LINE__);
   std::abort();
@@ -112,6 +159,21 @@ Dense::Dense(const int64_t n_rows, const int64_t n_cols)
   data_ptr = (*data).data();
 }
 
+Dense::Dense(
+  const int64_t n_rows, const int64_t n_cols, const std::string& filename,
+  const MemoryAccess access
+) : dim{n_rows, n_cols}, unique_id(next_unique_id++) {
+  mapping = std::make_shared<MappedFile>(n_rows, n_cols, filename);
+  stride = mapping->stride;
+  rel_start = {0, 0};
+  data_ptr = mapping->data();
+  advise(access);
+}
+
+Dense::Dense(const std::shared_ptr<MappedFile>& mapping)
+: dim(mapping->dim), stride(mapping->stride), mapping(mapping),
+  rel_start{0, 0}, data_ptr(mapping->data()), unique_id(next_unique_id++) {}
+
 Dense::Dense(
   void (*kernel)(
     double* A, const uint64_t A_rows, const uint64_t A_cols, const uint64_t A_stride,
@@ -195,11 +257,34 @@ double* Dense::operator&() { return data_ptr; }
 
 const double* Dense::operator&() const { return data_ptr; }
 
+void Dense::truncate(const int64_t n_rows, const int64_t n_cols) {
+  assert(n_rows <= dim[0]);
+  assert(n_cols <= dim[1]);
+  // The file backing a mapped matrix cannot shrink below its row stride
+  if (mapping || data.use_count() != 1 || is_submatrix()) {
+    Dense truncated(n_rows, n_cols);
+    copy_to(truncated);
+    *this = std::move(truncated);
+    return;
+  }
+  // Rows only ever move towards the front, so they can be compacted in order
+  if (n_cols != stride) {
+    for (int64_t i=1; i<n_rows; i++) {
+      std::copy(data_ptr+i*stride, data_ptr+i*stride+n_cols, data_ptr+i*n_cols);
+    }
+  }
+  data->resize(n_rows*n_cols);
+  dim = {n_rows, n_cols};
+  stride = n_cols;
+  data_ptr = (*data).data();
+}
+
 Dense Dense::shallow_copy() const {
   Dense out;
   out.dim = dim;
   out.stride = stride;
   out.data = data;
+  out.mapping = mapping;
   out.rel_start = rel_start;
   out.data_ptr = data_ptr;
   out.unique_id = unique_id;
@@ -208,11 +293,22 @@ Dense Dense::shallow_copy() const {
 
 bool Dense::is_submatrix() const {
   bool out = (rel_start == std::array<int64_t, 2>{0, 0});
-  // TODO Think about int64_t!
-  out &= (data->size() == uint64_t(dim[0] * dim[1]));
+  if (mapping) {
+    out &= (dim == mapping->dim);
+  } else {
+    // TODO Think about int64_t!
+    out &= (data->size() == uint64_t(dim[0] * dim[1]));
+  }
   return !out;
 }
 
+bool Dense::is_mapped() const { return bool(mapping); }
+
+void Dense::advise(const MemoryAccess access) const {
+  if (!mapping || dim[0] == 0) return;
+  mapping->advise(data_ptr, (dim[0]-1)*stride + dim[1], access);
+}
+
 uint64_t Dense::id() const { return unique_id; }
 
 std::vector<Dense> Dense::split(
@@ -236,9 +332,12 @@ std::vector<Dense> Dense::split(
         child.dim = {row_ranges[i].n, col_ranges[j].n};
         child.stride = stride;
         child.data = data;
+        child.mapping = mapping;
         child.rel_start[0] = rel_start[0] + row_ranges[i].start;
         child.rel_start[1] = rel_start[1] + col_ranges[j].start;
-        child.data_ptr = (*child.data).data() +
+        child.data_ptr = (
+          mapping ? mapping->data() : (*child.data).data()
+        ) +
           child.rel_start[0]*child.stride + child.rel_start[1];
         child.unique_id = next_unique_id++;
         out[i*col_ranges.size()+j] = std::move(child);
@@ -1,12 +1,16 @@
 #include "FRANK/classes/hierarchical.h"
 
+#include "FRANK/classes/basic_dense.h"
+#include "FRANK/classes/basic_low_rank.h"
 #include "FRANK/classes/dense.h"
+#include "FRANK/classes/empty.h"
 #include "FRANK/classes/low_rank.h"
 #include "FRANK/classes/matrix.h"
 #include "FRANK/classes/matrix_proxy.h"
 #include "FRANK/classes/initialization_helpers/cluster_tree.h"
 #include "FRANK/classes/initialization_helpers/matrix_initializer.h"
 #include "FRANK/classes/initialization_helpers/matrix_initializer_block.h"
+#include "FRANK/classes/initialization_helpers/matrix_initializer_complex_kernel.h"
 #include "FRANK/classes/initialization_helpers/matrix_initializer_kernel.h"
 #include "FRANK/classes/initialization_helpers/matrix_initializer_file.h"
 #include "FRANK/operations/BLAS.h"
@@ -18,9 +22,12 @@
 #include "yorel/yomm2/cute.hpp"
 using yorel::yomm2::virtual_;
 
+#include <algorithm>
 #include <cassert>
+#include <complex>
 #include <cstdint>
 #include <cstdlib>
+#include <string>
 #include <tuple>
 #include <utility>
 #include <vector>
@@ -46,31 +53,115 @@ define_method(Hierarchical&&, move_from_hierarchical, (Matrix& A)) {
 Hierarchical::Hierarchical(const int64_t n_row_blocks, const int64_t n_col_blocks)
 : dim{n_row_blocks, n_col_blocks}, data(dim[0]*dim[1]) {}
 
+MatrixProxy build_block(
+  const ClusterTree& node, const MatrixInitializer& initializer,
+  const bool fixed_rank
+) {
+  if (initializer.is_admissible(node)) {
+    return initializer.get_compressed_representation(node, fixed_rank);
+  } else if (node.is_leaf()) {
+    return initializer.get_dense_representation(node);
+  } else {
+    return Hierarchical(node, initializer, fixed_rank);
+  }
+}
+
 Hierarchical::Hierarchical(
   const ClusterTree& node,
   const MatrixInitializer& initializer,
   const bool fixed_rank
+) : dim(node.block_dim), data(dim[0]*dim[1]) {
+  for (const ClusterTree& child : node) {
+    (*this)[child.rel_pos] = build_block(child, initializer, fixed_rank);
+  }
+}
+
+Hierarchical::Hierarchical(
+  const ClusterTree& node,
+  const MatrixInitializerComplexKernel& initializer,
+  const bool fixed_rank
 ) : dim(node.block_dim), data(dim[0]*dim[1]) {
   for (const ClusterTree& child : node) {
     if (initializer.is_admissible(child)) {
-      (*this)[child.rel_pos] = initializer.get_compressed_representation(child, fixed_rank);
+      (*this)[child.rel_pos] = initializer.get_complex_compressed_representation(
+        child, fixed_rank
+      );
+    } else if (child.is_leaf()) {
+      (*this)[child.rel_pos] = initializer.get_complex_dense_representation(child);
     } else {
-      if (child.is_leaf()) {
-        (*this)[child.rel_pos] = initializer.get_dense_representation(child);
-      } else {
-        (*this)[child.rel_pos] = Hierarchical(child, initializer, fixed_rank);
-      }
+      (*this)[child.rel_pos] = Hierarchical(child, initializer, fixed_rank);
     }
   }
 }
 
+declare_method(
+  MatrixProxy, build_like,
+  (
+    virtual_<const Matrix&>, const ClusterTree&, const MatrixInitializer&,
+    const bool
+  )
+)
+
+Hierarchical::Hierarchical(
+  const ClusterTree& node,
+  const MatrixInitializer& initializer,
+  const Hierarchical& previous,
+  const bool fixed_rank
+) : dim(node.block_dim), data(dim[0]*dim[1]) {
+  assert(previous.dim == dim);
+  for (const ClusterTree& child : node) {
+    (*this)[child.rel_pos] = build_like(
+      previous[child.rel_pos], child, initializer, fixed_rank
+    );
+  }
+}
+
+define_method(
+  MatrixProxy, build_like,
+  (
+    const LowRank& previous, const ClusterTree& node,
+    const MatrixInitializer& initializer, const bool fixed_rank
+  )
+) {
+  if (!initializer.is_admissible(node)) {
+    return build_block(node, initializer, fixed_rank);
+  }
+  return initializer.get_compressed_representation(node, fixed_rank, previous);
+}
+
+define_method(
+  MatrixProxy, build_like,
+  (
+    const Hierarchical& previous, const ClusterTree& node,
+    const MatrixInitializer& initializer, const bool fixed_rank
+  )
+) {
+  if (
+    initializer.is_admissible(node) || node.is_leaf()
+    || previous.dim != node.block_dim
+  ) {
+    return build_block(node, initializer, fixed_rank);
+  }
+  return Hierarchical(node, initializer, previous, fixed_rank);
+}
+
+define_method(
+  MatrixProxy, build_like,
+  (
+    const Matrix&, const ClusterTree& node,
+    const MatrixInitializer& initializer, const bool fixed_rank
+  )
+) {
+  return build_block(node, initializer, fixed_rank);
+}
+
 Hierarchical::Hierarchical(
   void (*kernel)(
     double* A, const uint64_t A_rows, const uint64_t A_cols, const uint64_t A_stride,
     const std::vector<std::vector<double>>& params,
     const int64_t row_start, const int64_t col_start
   ),
-  const std::vector<std::vector<double>> params,
+  const Geometry params,
   const int64_t n_rows, int64_t n_cols,
   const int64_t rank,
   const int64_t nleaf,
@@ -79,10 +170,11 @@ Hierarchical::Hierarchical(
   const AdmisType admis_type,
   const int64_t row_start, const int64_t col_start
 ) {
-  const MatrixInitializerKernel initializer(kernel, params, admis, 0, rank, admis_type);
+  MatrixInitializerKernel initializer(kernel, params, admis, 0, rank, admis_type);
   const ClusterTree cluster_tree(
     {row_start, n_rows}, {col_start, n_cols}, n_row_blocks, n_col_blocks, nleaf
   );
+  initializer.find_admissible_blocks(cluster_tree);
   *this = Hierarchical(cluster_tree, initializer, true);
 }
 
@@ -92,7 +184,32 @@ Hierarchical::Hierarchical(
     const std::vector<std::vector<double>>& params,
     const int64_t row_start, const int64_t col_start
   ),
-  const std::vector<std::vector<double>> params,
+  const Geometry params,
+  const int64_t n_rows, const int64_t n_cols,
+  const int64_t nleaf,
+  const double eps,
+  const double admis,
+  const int64_t n_row_blocks, const int64_t n_col_blocks,
+  const AdmisType admis_type,
+  const int64_t row_start, const int64_t col_start
+) {
+  MatrixInitializerKernel initializer(kernel, params, admis, eps, 0, admis_type);
+  const ClusterTree cluster_tree(
+    {row_start, n_rows}, {col_start, n_cols}, n_row_blocks, n_col_blocks, nleaf
+  );
+  initializer.find_admissible_blocks(cluster_tree);
+  *this = Hierarchical(cluster_tree, initializer, false);
+}
+
+
+Hierarchical::Hierarchical(
+  void (*kernel)(
+    std::complex<double>* A,
+    const uint64_t A_rows, const uint64_t A_cols, const uint64_t A_stride,
+    const std::vector<std::vector<double>>& params,
+    const int64_t row_start, const int64_t col_start
+  ),
+  const Geometry params,
   const int64_t n_rows, const int64_t n_cols,
   const int64_t nleaf,
   const double eps,
@@ -101,10 +218,13 @@ Hierarchical::Hierarchical(
   const AdmisType admis_type,
   const int64_t row_start, const int64_t col_start
 ) {
-  const MatrixInitializerKernel initializer(kernel, params, admis, eps, 0, admis_type);
+  MatrixInitializerComplexKernel initializer(
+    kernel, params, admis, eps, 0, admis_type
+  );
   const ClusterTree cluster_tree(
     {row_start, n_rows}, {col_start, n_cols}, n_row_blocks, n_col_blocks, nleaf
   );
+  initializer.find_admissible_blocks(cluster_tree);
   *this = Hierarchical(cluster_tree, initializer, false);
 }
 
@@ -116,14 +236,15 @@ Hierarchical::Hierarchical(
   const double admis,
   const int64_t n_row_blocks, const int64_t n_col_blocks,
   const int64_t row_start, const int64_t col_start,
-  const std::vector<std::vector<double>> params,
+  const Geometry params,
   const AdmisType admis_type
 ) {
-  const MatrixInitializerBlock initializer(std::move(A), admis, 0, rank, params, admis_type);
+  MatrixInitializerBlock initializer(std::move(A), admis, 0, rank, params, admis_type);
   const ClusterTree cluster_tree(
     {row_start, A.dim[0]}, {col_start, A.dim[1]},
     n_row_blocks, n_col_blocks, nleaf
   );
+  initializer.find_admissible_blocks(cluster_tree);
   *this = Hierarchical(cluster_tree, initializer, true);
 }
 
@@ -134,17 +255,249 @@ Hierarchical::Hierarchical(
   const double admis,
   const int64_t n_row_blocks, const int64_t n_col_blocks,
   const int64_t row_start, const int64_t col_start,
-  const std::vector<std::vector<double>> params,
+  const Geometry params,
   const AdmisType admis_type
 ) {
-  const MatrixInitializerBlock initializer(std::move(A), admis, eps, 0, params, admis_type);
+  MatrixInitializerBlock initializer(std::move(A), admis, eps, 0, params, admis_type);
   const ClusterTree cluster_tree(
     {row_start, A.dim[0]}, {col_start, A.dim[1]},
     n_row_blocks, n_col_blocks, nleaf
   );
+  initializer.find_admissible_blocks(cluster_tree);
+  *this = Hierarchical(cluster_tree, initializer, false);
+}
+
+Hierarchical::Hierarchical(
+  const std::string filename, const MatrixLayout ordering,
+  const int64_t n_rows, const int64_t n_cols,
+  const int64_t rank,
+  const int64_t nleaf,
+  const double admis,
+  const int64_t n_row_blocks, const int64_t n_col_blocks,
+  const int64_t row_start, const int64_t col_start,
+  const Geometry params,
+  const AdmisType admis_type
+) {
+  MatrixInitializerFile initializer(
+    filename, ordering, admis, 0, rank, params, admis_type
+  );
+  const ClusterTree cluster_tree(
+    {row_start, n_rows}, {col_start, n_cols},
+    n_row_blocks, n_col_blocks, nleaf
+  );
+  initializer.find_admissible_blocks(cluster_tree);
+  *this = Hierarchical(cluster_tree, initializer, true);
+}
+
+Hierarchical::Hierarchical(
+  const std::string filename, const MatrixLayout ordering,
+  const int64_t n_rows, const int64_t n_cols,
+  const int64_t nleaf,
+  const double eps,
+  const double admis,
+  const int64_t n_row_blocks, const int64_t n_col_blocks,
+  const int64_t row_start, const int64_t col_start,
+  const Geometry params,
+  const AdmisType admis_type
+) {
+  MatrixInitializerFile initializer(
+    filename, ordering, admis, eps, 0, params, admis_type
+  );
+  const ClusterTree cluster_tree(
+    {row_start, n_rows}, {col_start, n_cols},
+    n_row_blocks, n_col_blocks, nleaf
+  );
+  initializer.find_admissible_blocks(cluster_tree);
   *this = Hierarchical(cluster_tree, initializer, false);
 }
 
+declare_method(
+  MatrixProxy, structure_like,
+  (virtual_<const Matrix&>, const int64_t, const FillType, const int64_t)
+)
+
+Hierarchical::Hierarchical(
+  const Hierarchical& A, const FillType fill, const int64_t rank
+) : Hierarchical(structure_like(A, 0, fill, rank)) {}
+
+// diag_offset is the column offset of the global diagonal within the block,
+// i.e. element (i, i+diag_offset) of the block lies on the global diagonal.
+// Returns the first row and the length of that diagonal piece.
+std::tuple<int64_t, int64_t> diagonal_part(
+  const int64_t n_rows, const int64_t n_cols,
+  const int64_t diag_offset, const FillType fill
+) {
+  if (fill != FillType::Identity) return {0, 0};
+  const int64_t first = std::max<int64_t>(0, -diag_offset);
+  const int64_t last = std::min(n_rows, n_cols-diag_offset);
+  if (last <= first) return {0, 0};
+  return {first, last-first};
+}
+
+define_method(
+  MatrixProxy, structure_like,
+  (
+    const Dense& A, const int64_t diag_offset, const FillType fill,
+    const int64_t
+  )
+) {
+  Dense out(A.dim[0], A.dim[1]);
+  int64_t first, length;
+  std::tie(first, length) = diagonal_part(A.dim[0], A.dim[1], diag_offset, fill);
+  for (int64_t i=first; i<first+length; ++i) {
+    out(i, i+diag_offset) = 1;
+  }
+  return out;
+}
+
+define_method(
+  MatrixProxy, structure_like,
+  (
+    const LowRank& A, const int64_t diag_offset, const FillType fill,
+    const int64_t rank
+  )
+) {
+  int64_t first, length;
+  std::tie(first, length) = diagonal_part(A.dim[0], A.dim[1], diag_offset, fill);
+  const bool on_diagonal = length > 0;
+  const int64_t out_rank = (
+    on_diagonal ? length : std::min(std::min(rank, A.dim[0]), A.dim[1])
+  );
+  const int64_t col_shift = on_diagonal ? diag_offset : 0;
+  // U and V get orthonormal columns and rows respectively. S carries the
+  // content, which is zero unless the block intersects the diagonal.
+  Dense U(A.dim[0], out_rank), S(out_rank, out_rank), V(out_rank, A.dim[1]);
+  for (int64_t k=0; k<out_rank; ++k) {
+    U(first+k, k) = 1;
+    V(k, first+k+col_shift) = 1;
+    if (on_diagonal) S(k, k) = 1;
+  }
+  LowRank out(std::move(U), std::move(S), std::move(V));
+  out.eps = A.eps;
+  return out;
+}
+
+define_method(
+  MatrixProxy, structure_like,
+  (const Empty& A, const int64_t, const FillType, const int64_t)
+) {
+  return Empty(A.dim[0], A.dim[1]);
+}
+
+define_method(
+  MatrixProxy, structure_like,
+  (
+    const Hierarchical& A, const int64_t diag_offset, const FillType fill,
+    const int64_t rank
+  )
+) {
+  Hierarchical out(A.dim[0], A.dim[1]);
+  int64_t row_start = 0;
+  for (int64_t i=0; i<A.dim[0]; ++i) {
+    int64_t col_start = 0;
+    for (int64_t j=0; j<A.dim[1]; ++j) {
+      out(i, j) = structure_like(
+        A(i, j), diag_offset+row_start-col_start, fill, rank
+      );
+      col_start += get_n_cols(A(i, j));
+    }
+    row_start += get_n_rows(A(i, 0));
+  }
+  return out;
+}
+
+define_method(
+  MatrixProxy, structure_like,
+  (const Matrix& A, const int64_t, const FillType, const int64_t)
+) {
+  omm_error_handler("structure_like", {A}, __FILE__, __LINE__);
+  std::abort();
+}
+
+bool contains_any(
+  const IndexRange& range, const std::vector<int64_t>& sorted_indices
+) {
+  const auto first = std::lower_bound(
+    sorted_indices.begin(), sorted_indices.end(), range.start
+  );
+  return first != sorted_indices.end() && *first < range.start+range.n;
+}
+
+declare_method(
+  void, update_block,
+  (
+    virtual_<Matrix&>, const ClusterTree&, const MatrixInitializer&,
+    const std::vector<int64_t>&, const bool, UpdateStatistics&
+  )
+)
+
+UpdateStatistics update_points(
+  Hierarchical& A, const ClusterTree& node,
+  const MatrixInitializer& initializer,
+  std::vector<int64_t> changed, const bool fixed_rank
+) {
+  std::sort(changed.begin(), changed.end());
+  UpdateStatistics statistics;
+  statistics.n_elements = node.rows.n * node.cols.n;
+  update_block(A, node, initializer, changed, fixed_rank, statistics);
+  return statistics;
+}
+
+define_method(
+  void, update_block,
+  (
+    Hierarchical& A, const ClusterTree& node,
+    const MatrixInitializer& initializer, const std::vector<int64_t>& changed,
+    const bool fixed_rank, UpdateStatistics& statistics
+  )
+) {
+  assert(A.dim == node.block_dim);
+  for (const ClusterTree& child : node) {
+    if (contains_any(child.rows, changed) || contains_any(child.cols, changed)) {
+      update_block(
+        A[child.rel_pos], child, initializer, changed, fixed_rank, statistics
+      );
+    }
+  }
+}
+
+define_method(
+  void, update_block,
+  (
+    Dense& A, const ClusterTree& node,
+    const MatrixInitializer& initializer, const std::vector<int64_t>&,
+    const bool, UpdateStatistics& statistics
+  )
+) {
+  initializer.fill_dense_representation(A, node.rows, node.cols);
+  statistics.n_dense++;
+  statistics.n_rebuilt_elements += A.dim[0] * A.dim[1];
+}
+
+define_method(
+  void, update_block,
+  (
+    LowRank& A, const ClusterTree& node,
+    const MatrixInitializer& initializer, const std::vector<int64_t>&,
+    const bool fixed_rank, UpdateStatistics& statistics
+  )
+) {
+  A = initializer.get_compressed_representation(node, fixed_rank, A);
+  statistics.n_low_rank++;
+  statistics.n_rebuilt_elements += A.dim[0] * A.dim[1];
+}
+
+define_method(
+  void, update_block,
+  (
+    Matrix& A, const ClusterTree&, const MatrixInitializer&,
+    const std::vector<int64_t>&, const bool, UpdateStatistics&
+  )
+) {
+  omm_error_handler("update_block", {A}, __FILE__, __LINE__);
+  std::abort();
+}
+
 const MatrixProxy& Hierarchical::operator[](
   const std::array<int64_t, 2>& pos
 ) const {
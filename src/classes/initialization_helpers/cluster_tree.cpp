@@ -3,6 +3,7 @@
 #include "FRANK/classes/hierarchical.h"
 #include "FRANK/operations/misc.h"
 
+#include <algorithm>
 #include <cmath>
 #include <cstdint>
 #include <functional>
@@ -44,6 +45,47 @@ ClusterTree::ClusterTree(
   }
 }
 
+ClusterTree::ClusterTree(
+  const IndexTree& row_tree, const IndexTree& col_tree,
+  const int64_t level,
+  const int64_t i_rel, const int64_t j_rel,
+  const int64_t i_abs, const int64_t j_abs,
+  ClusterTree* parent
+) : rows(row_tree.range), cols(col_tree.range),
+    block_dim{
+      std::max<int64_t>(row_tree.children.size(), 1),
+      std::max<int64_t>(col_tree.children.size(), 1)
+    },
+    nleaf(
+      parent == nullptr
+      ? std::max(row_tree.max_leaf_size(), col_tree.max_leaf_size())
+      : parent->nleaf
+    ),
+    level(level), rel_pos{i_rel, j_rel}, abs_pos{i_abs, j_abs}, parent(parent)
+{
+  if (parent == nullptr || !is_leaf()) {
+    children.reserve(block_dim[0]*block_dim[1]);
+    for (int64_t i=0; i<block_dim[0]; ++i) {
+      const IndexTree& row_child = (
+        row_tree.is_leaf() ? row_tree : row_tree.children[i]
+      );
+      const int64_t child_i_abs = abs_pos[0]*block_dim[0] + i;
+      for (int64_t j=0; j<block_dim[1]; ++j) {
+        const IndexTree& col_child = (
+          col_tree.is_leaf() ? col_tree : col_tree.children[j]
+        );
+        const int64_t child_j_abs = abs_pos[1]*block_dim[1] + j;
+        children.emplace_back(
+          row_child, col_child,
+          level+1,
+          i, j, child_i_abs, child_j_abs,
+          this
+        );
+      }
+    }
+  }
+}
+
 std::vector<ClusterTree>::iterator ClusterTree::begin() {
   return children.begin();
 }
@@ -0,0 +1,36 @@
+#include "FRANK/classes/initialization_helpers/geometry.h"
+
+#include <cstdint>
+#include <memory>
+#include <utility>
+#include <vector>
+
+
+namespace FRANK
+{
+
+Geometry::Geometry()
+: points(std::make_shared<const std::vector<std::vector<double>>>()) {}
+
+Geometry::Geometry(std::vector<std::vector<double>> coords)
+: points(
+  std::make_shared<const std::vector<std::vector<double>>>(std::move(coords))
+) {}
+
+const std::vector<std::vector<double>>& Geometry::coords() const {
+  return *points;
+}
+
+Geometry::operator const std::vector<std::vector<double>>&() const {
+  return *points;
+}
+
+int64_t Geometry::dim() const {
+  return points->size();
+}
+
+int64_t Geometry::n_points() const {
+  return points->empty() ? 0 : (*points)[0].size();
+}
+
+} // namespace FRANK
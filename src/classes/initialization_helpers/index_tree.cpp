@@ -0,0 +1,167 @@
+#include "FRANK/classes/initialization_helpers/index_tree.h"
+
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <cstdint>
+#include <numeric>
+#include <utility>
+#include <vector>
+
+
+namespace FRANK
+{
+
+IndexTree::IndexTree(const IndexRange range) : range(range) {}
+
+bool IndexTree::is_leaf() const {
+  return children.empty();
+}
+
+int64_t IndexTree::depth() const {
+  int64_t child_depth = -1;
+  for (const IndexTree& child : children) {
+    child_depth = std::max(child_depth, child.depth());
+  }
+  return child_depth + 1;
+}
+
+int64_t IndexTree::max_leaf_size() const {
+  if (is_leaf()) return range.n;
+  int64_t size = 0;
+  for (const IndexTree& child : children) {
+    size = std::max(size, child.max_leaf_size());
+  }
+  return size;
+}
+
+std::vector<double> longest_axis(
+  const std::vector<std::vector<double>>& x,
+  const std::vector<int64_t>& perm, const IndexRange& range
+) {
+  size_t longest = 0;
+  double max_extent = -1;
+  for (size_t d=0; d<x.size(); ++d) {
+    double min_coord = x[d][perm[range.start]];
+    double max_coord = min_coord;
+    for (int64_t i=range.start; i<range.start+range.n; ++i) {
+      min_coord = std::min(min_coord, x[d][perm[i]]);
+      max_coord = std::max(max_coord, x[d][perm[i]]);
+    }
+    if (max_coord - min_coord > max_extent) {
+      max_extent = max_coord - min_coord;
+      longest = d;
+    }
+  }
+  std::vector<double> direction(x.size(), 0);
+  direction[longest] = 1;
+  return direction;
+}
+
+std::vector<double> principal_axis(
+  const std::vector<std::vector<double>>& x,
+  const std::vector<int64_t>& perm, const IndexRange& range
+) {
+  const size_t dim = x.size();
+  std::vector<double> center(dim, 0);
+  for (size_t d=0; d<dim; ++d) {
+    for (int64_t i=range.start; i<range.start+range.n; ++i) {
+      center[d] += x[d][perm[i]];
+    }
+    center[d] /= range.n;
+  }
+  std::vector<double> covariance(dim*dim, 0);
+  for (int64_t i=range.start; i<range.start+range.n; ++i) {
+    for (size_t d=0; d<dim; ++d) {
+      for (size_t e=0; e<dim; ++e) {
+        covariance[d*dim+e] += (
+          (x[d][perm[i]] - center[d]) * (x[e][perm[i]] - center[e])
+        );
+      }
+    }
+  }
+  // Power iteration, starting from the longest axis so that degenerate
+  // distributions fall back to a k-d split
+  std::vector<double> direction = longest_axis(x, perm, range);
+  for (int64_t iteration=0; iteration<64; ++iteration) {
+    std::vector<double> next(dim, 0);
+    for (size_t d=0; d<dim; ++d) {
+      for (size_t e=0; e<dim; ++e) {
+        next[d] += covariance[d*dim+e] * direction[e];
+      }
+    }
+    const double norm = std::sqrt(
+      std::inner_product(next.begin(), next.end(), next.begin(), 0.0)
+    );
+    if (norm == 0) break;
+    double change = 0;
+    for (size_t d=0; d<dim; ++d) {
+      next[d] /= norm;
+      change = std::max(change, std::fabs(next[d] - direction[d]));
+    }
+    direction = std::move(next);
+    if (change < 1e-12) break;
+  }
+  return direction;
+}
+
+void bisect(
+  const std::vector<std::vector<double>>& x, std::vector<int64_t>& perm,
+  IndexTree& node, const int64_t n_levels, const BisectionType type
+) {
+  const IndexRange& range = node.range;
+  if (n_levels == 0 || range.n < 2) return;
+  const std::vector<double> direction = (
+    type == BisectionType::LongestAxis
+    ? longest_axis(x, perm, range) : principal_axis(x, perm, range)
+  );
+  std::vector<std::pair<double, int64_t>> projected(range.n);
+  for (int64_t i=0; i<range.n; ++i) {
+    const int64_t point = perm[range.start+i];
+    double position = 0;
+    for (size_t d=0; d<x.size(); ++d) {
+      position += direction[d] * x[d][point];
+    }
+    projected[i] = {position, point};
+  }
+  // Split at the same position as IndexRange::split(), so that operations
+  // splitting other operands uniformly stay consistent with the tree
+  const int64_t split = (range.n + 1) / 2;
+  std::nth_element(projected.begin(), projected.begin()+split, projected.end());
+  for (int64_t i=0; i<range.n; ++i) {
+    perm[range.start+i] = projected[i].second;
+  }
+  node.children = {
+    IndexTree({range.start, split}),
+    IndexTree({range.start+split, range.n-split})
+  };
+  for (IndexTree& child : node.children) {
+    bisect(x, perm, child, n_levels-1, type);
+  }
+}
+
+IndexTree geometric_bisection(
+  std::vector<std::vector<double>>& x, std::vector<int64_t>& perm,
+  const int64_t nleaf, const BisectionType type
+) {
+  assert(!x.empty());
+  assert(nleaf > 0);
+  const int64_t n_points = x[0].size();
+  perm.resize(n_points);
+  std::iota(perm.begin(), perm.end(), 0);
+  // Split all clusters to the same depth, like ClusterTree does for uniform
+  // splits, so that the leaves of both index trees are reached together
+  int64_t n_levels = 0;
+  for (int64_t size=n_points; size>nleaf; size=(size+1)/2) n_levels++;
+  IndexTree root({0, n_points});
+  bisect(x, perm, root, n_levels, type);
+  const std::vector<std::vector<double>> x_copy(x);
+  for (int64_t i=0; i<n_points; ++i) {
+    for (size_t d=0; d<x.size(); ++d) {
+      x[d][i] = x_copy[d][perm[i]];
+    }
+  }
+  return root;
+}
+
+} // namespace FRANK
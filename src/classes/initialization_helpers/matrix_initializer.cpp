@@ -6,12 +6,16 @@
 #include "FRANK/classes/initialization_helpers/cluster_tree.h"
 #include "FRANK/functions.h"
 #include "FRANK/operations/BLAS.h"
+#include "FRANK/operations/LAPACK.h"
 #include "FRANK/operations/misc.h"
 #include "FRANK/operations/randomized_factorizations.h"
 
 #include <algorithm>
 #include <cassert>
+#include <array>
 #include <cstdint>
+#include <thread>
+#include <tuple>
 #include <utility>
 #include <cmath>
 
@@ -21,7 +25,7 @@ namespace FRANK
 
 MatrixInitializer::MatrixInitializer(
   const double admis, const double eps, const int64_t rank,
-  const std::vector<std::vector<double>> params, const AdmisType admis_type
+  const Geometry params, const AdmisType admis_type
 ) : admis(admis), eps(eps), rank(rank),
     params(params), admis_type(admis_type) {}
 
@@ -41,11 +45,166 @@ LowRank MatrixInitializer::get_compressed_representation(
   else return LowRank(get_dense_representation(node), eps);
 }
 
-std::vector<std::vector<double>> MatrixInitializer::get_coords_range(const IndexRange& range) const {
-  std::vector<std::vector<double>> coords_range;
-  for(size_t d=0; d<params.size(); d++)
-    coords_range.push_back(std::vector<double>(params[d].begin()+range.start, params[d].begin()+range.start+range.n));
-  return coords_range;
+// Squared norms of the columns of A - Q*B, computed one row at a time so that
+// A is read once and the residual is never stored. Also adds up the squared
+// norm of A.
+std::vector<double> residual_col_norms(
+  const Dense& A, const Dense& Q, const Dense& B, double& A_norm
+) {
+  const int64_t n = A.dim[1], k = Q.dim[1];
+  std::vector<double> col_norm(n, 0), row(n);
+  A_norm = 0;
+  for (int64_t i=0; i<A.dim[0]; ++i) {
+    const double* a = &A + i*A.stride;
+    const double* q = &Q + i*Q.stride;
+    for (int64_t j=0; j<n; ++j) A_norm += a[j] * a[j];
+    std::copy(a, a+n, row.begin());
+    for (int64_t l=0; l<k; ++l) {
+      const double* b = &B + l*B.stride;
+      for (int64_t j=0; j<n; ++j) row[j] -= q[l] * b[j];
+    }
+    for (int64_t j=0; j<n; ++j) col_norm[j] += row[j] * row[j];
+  }
+  return col_norm;
+}
+
+LowRank MatrixInitializer::get_compressed_representation(
+  const ClusterTree& node, const bool fixed_rank, const LowRank& previous
+) const {
+  Dense A = get_dense_representation(node);
+  const int64_t k = previous.rank;
+  if (previous.dim != A.dim || (fixed_rank && k < rank)) {
+    return fixed_rank ? LowRank(A, rank) : LowRank(A, eps);
+  }
+  Dense Q(previous.U), B(k, A.dim[1]);
+  // Same criterion as truncated_geqp3(), both for accepting and for truncating
+  // the basis: no column of the error may be larger than eps times the norm of
+  // the block
+  double threshold = 0;
+  std::vector<double> col_norm;
+  // Try the previous basis first, then a single step of subspace iteration
+  // from it. For fixed rank there is no error to check, so the step is always
+  // taken.
+  for (int64_t iteration=0; iteration<2; ++iteration) {
+    if (fixed_rank || iteration == 1) {
+      Dense Z(A.dim[1], k), Y(A.dim[0], k), R(k, k);
+      gemm(A, Q, Z, 1, 0, true, false);
+      gemm(A, Z, Y, 1, 0);
+      qr(Y, Q, R);
+    }
+    gemm(Q, A, B, 1, 0, true, false);
+    if (fixed_rank) break;
+    double A_norm;
+    col_norm = residual_col_norms(A, Q, B, A_norm);
+    threshold = eps*eps*A_norm;
+    if (*std::max_element(col_norm.begin(), col_norm.end()) <= threshold) break;
+    if (iteration == 1) return LowRank(A, eps);
+  }
+  ++n_warm_starts;
+  Dense Ub, S, V;
+  std::tie(Ub, S, V) = svd(B);
+  int64_t new_rank = fixed_rank ? rank : S.dim[0];
+  // The residual is orthogonal to Q, so dropping triplet i adds
+  // (s_i*v_i[j])^2 to the squared norm of column j of the error
+  while (!fixed_rank && new_rank > 1) {
+    const double s = S(new_rank-1, new_rank-1);
+    std::vector<double> truncated(col_norm);
+    for (int64_t j=0; j<A.dim[1]; ++j) {
+      truncated[j] += s*s * V(new_rank-1, j) * V(new_rank-1, j);
+    }
+    if (*std::max_element(truncated.begin(), truncated.end()) > threshold) break;
+    col_norm = std::move(truncated);
+    new_rank--;
+  }
+  Dense U(A.dim[0], new_rank);
+  gemm(Q, resize(std::move(Ub), k, new_rank), U, 1, 0);
+  LowRank out(
+    std::move(U), resize(std::move(S), new_rank, new_rank),
+    resize(std::move(V), new_rank, A.dim[1])
+  );
+  if (!fixed_rank) out.eps = eps;
+  return out;
+}
+
+int64_t MatrixInitializer::get_n_warm_starts() const {
+  return n_warm_starts;
+}
+
+const Geometry& MatrixInitializer::get_geometry() const {
+  return params;
+}
+
+MatrixInitializer::BoundingBox MatrixInitializer::get_bounding_box(
+  const IndexRange& range
+) const {
+  const auto cached = bounding_boxes.find({range.start, range.n});
+  if (cached != bounding_boxes.end()) return cached->second;
+  BoundingBox box;
+  for (const std::vector<double>& axis : params.coords()) {
+    const auto minmax = std::minmax_element(
+      axis.begin()+range.start, axis.begin()+range.start+range.n
+    );
+    box.min.push_back(*minmax.first);
+    box.max.push_back(*minmax.second);
+  }
+  return box;
+}
+
+void MatrixInitializer::compute_bounding_boxes(const ClusterTree& node) {
+  for (const ClusterTree& child : node) compute_bounding_boxes(child);
+  const bool leaf = node.begin() == node.end();
+  // The box of a cluster is the union of the boxes of its parts
+  for (const int along : {ALONG_COL, ALONG_ROW}) {
+    const IndexRange& range = along == ALONG_COL ? node.rows : node.cols;
+    if (bounding_boxes.count({range.start, range.n}) > 0) continue;
+    if (leaf) {
+      bounding_boxes[{range.start, range.n}] = get_bounding_box(range);
+      continue;
+    }
+    BoundingBox box;
+    const int64_t n_parts = node.block_dim[along == ALONG_COL ? 0 : 1];
+    for (int64_t k=0; k<n_parts; ++k) {
+      const ClusterTree& part = along == ALONG_COL ? node(k, 0) : node(0, k);
+      const BoundingBox& part_box = bounding_boxes.at(
+        along == ALONG_COL
+        ? std::array<int64_t, 2>{part.rows.start, part.rows.n}
+        : std::array<int64_t, 2>{part.cols.start, part.cols.n}
+      );
+      if (k == 0) {
+        box = part_box;
+      } else {
+        for (size_t d=0; d<box.min.size(); d++) {
+          box.min[d] = std::min(box.min[d], part_box.min[d]);
+          box.max[d] = std::max(box.max[d], part_box.max[d]);
+        }
+      }
+    }
+    bounding_boxes[{range.start, range.n}] = std::move(box);
+  }
+}
+
+bool MatrixInitializer::is_admissible(
+  const BoundingBox& row_box, const BoundingBox& col_box
+) const {
+  const double offset = 5e-1;
+  //Calculate diameter and distance
+  double max_length_row = 0.0;
+  double max_length_col = 0.0;
+  double dist = 0.0;
+  for(size_t k=0; k<row_box.min.size(); k++) {
+    const double min_coord_row = -offset + row_box.min[k];
+    const double max_coord_row = offset + row_box.max[k];
+    const double center_coord_row = min_coord_row + (max_coord_row-min_coord_row)/2.0;
+    const double min_coord_col = -offset + col_box.min[k];
+    const double max_coord_col = offset + col_box.max[k];
+    const double center_coord_col = min_coord_col + (max_coord_col-min_coord_col)/2.0;
+    max_length_row = std::max(max_length_row, max_coord_row - min_coord_row);
+    max_length_col = std::max(max_length_col, max_coord_col - min_coord_col);
+    double d = std::fabs(center_coord_row - center_coord_col);
+    dist += d * d;
+  }
+  const double diam = std::max(max_length_row, max_length_col);
+  return (admis * admis * diam * diam) < dist;
 }
 
 bool MatrixInitializer::is_admissible(const ClusterTree& node) const {
@@ -57,37 +216,61 @@ bool MatrixInitializer::is_admissible(const ClusterTree& node) const {
       admissible &= (node.dist_to_diag() > (int64_t)admis);
       break;
     case AdmisType::GeometryBased:
-      //Get actual coordinates
-      const std::vector<std::vector<double>> row_coords = get_coords_range(node.rows);
-      const std::vector<std::vector<double>> col_coords = get_coords_range(node.cols);
-      //Calculate bounding boxes
-      const double offset = 5e-1;
-      std::vector<double> max_coord_row, min_coord_row, center_coord_row;
-      std::vector<double> max_coord_col, min_coord_col, center_coord_col;
-      for(size_t d=0; d<row_coords.size(); d++) {
-        min_coord_row.push_back(-offset + *std::min_element(row_coords[d].begin(), row_coords[d].end()));
-        max_coord_row.push_back(offset + *std::max_element(row_coords[d].begin(), row_coords[d].end()));
-        center_coord_row.push_back(min_coord_row[d] + (max_coord_row[d]-min_coord_row[d])/2.0);
-
-        min_coord_col.push_back(-offset + *std::min_element(col_coords[d].begin(), col_coords[d].end()));
-        max_coord_col.push_back(offset + *std::max_element(col_coords[d].begin(), col_coords[d].end()));
-        center_coord_col.push_back(min_coord_col[d] + (max_coord_col[d]-min_coord_col[d])/2.0);
+      const auto cached = admissibility.find(
+        {node.rows.start, node.rows.n, node.cols.start, node.cols.n}
+      );
+      if (cached != admissibility.end()) {
+        admissible &= cached->second;
+      } else {
+        admissible &= is_admissible(
+          get_bounding_box(node.rows), get_bounding_box(node.cols)
+        );
       }
-      //Calculate diameter and distance
-      double max_length_row = 0.0;
-      double max_length_col = 0.0;
-      double dist = 0.0;
-      for(size_t k=0; k<row_coords.size(); k++) {
-        max_length_row = std::max(max_length_row, max_coord_row[k] - min_coord_row[k]);
-        max_length_col = std::max(max_length_col, max_coord_col[k] - min_coord_col[k]);
-        double d = std::fabs(center_coord_row[k] - center_coord_col[k]);
-        dist += d * d;
-      }
-      const double diam = std::max(max_length_row, max_length_col);
-      admissible &= ((admis * admis * diam * diam) < dist);
       break;
   }
   return admissible;
 }
 
+void collect_nodes(
+  const ClusterTree& node, std::vector<const ClusterTree*>& nodes
+) {
+  nodes.push_back(&node);
+  for (const ClusterTree& child : node) collect_nodes(child, nodes);
+}
+
+void MatrixInitializer::find_admissible_blocks(const ClusterTree& root) {
+  if (admis_type != AdmisType::GeometryBased) return;
+  // The caches only hold the clusters and blocks of the latest tree
+  bounding_boxes.clear();
+  admissibility.clear();
+  compute_bounding_boxes(root);
+  std::vector<const ClusterTree*> nodes;
+  collect_nodes(root, nodes);
+  const int64_t n_nodes = nodes.size();
+  std::vector<char> admissible(n_nodes);
+  const auto evaluate = [&](const int64_t begin, const int64_t end) {
+    for (int64_t i=begin; i<end; ++i) {
+      admissible[i] = is_admissible(
+        bounding_boxes.at({nodes[i]->rows.start, nodes[i]->rows.n}),
+        bounding_boxes.at({nodes[i]->cols.start, nodes[i]->cols.n})
+      );
+    }
+  };
+  const int64_t n_threads = std::max<int64_t>(1, std::min<int64_t>(
+    std::thread::hardware_concurrency(), n_nodes / 1024
+  ));
+  std::vector<std::thread> threads;
+  for (int64_t t=1; t<n_threads; ++t) {
+    threads.emplace_back(evaluate, n_nodes*t/n_threads, n_nodes*(t+1)/n_threads);
+  }
+  evaluate(0, n_nodes/n_threads);
+  for (std::thread& thread : threads) thread.join();
+  for (int64_t i=0; i<n_nodes; ++i) {
+    admissibility[{
+      nodes[i]->rows.start, nodes[i]->rows.n,
+      nodes[i]->cols.start, nodes[i]->cols.n
+    }] = admissible[i];
+  }
+}
+
 } // namespace FRANK
@@ -14,7 +14,7 @@ namespace FRANK
 // Additional constructors
 MatrixInitializerBlock::MatrixInitializerBlock(
   Dense&& A, const double admis, const double eps, const int64_t rank,
-  const std::vector<std::vector<double>> params, const AdmisType admis_type
+  const Geometry params, const AdmisType admis_type
 ) : MatrixInitializer(admis, eps, rank, params, admis_type),
     matrix(std::move(A)) {}
 
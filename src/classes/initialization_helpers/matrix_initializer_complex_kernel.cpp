@@ -0,0 +1,71 @@
+#include "FRANK/classes/initialization_helpers/matrix_initializer_complex_kernel.h"
+
+#include "FRANK/classes/basic_dense.h"
+#include "FRANK/classes/basic_low_rank.h"
+#include "FRANK/classes/dense.h"
+#include "FRANK/classes/initialization_helpers/cluster_tree.h"
+#include "FRANK/classes/initialization_helpers/matrix_initializer.h"
+
+#include <complex>
+#include <cstdint>
+#include <cstdlib>
+#include <iostream>
+
+
+namespace FRANK
+{
+
+MatrixInitializerComplexKernel::MatrixInitializerComplexKernel(
+  void (*kernel)(
+    std::complex<double>* A,
+    const uint64_t A_rows, const uint64_t A_cols, const uint64_t A_stride,
+    const std::vector<std::vector<double>>& params,
+    const int64_t row_start, const int64_t col_start
+  ),
+  const Geometry params,
+  const double admis, const double eps, const int64_t rank, const AdmisType admis_type
+) : MatrixInitializer(admis, eps, rank, params, admis_type),
+    kernel(kernel) {}
+
+void MatrixInitializerComplexKernel::fill_dense_representation(
+  Dense& A, const IndexRange& row_range, const IndexRange& col_range
+) const {
+  ZDense Z(A.dim[0], A.dim[1]);
+  fill_complex_representation(Z, row_range, col_range);
+  for (int64_t i=0; i<A.dim[0]; i++) {
+    const std::complex<double>* z = &Z + i*Z.stride;
+    double* a = &A + i*A.stride;
+    for (int64_t j=0; j<A.dim[1]; j++) {
+      if (z[j].imag() != 0) {
+        std::cerr << "Complex kernel value cannot be stored in a Dense matrix, ";
+        std::cerr << "use fill_complex_representation() instead." << std::endl;
+        std::abort();
+      }
+      a[j] = z[j].real();
+    }
+  }
+}
+
+void MatrixInitializerComplexKernel::fill_complex_representation(
+  ZDense& A, const IndexRange& row_range, const IndexRange& col_range
+) const {
+  kernel(&A, A.dim[0], A.dim[1], A.stride,
+         params, row_range.start, col_range.start);
+}
+
+ZDense MatrixInitializerComplexKernel::get_complex_dense_representation(
+  const ClusterTree& node
+) const {
+  ZDense representation(node.rows.n, node.cols.n);
+  fill_complex_representation(representation, node.rows, node.cols);
+  return representation;
+}
+
+ZLowRank MatrixInitializerComplexKernel::get_complex_compressed_representation(
+  const ClusterTree& node, const bool fixed_rank
+) const {
+  if (fixed_rank) return ZLowRank(get_complex_dense_representation(node), rank);
+  else return ZLowRank(get_complex_dense_representation(node), eps);
+}
+
+} // namespace FRANK
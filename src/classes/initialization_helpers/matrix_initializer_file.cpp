@@ -3,8 +3,14 @@
 #include "FRANK/classes/dense.h"
 #include "FRANK/classes/initialization_helpers/cluster_tree.h"
 #include "FRANK/classes/initialization_helpers/index_range.h"
+#include "FRANK/util/mapped_file.h"
+#include "FRANK/util/matrix_file.h"
 
+#include <algorithm>
 #include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <memory>
 #include <utility>
 #include <cassert>
 #include <iostream>
@@ -17,12 +23,63 @@ namespace FRANK
 
 // Additional constructors
 MatrixInitializerFile::MatrixInitializerFile(
-  const std::string filename, const MatrixLayout ordering
-) : MatrixInitializer(0, 0, 0, {}, AdmisType::PositionBased),
-    filename(filename), ordering(ordering) {}
+  const std::string filename, const MatrixLayout ordering,
+  const double admis, const double eps, const int64_t rank,
+  const Geometry params, const AdmisType admis_type
+) : MatrixInitializer(admis, eps, rank, params, admis_type),
+    filename(filename), ordering(ordering) {
+  // Missing files are reported when the first block is filled, as before
+  uint64_t n_bytes;
+  std::shared_ptr<char> file = map_file(filename, n_bytes);
+  MatrixFileHeader header(0, 0, MatrixLayout::RowMajor);
+  if (n_bytes < sizeof(header)) return;
+  std::memcpy(&header, file.get(), sizeof(header));
+  if (!header.is_valid()) return;
+  if (n_bytes < sizeof(header) + header.n_rows*header.n_cols*sizeof(double)) {
+    std::cerr << "Matrix file is truncated: " << filename << std::endl;
+    std::abort();
+  }
+  mapping = std::move(file);
+  values = reinterpret_cast<const double*>(mapping.get() + sizeof(header));
+  file_dim = {header.n_rows, header.n_cols};
+  this->ordering = header.get_layout();
+}
+
+bool MatrixInitializerFile::is_binary() const { return mapping != nullptr; }
 
 void MatrixInitializerFile::fill_dense_representation(
   Dense& A, const IndexRange& row_range, const IndexRange& col_range
+) const {
+  if (!is_binary()) {
+    fill_from_text(A, row_range, col_range);
+    return;
+  }
+  assert(row_range.start+A.dim[0] <= file_dim[0]);
+  assert(col_range.start+A.dim[1] <= file_dim[1]);
+  switch(ordering) {
+    case MatrixLayout::RowMajor:
+      for(int64_t i=0; i<A.dim[0]; i++) {
+        const double* row = (
+          values + (row_range.start+i)*file_dim[1] + col_range.start
+        );
+        std::copy(row, row+A.dim[1], &A + i*A.stride);
+      }
+      break;
+    case MatrixLayout::ColumnMajor:
+      for(int64_t j=0; j<A.dim[1]; j++) {
+        const double* column = (
+          values + (col_range.start+j)*file_dim[0] + row_range.start
+        );
+        for(int64_t i=0; i<A.dim[0]; i++) {
+          A(i, j) = column[i];
+        }
+      }
+      break;
+  }
+}
+
+void MatrixInitializerFile::fill_from_text(
+  Dense& A, const IndexRange& row_range, const IndexRange& col_range
 ) const {
   std::ifstream file;
   file.open(filename);
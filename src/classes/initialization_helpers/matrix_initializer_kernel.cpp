@@ -16,7 +16,7 @@ MatrixInitializerKernel::MatrixInitializerKernel(
     const std::vector<std::vector<double>>& params,
     const int64_t row_start, const int64_t col_start
   ),
-  const std::vector<std::vector<double>> params,
+  const Geometry params,
   const double admis, const double eps, const int64_t rank, const AdmisType admis_type
 ) : MatrixInitializer(admis, eps, rank, params, admis_type),
     kernel(kernel) {}
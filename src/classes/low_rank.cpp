@@ -42,9 +42,9 @@ LowRank::LowRank(const Dense& A, const int64_t rank)
   // Rank with oversampling limited by dimensions
   std::tie(U, S, V) = rsvd(A, std::min(std::min(rank+5, dim[0]), dim[1]));
   // Reduce to actual desired rank
-  U = resize(U, dim[0], rank);
-  V = resize(V, rank, dim[1]);
-  S = resize(S, rank, rank);
+  U = resize(std::move(U), dim[0], rank);
+  V = resize(std::move(V), rank, dim[1]);
+  S = resize(std::move(S), rank, rank);
 }
 
 LowRank::LowRank(const Dense& A, const double eps)
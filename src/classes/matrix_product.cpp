@@ -0,0 +1,129 @@
+#include "FRANK/classes/matrix_product.h"
+
+#include "FRANK/classes/dense.h"
+#include "FRANK/classes/identity.h"
+#include "FRANK/operations/BLAS.h"
+
+#include <cassert>
+#include <cstdint>
+#include <limits>
+#include <memory>
+#include <tuple>
+#include <vector>
+
+
+namespace FRANK
+{
+
+MatrixProduct::MatrixProduct(const Dense& A, const bool TransA)
+: factors{std::addressof(A)}, trans{TransA} {}
+
+MatrixProduct& MatrixProduct::times(const Dense& B, const bool TransB) {
+  assert(n_cols() == (TransB ? B.dim[1] : B.dim[0]));
+  factors.push_back(std::addressof(B));
+  trans.push_back(TransB);
+  return *this;
+}
+
+int64_t MatrixProduct::n_rows() const {
+  return trans.front() ? factors.front()->dim[1] : factors.front()->dim[0];
+}
+
+int64_t MatrixProduct::n_cols() const {
+  return trans.back() ? factors.back()->dim[0] : factors.back()->dim[1];
+}
+
+// Classic O(n^3) dynamic program for the matrix chain ordering problem.
+// split[i][j] is the last factor of the left operand of the final
+// multiplication of the sub-chain i..j.
+std::tuple<int64_t, std::vector<std::vector<int64_t>>> chain_order(
+  const std::vector<int64_t>& d
+) {
+  const int64_t n = d.size()-1;
+  std::vector<std::vector<int64_t>> cost(n, std::vector<int64_t>(n, 0));
+  std::vector<std::vector<int64_t>> split(n, std::vector<int64_t>(n, 0));
+  for (int64_t length=2; length<=n; ++length) {
+    for (int64_t i=0; i+length-1<n; ++i) {
+      const int64_t j = i+length-1;
+      cost[i][j] = std::numeric_limits<int64_t>::max();
+      for (int64_t s=i; s<j; ++s) {
+        const int64_t c = cost[i][s] + cost[s+1][j] + d[i]*d[s+1]*d[j+1];
+        if (c < cost[i][j]) {
+          cost[i][j] = c;
+          split[i][j] = s;
+        }
+      }
+    }
+  }
+  return {cost[0][n-1], std::move(split)};
+}
+
+std::vector<int64_t> chain_dims(
+  const std::vector<const Dense*>& factors, const std::vector<bool>& trans
+) {
+  std::vector<int64_t> d(factors.size()+1);
+  for (uint64_t i=0; i<factors.size(); ++i) {
+    d[i] = trans[i] ? factors[i]->dim[1] : factors[i]->dim[0];
+  }
+  d.back() = trans.back() ? factors.back()->dim[0] : factors.back()->dim[1];
+  return d;
+}
+
+int64_t MatrixProduct::cost() const {
+  return std::get<0>(chain_order(chain_dims(factors, trans)));
+}
+
+// Evaluate the sub-chain i..j. Single factors are returned as shallow copies
+// together with their transposition flag.
+std::tuple<Dense, bool> evaluate_chain(
+  const std::vector<const Dense*>& factors, const std::vector<bool>& trans,
+  const std::vector<std::vector<int64_t>>& split,
+  const int64_t i, const int64_t j
+) {
+  if (i == j) return {factors[i]->shallow_copy(), trans[i]};
+  Dense left, right;
+  bool trans_left, trans_right;
+  std::tie(left, trans_left) = evaluate_chain(
+    factors, trans, split, i, split[i][j]
+  );
+  std::tie(right, trans_right) = evaluate_chain(
+    factors, trans, split, split[i][j]+1, j
+  );
+  Dense out(
+    trans_left ? left.dim[1] : left.dim[0],
+    trans_right ? right.dim[0] : right.dim[1]
+  );
+  gemm(left, right, out, 1, 0, trans_left, trans_right);
+  return {std::move(out), false};
+}
+
+void MatrixProduct::evaluate(
+  Dense& C, const double alpha, const double beta
+) const {
+  assert(C.dim[0] == n_rows());
+  assert(C.dim[1] == n_cols());
+  const int64_t n = factors.size();
+  if (n == 1) {
+    gemm(Identity(n_rows()), *factors[0], C, alpha, beta, false, trans[0]);
+    return;
+  }
+  std::vector<std::vector<int64_t>> split;
+  std::tie(std::ignore, split) = chain_order(chain_dims(factors, trans));
+  Dense left, right;
+  bool trans_left, trans_right;
+  std::tie(left, trans_left) = evaluate_chain(
+    factors, trans, split, 0, split[0][n-1]
+  );
+  std::tie(right, trans_right) = evaluate_chain(
+    factors, trans, split, split[0][n-1]+1, n-1
+  );
+  gemm(left, right, C, alpha, beta, trans_left, trans_right);
+}
+
+MatrixProduct::operator Dense() const {
+  Dense out(n_rows(), n_cols());
+  evaluate(out, 1, 0);
+  return out;
+}
+
+} // namespace FRANK
@@ -1,10 +1,16 @@
 #include "FRANK/classes/matrix_proxy.h"
 
+#include "FRANK/classes/basic_dense.h"
+#include "FRANK/classes/basic_low_rank.h"
 #include "FRANK/classes/dense.h"
+#include "FRANK/classes/diagonal.h"
 #include "FRANK/classes/empty.h"
 #include "FRANK/classes/hierarchical.h"
+#include "FRANK/classes/identity.h"
 #include "FRANK/classes/low_rank.h"
 #include "FRANK/classes/matrix.h"
+#include "FRANK/classes/mixed_precision_low_rank.h"
+#include "FRANK/classes/out_of_core_hierarchical.h"
 #include "FRANK/util/omm_error_handler.h"
 
 #include "yorel/yomm2/cute.hpp"
@@ -29,6 +35,14 @@ define_method(std::unique_ptr<Matrix>, clone, (const Empty& A)) {
   return std::make_unique<Empty>(A);
 }
 
+define_method(std::unique_ptr<Matrix>, clone, (const Identity& A)) {
+  return std::make_unique<Identity>(A);
+}
+
+define_method(std::unique_ptr<Matrix>, clone, (const Diagonal& A)) {
+  return std::make_unique<Diagonal>(A);
+}
+
 define_method(std::unique_ptr<Matrix>, clone, (const LowRank& A)) {
   return std::make_unique<LowRank>(A);
 }
@@ -36,6 +50,38 @@ define_method(std::unique_ptr<Matrix>, clone, (const Hierarchical& A)) {
   return std::make_unique<Hierarchical>(A);
 }
 
+define_method(std::unique_ptr<Matrix>, clone, (const MixedPrecisionLowRank& A)) {
+  return std::make_unique<MixedPrecisionLowRank>(A);
+}
+
+define_method(std::unique_ptr<Matrix>, clone, (const SDense& A)) {
+  return std::make_unique<SDense>(A);
+}
+
+define_method(std::unique_ptr<Matrix>, clone, (const CDense& A)) {
+  return std::make_unique<CDense>(A);
+}
+
+define_method(std::unique_ptr<Matrix>, clone, (const ZDense& A)) {
+  return std::make_unique<ZDense>(A);
+}
+
+define_method(std::unique_ptr<Matrix>, clone, (const SLowRank& A)) {
+  return std::make_unique<SLowRank>(A);
+}
+
+define_method(std::unique_ptr<Matrix>, clone, (const CLowRank& A)) {
+  return std::make_unique<CLowRank>(A);
+}
+
+define_method(std::unique_ptr<Matrix>, clone, (const ZLowRank& A)) {
+  return std::make_unique<ZLowRank>(A);
+}
+
+define_method(std::unique_ptr<Matrix>, clone, (const SpilledBlock& A)) {
+  return std::make_unique<SpilledBlock>(A);
+}
+
 define_method(std::unique_ptr<Matrix>, clone, (const Matrix& A)) {
   omm_error_handler("clone", {A}, __FILE__, __LINE__);
   std::abort();
@@ -51,6 +97,14 @@ define_method(std::unique_ptr<Matrix>, move_clone, (Empty&& A)) {
   return std::make_unique<Empty>(std::move(A));
 }
 
+define_method(std::unique_ptr<Matrix>, move_clone, (Identity&& A)) {
+  return std::make_unique<Identity>(std::move(A));
+}
+
+define_method(std::unique_ptr<Matrix>, move_clone, (Diagonal&& A)) {
+  return std::make_unique<Diagonal>(std::move(A));
+}
+
 define_method(std::unique_ptr<Matrix>, move_clone, (LowRank&& A)) {
   return std::make_unique<LowRank>(std::move(A));
 }
@@ -59,6 +113,40 @@ define_method(std::unique_ptr<Matrix>, move_clone, (Hierarchical&& A)) {
   return std::make_unique<Hierarchical>(std::move(A));
 }
 
+define_method(
+  std::unique_ptr<Matrix>, move_clone, (MixedPrecisionLowRank&& A)
+) {
+  return std::make_unique<MixedPrecisionLowRank>(std::move(A));
+}
+
+define_method(std::unique_ptr<Matrix>, move_clone, (SDense&& A)) {
+  return std::make_unique<SDense>(std::move(A));
+}
+
+define_method(std::unique_ptr<Matrix>, move_clone, (CDense&& A)) {
+  return std::make_unique<CDense>(std::move(A));
+}
+
+define_method(std::unique_ptr<Matrix>, move_clone, (ZDense&& A)) {
+  return std::make_unique<ZDense>(std::move(A));
+}
+
+define_method(std::unique_ptr<Matrix>, move_clone, (SLowRank&& A)) {
+  return std::make_unique<SLowRank>(std::move(A));
+}
+
+define_method(std::unique_ptr<Matrix>, move_clone, (CLowRank&& A)) {
+  return std::make_unique<CLowRank>(std::move(A));
+}
+
+define_method(std::unique_ptr<Matrix>, move_clone, (ZLowRank&& A)) {
+  return std::make_unique<ZLowRank>(std::move(A));
+}
+
+define_method(std::unique_ptr<Matrix>, move_clone, (SpilledBlock&& A)) {
+  return std::make_unique<SpilledBlock>(std::move(A));
+}
+
 define_method(std::unique_ptr<Matrix>, move_clone, (Matrix&& A)) {
   omm_error_handler("move_clone", {A}, __FILE__, __LINE__);
   std::abort();
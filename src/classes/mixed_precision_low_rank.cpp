@@ -0,0 +1,321 @@
+#include "FRANK/classes/mixed_precision_low_rank.h"
+
+#include "FRANK/classes/dense.h"
+#include "FRANK/classes/initialization_helpers/index_range.h"
+#include "FRANK/classes/low_rank.h"
+#include "FRANK/operations/arithmetic.h"
+#include "FRANK/operations/BLAS.h"
+#include "FRANK/operations/LAPACK.h"
+#include "FRANK/operations/misc.h"
+
+#ifdef USE_MKL
+#include <mkl.h>
+#else
+#include <cblas.h>
+#endif
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+
+namespace FRANK
+{
+
+// Unit roundoff of double, single and bfloat16 precision
+constexpr std::array<double, 3> UNIT_ROUNDOFF = {
+  std::numeric_limits<double>::epsilon() / 2,
+  std::numeric_limits<float>::epsilon() / 2,
+  0x1p-8
+};
+
+// Round to nearest even on the upper 16 bits of the float representation
+uint16_t to_bfloat16(const double x) {
+  const float f = x;
+  uint32_t bits;
+  std::memcpy(&bits, &f, sizeof(bits));
+  bits += 0x7FFF + ((bits >> 16) & 1);
+  return bits >> 16;
+}
+
+double from_bfloat16(const uint16_t x) {
+  const uint32_t bits = uint32_t(x) << 16;
+  float f;
+  std::memcpy(&f, &bits, sizeof(f));
+  return f;
+}
+
+MixedPrecisionLowRank::MixedPrecisionLowRank(const LowRank& A, const double tol)
+: Matrix(A), dim{A.dim[0], A.dim[1]} {
+  if (A.rank == 0) return;
+  // Diagonalize the middle factor so that each triplet can be stored alone
+  Dense S_copy(A.S);
+  Dense Us, Ss, Vs;
+  std::tie(Us, Ss, Vs) = svd(S_copy);
+  Dense U(dim[0], A.rank), V(A.rank, dim[1]);
+  gemm(A.U, Us, U, 1, 0);
+  gemm(Vs, A.V, V, 1, 0);
+  // Rounding the singular vectors of triplet i to unit roundoff u changes
+  // the matrix by at most 2*u*s_i*||u_i||*||v_i||
+  const double triplet_tol = tol / A.rank;
+  std::vector<int64_t> level(A.rank);
+  for (int64_t i=0; i<A.rank; ++i) {
+    double u_norm = 0, v_norm = 0;
+    for (int64_t r=0; r<dim[0]; ++r) u_norm += U(r, i) * U(r, i);
+    for (int64_t c=0; c<dim[1]; ++c) v_norm += V(i, c) * V(i, c);
+    const double weight = 2 * Ss(i, i) * std::sqrt(u_norm * v_norm);
+    level[i] = 2;
+    while (level[i] > 0 && UNIT_ROUNDOFF[level[i]] * weight > triplet_tol) {
+      --level[i];
+    }
+  }
+  // Keep the triplets ordered by decreasing precision
+  for (int64_t i=A.rank-2; i>=0; --i) {
+    level[i] = std::min(level[i], level[i+1]);
+  }
+  for (int64_t i=0; i<A.rank; ++i) ++rank[level[i]];
+  S.resize(A.rank);
+  for (int64_t i=0; i<A.rank; ++i) S[i] = Ss(i, i);
+  for (int64_t i=0; i<A.rank; ++i) {
+    for (int64_t r=0; r<dim[0]; ++r) {
+      if (i < rank[0]) {
+        U_double.push_back(U(r, i));
+      } else if (i < rank[0]+rank[1]) {
+        U_single.push_back(U(r, i));
+      } else {
+        U_bfloat16.push_back(to_bfloat16(U(r, i)));
+      }
+    }
+    for (int64_t c=0; c<dim[1]; ++c) {
+      if (i < rank[0]) {
+        V_double.push_back(V(i, c));
+      } else if (i < rank[0]+rank[1]) {
+        V_single.push_back(V(i, c));
+      } else {
+        V_bfloat16.push_back(to_bfloat16(V(i, c)));
+      }
+    }
+  }
+}
+
+int64_t MixedPrecisionLowRank::total_rank() const {
+  return rank[0] + rank[1] + rank[2];
+}
+
+const double* MixedPrecisionLowRank::get_panel(
+  const bool left, const int64_t g, std::vector<double>& buffer
+) const {
+  if (g == 0) return left ? U_double.data() : V_double.data();
+  buffer.resize(rank[g] * dim[left ? 0 : 1]);
+  if (g == 1) {
+    const std::vector<float>& X = left ? U_single : V_single;
+    std::copy(X.begin(), X.end(), buffer.begin());
+  } else {
+    const std::vector<uint16_t>& X = left ? U_bfloat16 : V_bfloat16;
+    std::transform(X.begin(), X.end(), buffer.begin(), from_bfloat16);
+  }
+  return buffer.data();
+}
+
+Dense MixedPrecisionLowRank::get_vectors(const bool left) const {
+  const int64_t n = dim[left ? 0 : 1];
+  Dense out(total_rank(), n);
+  std::vector<double> buffer;
+  int64_t offset = 0;
+  for (int64_t g=0; g<3; ++g) {
+    const double* panel = get_panel(left, g, buffer);
+    for (int64_t i=0; i<rank[g]; ++i) {
+      std::copy(panel + i*n, panel + (i+1)*n, &out + (offset+i)*out.stride);
+    }
+    offset += rank[g];
+  }
+  return out;
+}
+
+LowRank MixedPrecisionLowRank::decompress() const {
+  const int64_t k = total_rank();
+  Dense S_out(k, k);
+  for (int64_t i=0; i<k; ++i) S_out(i, i) = S[i];
+  return LowRank(
+    Dense(transpose(get_vectors(true))), std::move(S_out), get_vectors(false)
+  );
+}
+
+void MixedPrecisionLowRank::multiply_right(
+  const Dense& B, Dense& C,
+  const double alpha, const double beta,
+  const bool TransA, const bool TransB
+) const {
+  // op(A) = L^T*S*R, where the rows of L and R are the stored singular vectors
+  const int64_t k = total_rank(), n = C.dim[1];
+  const int64_t m = dim[TransA ? 1 : 0], p = dim[TransA ? 0 : 1];
+  std::vector<double> SRB(k*n), buffer;
+  int64_t offset = 0;
+  for (int64_t g=0; g<3; ++g) {
+    if (rank[g] == 0) continue;
+    const double* R = get_panel(TransA, g, buffer);
+    cblas_dgemm(
+      CblasRowMajor, CblasNoTrans, TransB?CblasTrans:CblasNoTrans,
+      rank[g], n, p,
+      1, R, p, &B, B.stride,
+      0, &SRB[offset*n], n
+    );
+    offset += rank[g];
+  }
+  for (int64_t i=0; i<k; ++i) cblas_dscal(n, alpha*S[i], &SRB[i*n], 1);
+  if (beta == 0) {
+    C = 0.0;
+  } else if (beta != 1) {
+    C *= beta;
+  }
+  offset = 0;
+  for (int64_t g=0; g<3; ++g) {
+    if (rank[g] == 0) continue;
+    const double* L = get_panel(!TransA, g, buffer);
+    cblas_dgemm(
+      CblasRowMajor, CblasTrans, CblasNoTrans,
+      m, n, rank[g],
+      1, L, m, &SRB[offset*n], n,
+      1, &C, C.stride
+    );
+    offset += rank[g];
+  }
+}
+
+void MixedPrecisionLowRank::multiply_left(
+  const Dense& A, Dense& C,
+  const double alpha, const double beta,
+  const bool TransA, const bool TransB
+) const {
+  // op(B) = L^T*S*R, where the rows of L and R are the stored singular vectors
+  const int64_t k = total_rank(), m = C.dim[0];
+  const int64_t p = dim[TransB ? 1 : 0], n = dim[TransB ? 0 : 1];
+  std::vector<double> ALS(m*k), buffer;
+  int64_t offset = 0;
+  for (int64_t g=0; g<3; ++g) {
+    if (rank[g] == 0) continue;
+    const double* L = get_panel(!TransB, g, buffer);
+    cblas_dgemm(
+      CblasRowMajor, TransA?CblasTrans:CblasNoTrans, CblasTrans,
+      m, rank[g], p,
+      1, &A, A.stride, L, p,
+      0, &ALS[offset], k
+    );
+    offset += rank[g];
+  }
+  for (int64_t i=0; i<k; ++i) cblas_dscal(m, alpha*S[i], &ALS[i], k);
+  if (beta == 0) {
+    C = 0.0;
+  } else if (beta != 1) {
+    C *= beta;
+  }
+  offset = 0;
+  for (int64_t g=0; g<3; ++g) {
+    if (rank[g] == 0) continue;
+    const double* R = get_panel(TransB, g, buffer);
+    cblas_dgemm(
+      CblasRowMajor, CblasNoTrans, CblasNoTrans,
+      m, n, rank[g],
+      1, &ALS[offset], k, R, n,
+      1, &C, C.stride
+    );
+    offset += rank[g];
+  }
+}
+
+LowRank MixedPrecisionLowRank::multiply_right(
+  const Dense& B, const double alpha, const bool TransA, const bool TransB
+) const {
+  const int64_t k = total_rank(), p = dim[TransA ? 0 : 1];
+  const int64_t n = TransB ? get_n_rows(B) : get_n_cols(B);
+  Dense S_out(k, k), RB(k, n);
+  for (int64_t i=0; i<k; ++i) S_out(i, i) = S[i];
+  std::vector<double> buffer;
+  int64_t offset = 0;
+  for (int64_t g=0; g<3; ++g) {
+    if (rank[g] == 0) continue;
+    const double* R = get_panel(TransA, g, buffer);
+    cblas_dgemm(
+      CblasRowMajor, CblasNoTrans, TransB?CblasTrans:CblasNoTrans,
+      rank[g], n, p,
+      alpha, R, p, &B, B.stride,
+      0, &RB + offset*RB.stride, RB.stride
+    );
+    offset += rank[g];
+  }
+  return LowRank(
+    Dense(transpose(get_vectors(!TransA))), std::move(S_out), std::move(RB)
+  );
+}
+
+LowRank MixedPrecisionLowRank::multiply_left(
+  const Dense& A, const double alpha, const bool TransA, const bool TransB
+) const {
+  const int64_t k = total_rank(), p = dim[TransB ? 1 : 0];
+  const int64_t m = TransA ? get_n_cols(A) : get_n_rows(A);
+  Dense AL(m, k), S_out(k, k);
+  for (int64_t i=0; i<k; ++i) S_out(i, i) = S[i];
+  std::vector<double> buffer;
+  int64_t offset = 0;
+  for (int64_t g=0; g<3; ++g) {
+    if (rank[g] == 0) continue;
+    const double* L = get_panel(!TransB, g, buffer);
+    cblas_dgemm(
+      CblasRowMajor, TransA?CblasTrans:CblasNoTrans, CblasTrans,
+      m, rank[g], p,
+      alpha, &A, A.stride, L, p,
+      0, &AL + offset, AL.stride
+    );
+    offset += rank[g];
+  }
+  return LowRank(std::move(AL), std::move(S_out), get_vectors(TransB));
+}
+
+// Copy the elements in range of each of the k vectors of length n in X
+template<typename T>
+std::vector<T> slice_vectors(
+  const std::vector<T>& X, const int64_t k, const int64_t n,
+  const IndexRange& range
+) {
+  std::vector<T> out;
+  out.reserve(k * range.n);
+  for (int64_t i=0; i<k; ++i) {
+    const auto begin = X.begin() + i*n + range.start;
+    out.insert(out.end(), begin, begin + range.n);
+  }
+  return out;
+}
+
+std::vector<MixedPrecisionLowRank> MixedPrecisionLowRank::split(
+  const std::vector<IndexRange>& row_ranges,
+  const std::vector<IndexRange>& col_ranges
+) const {
+  std::vector<MixedPrecisionLowRank> out;
+  out.reserve(row_ranges.size() * col_ranges.size());
+  for (const IndexRange& rows : row_ranges) {
+    for (const IndexRange& cols : col_ranges) {
+      // Parts of the singular vectors are no longer than the whole vectors, so
+      // the precision of each triplet still meets the tolerance
+      MixedPrecisionLowRank block;
+      block.dim = {rows.n, cols.n};
+      block.rank = rank;
+      block.S = S;
+      block.U_double = slice_vectors(U_double, rank[0], dim[0], rows);
+      block.U_single = slice_vectors(U_single, rank[1], dim[0], rows);
+      block.U_bfloat16 = slice_vectors(U_bfloat16, rank[2], dim[0], rows);
+      block.V_double = slice_vectors(V_double, rank[0], dim[1], cols);
+      block.V_single = slice_vectors(V_single, rank[1], dim[1], cols);
+      block.V_bfloat16 = slice_vectors(V_bfloat16, rank[2], dim[1], cols);
+      out.push_back(std::move(block));
+    }
+  }
+  return out;
+}
+
+} // namespace FRANK
@@ -0,0 +1,731 @@
+#include "FRANK/classes/out_of_core_hierarchical.h"
+
+#include "FRANK/definitions.h"
+#include "FRANK/classes/dense.h"
+#include "FRANK/classes/hierarchical.h"
+#include "FRANK/classes/matrix.h"
+#include "FRANK/classes/matrix_proxy.h"
+#include "FRANK/classes/initialization_helpers/cluster_tree.h"
+#include "FRANK/classes/initialization_helpers/matrix_initializer.h"
+#include "FRANK/operations/misc.h"
+#include "FRANK/util/get_memory_usage.h"
+#include "FRANK/util/mapped_file.h"
+#include "FRANK/util/serialization.h"
+
+#include "yorel/yomm2/cute.hpp"
+using yorel::yomm2::virtual_;
+
+#include <algorithm>
+#include <cassert>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <deque>
+#include <limits>
+#include <mutex>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include <unistd.h>
+
+
+namespace FRANK
+{
+
+void transfer_all(
+  const int file_descriptor, char* buffer, const uint64_t size,
+  const uint64_t offset, const bool write
+) {
+  uint64_t done = 0;
+  while (done < size) {
+    const ssize_t n = write
+      ? pwrite(file_descriptor, buffer+done, size-done, offset+done)
+      : pread(file_descriptor, buffer+done, size-done, offset+done);
+    if (n <= 0) {
+      std::perror(write ? "pwrite" : "pread");
+      std::abort();
+    }
+    done += n;
+  }
+}
+
+// Leaf blocks of an OutOfCoreHierarchical, each held in memory or in the
+// spill file
+class BlockStore {
+ public:
+  enum class IO { Idle, Reading, Writing };
+  struct Entry {
+    MatrixProxy block;
+    // Block has been assigned, entries reserved by a plan are assigned later
+    bool exists = false;
+    bool resident = false;
+    // In-memory block differs from the copy on disk
+    bool dirty = false;
+    bool on_disk = false;
+    bool evict_after_write = false;
+    IO io = IO::Idle;
+    int64_t pins = 0;
+    uint64_t bytes = 0;
+    uint64_t offset = 0;
+    uint64_t capacity = 0;
+    uint64_t size_on_disk = 0;
+    // Entry reserved for the L factor of this block, -1 if none
+    int64_t lower = -1;
+  };
+  // Stable references, entries are added while others are in use
+  std::deque<Entry> entries;
+  const uint64_t budget;
+  const int64_t lookahead;
+  const int file_descriptor;
+  uint64_t file_end = 0;
+  // Bytes of all resident blocks, including those being read or written
+  uint64_t resident_bytes = 0;
+  // Bytes that will be freed once pending evictions have been written
+  uint64_t releasing_bytes = 0;
+  std::vector<int64_t> accesses;
+  std::vector<std::vector<int64_t>> uses;
+  int64_t cursor = 0;
+  OutOfCoreStatistics statistics;
+  std::mutex mutex;
+  std::condition_variable job_ready, io_done;
+  std::deque<int64_t> jobs;
+  bool stop = false;
+  std::thread worker;
+
+  BlockStore(
+    const uint64_t budget, const std::string& directory, const int64_t lookahead
+  ) : budget(budget), lookahead(lookahead),
+      file_descriptor(create_temporary_file(directory)) {
+    worker = std::thread(&BlockStore::run, this);
+  }
+
+  ~BlockStore() {
+    {
+      std::lock_guard<std::mutex> lock(mutex);
+      stop = true;
+    }
+    job_ready.notify_all();
+    worker.join();
+    close(file_descriptor);
+  }
+
+  int64_t next_use(const int64_t idx) const {
+    if (idx >= int64_t(uses.size())) return std::numeric_limits<int64_t>::max();
+    const std::vector<int64_t>& positions = uses[idx];
+    auto it = std::lower_bound(positions.begin(), positions.end(), cursor);
+    return it == positions.end() ? std::numeric_limits<int64_t>::max() : *it;
+  }
+
+  void update_peak() {
+    statistics.peak_memory = std::max(statistics.peak_memory, resident_bytes);
+  }
+
+  void evict(const int64_t idx) {
+    Entry& entry = entries[idx];
+    if (entry.dirty || !entry.on_disk) {
+      entry.io = IO::Writing;
+      entry.evict_after_write = true;
+      releasing_bytes += entry.bytes;
+      jobs.push_back(idx);
+      job_ready.notify_one();
+    } else {
+      entry.block = MatrixProxy();
+      entry.resident = false;
+      resident_bytes -= entry.bytes;
+    }
+  }
+
+  // Evict blocks whose next use comes after position before, furthest next use
+  // first, until bytes more fit into the budget. Pass -1 to allow any block.
+  bool make_room(const uint64_t bytes, const int64_t before) {
+    while (resident_bytes - releasing_bytes + bytes > budget) {
+      int64_t victim = -1, victim_use = before;
+      for (uint64_t idx=0; idx<entries.size(); ++idx) {
+        const Entry& entry = entries[idx];
+        if (!entry.resident || entry.pins > 0 || entry.io != IO::Idle) continue;
+        const int64_t use = next_use(idx);
+        if (use > victim_use) {
+          victim = idx;
+          victim_use = use;
+        }
+      }
+      if (victim == -1) return false;
+      evict(victim);
+    }
+    return true;
+  }
+
+  // Wait until bytes more fit into the budget. Gives up if the blocks that
+  // would have to be evicted are in use.
+  void wait_for_room(std::unique_lock<std::mutex>& lock, const uint64_t bytes) {
+    while (resident_bytes + bytes > budget) {
+      make_room(bytes, -1);
+      if (resident_bytes + bytes <= budget || releasing_bytes == 0) return;
+      io_done.wait(lock);
+    }
+  }
+
+  void keep(Entry& entry) {
+    if (entry.io == IO::Writing && entry.evict_after_write) {
+      entry.evict_after_write = false;
+      releasing_bytes -= entry.bytes;
+    }
+  }
+
+  void prefetch() {
+    const int64_t end = std::min<int64_t>(cursor + lookahead, accesses.size());
+    for (int64_t p=cursor; p<end; ++p) {
+      const int64_t idx = accesses[p];
+      Entry& entry = entries[idx];
+      if (!entry.exists) continue;
+      keep(entry);
+      if (entry.resident || entry.io != IO::Idle) continue;
+      if (
+        !make_room(entry.bytes, p) || resident_bytes + entry.bytes > budget
+      ) break;
+      entry.io = IO::Reading;
+      resident_bytes += entry.bytes;
+      jobs.push_back(idx);
+      job_ready.notify_one();
+    }
+    update_peak();
+  }
+
+  // Move the cursor past the next planned use of idx. The search is limited,
+  // so that a use that is not planned does not skip ahead.
+  void advance(const int64_t idx) {
+    const int64_t end = std::min<int64_t>(
+      cursor + 4*lookahead + 16, accesses.size()
+    );
+    for (int64_t p=cursor; p<end; ++p) {
+      if (accesses[p] == idx) {
+        cursor = p + 1;
+        return;
+      }
+    }
+  }
+
+  int64_t reserve() {
+    std::lock_guard<std::mutex> lock(mutex);
+    entries.emplace_back();
+    return entries.size() - 1;
+  }
+
+  int64_t reserve_lower(const int64_t idx) {
+    const int64_t lower = reserve();
+    std::lock_guard<std::mutex> lock(mutex);
+    entries[idx].lower = lower;
+    return lower;
+  }
+
+  int64_t insert(MatrixProxy&& block) {
+    const int64_t idx = reserve();
+    assign(idx, std::move(block));
+    return idx;
+  }
+
+  // Store a new block, evicting others and waiting for their write-back first
+  // if it does not fit into the budget
+  void assign(const int64_t idx, MatrixProxy&& block) {
+    const uint64_t bytes = get_memory_usage(block, true);
+    std::unique_lock<std::mutex> lock(mutex);
+    wait_for_room(lock, bytes);
+    Entry& entry = entries[idx];
+    assert(!entry.exists);
+    entry.bytes = bytes;
+    entry.block = std::move(block);
+    entry.exists = true;
+    entry.resident = true;
+    entry.dirty = true;
+    resident_bytes += entry.bytes;
+    update_peak();
+  }
+
+  int64_t take_lower(const int64_t idx) {
+    int64_t lower;
+    {
+      std::lock_guard<std::mutex> lock(mutex);
+      lower = entries[idx].lower;
+      entries[idx].lower = -1;
+    }
+    return lower == -1 ? reserve() : lower;
+  }
+
+  MatrixProxy& acquire(const int64_t idx) {
+    std::unique_lock<std::mutex> lock(mutex);
+    advance(idx);
+    Entry& entry = entries[idx];
+    assert(entry.exists);
+    keep(entry);
+    // Pin first so that making room for other blocks cannot evict it
+    ++entry.pins;
+    if (entry.resident && entry.io == IO::Idle) {
+      ++statistics.hits;
+      prefetch();
+      return entry.block;
+    }
+    ++statistics.misses;
+    const auto start = std::chrono::steady_clock::now();
+    if (!entry.resident && entry.io == IO::Idle) {
+      wait_for_room(lock, entry.bytes);
+      entry.io = IO::Reading;
+      resident_bytes += entry.bytes;
+      jobs.push_front(idx);
+      job_ready.notify_one();
+    }
+    prefetch();
+    io_done.wait(lock, [&entry]() { return entry.io == IO::Idle; });
+    statistics.stall_time += std::chrono::duration<double>(
+      std::chrono::steady_clock::now() - start
+    ).count();
+    return entry.block;
+  }
+
+  void release(const int64_t idx, const bool modified) {
+    std::lock_guard<std::mutex> lock(mutex);
+    Entry& entry = entries[idx];
+    assert(entry.pins > 0);
+    --entry.pins;
+    if (modified) {
+      entry.dirty = true;
+      const uint64_t bytes = get_memory_usage(entry.block, true);
+      resident_bytes = resident_bytes - entry.bytes + bytes;
+      entry.bytes = bytes;
+      update_peak();
+    }
+    make_room(0, -1);
+  }
+
+  // Free the block of a leaf that is no longer referenced
+  void erase(const int64_t idx) {
+    std::unique_lock<std::mutex> lock(mutex);
+    Entry& entry = entries[idx];
+    keep(entry);
+    io_done.wait(lock, [&entry]() { return entry.io == IO::Idle; });
+    if (entry.resident) resident_bytes -= entry.bytes;
+    entry.block = MatrixProxy();
+    entry.exists = false;
+    entry.resident = false;
+    entry.dirty = false;
+    entry.on_disk = false;
+  }
+
+  void plan(std::vector<int64_t>&& planned) {
+    std::lock_guard<std::mutex> lock(mutex);
+    accesses = std::move(planned);
+    cursor = 0;
+    uses.assign(entries.size(), {});
+    for (uint64_t p=0; p<accesses.size(); ++p) uses[accesses[p]].push_back(p);
+  }
+
+  void run() {
+    std::unique_lock<std::mutex> lock(mutex);
+    while (true) {
+      job_ready.wait(lock, [this]() { return stop || !jobs.empty(); });
+      if (jobs.empty()) return;
+      const int64_t idx = jobs.front();
+      jobs.pop_front();
+      Entry& entry = entries[idx];
+      // The computation does not touch blocks while they are read or written
+      if (entry.io == IO::Writing) {
+        lock.unlock();
+        std::vector<char> buffer;
+        serialize(entry.block, buffer);
+        lock.lock();
+        if (buffer.size() > entry.capacity) {
+          entry.offset = file_end;
+          entry.capacity = buffer.size();
+          file_end += buffer.size();
+        }
+        const uint64_t offset = entry.offset;
+        lock.unlock();
+        transfer_all(file_descriptor, buffer.data(), buffer.size(), offset, true);
+        lock.lock();
+        entry.on_disk = true;
+        entry.dirty = false;
+        entry.size_on_disk = buffer.size();
+        statistics.bytes_written += buffer.size();
+        ++statistics.blocks_written;
+        if (entry.evict_after_write) {
+          entry.block = MatrixProxy();
+          entry.resident = false;
+          entry.evict_after_write = false;
+          resident_bytes -= entry.bytes;
+          releasing_bytes -= entry.bytes;
+        }
+      } else {
+        const uint64_t offset = entry.offset, size = entry.size_on_disk;
+        lock.unlock();
+        std::vector<char> buffer(size);
+        transfer_all(file_descriptor, buffer.data(), size, offset, false);
+        const char* position = buffer.data();
+        MatrixProxy block = deserialize(position);
+        lock.lock();
+        entry.block = std::move(block);
+        entry.resident = true;
+        statistics.bytes_read += size;
+        ++statistics.blocks_read;
+      }
+      entry.io = IO::Idle;
+      io_done.notify_all();
+    }
+  }
+};
+
+// Reference to an entry of a BlockStore, shared by the copies of a
+// SpilledBlock. The entry is freed with the last copy.
+struct BlockHandle {
+  std::shared_ptr<BlockStore> store;
+  int64_t index;
+
+  BlockHandle(const std::shared_ptr<BlockStore>& store, const int64_t index)
+  : store(store), index(index) {}
+
+  ~BlockHandle() { store->erase(index); }
+};
+
+SpilledBlock::SpilledBlock(
+  const std::shared_ptr<BlockStore>& store, MatrixProxy&& A
+) : dim{FRANK::get_n_rows(A), FRANK::get_n_cols(A)},
+    handle(std::make_shared<BlockHandle>(
+      store, store->insert(std::move(A))
+    )) {}
+
+MatrixProxy& SpilledBlock::acquire() const {
+  return handle->store->acquire(handle->index);
+}
+
+void SpilledBlock::release(const bool modified) const {
+  handle->store->release(handle->index, modified);
+}
+
+SpilledBlock SpilledBlock::add_lower_factor(MatrixProxy&& L) const {
+  BlockStore& store = *handle->store;
+  SpilledBlock lower;
+  lower.dim = {FRANK::get_n_rows(L), FRANK::get_n_cols(L)};
+  const int64_t index = store.take_lower(handle->index);
+  store.assign(index, std::move(L));
+  lower.handle = std::make_shared<BlockHandle>(handle->store, index);
+  return lower;
+}
+
+declare_method(
+  const SpilledBlock*, as_spilled_block, (virtual_<const Matrix&>)
+)
+
+define_method(const SpilledBlock*, as_spilled_block, (const SpilledBlock& A)) {
+  return &A;
+}
+
+define_method(const SpilledBlock*, as_spilled_block, (const Matrix&)) {
+  return nullptr;
+}
+
+ResidentBlock::ResidentBlock(const Matrix& A, const bool modified)
+: spilled(as_spilled_block(A)), modified(modified) {
+  if (spilled == nullptr) {
+    block = const_cast<Matrix*>(&A);
+  } else {
+    block = &static_cast<Matrix&>(spilled->acquire());
+  }
+}
+
+ResidentBlock::~ResidentBlock() {
+  if (spilled != nullptr) spilled->release(modified);
+}
+
+Matrix& ResidentBlock::get() const { return *block; }
+
+// Shape of the Hierarchical structure with the store entries of its leaves,
+// used to plan the order in which the recursive algorithms use the leaves
+struct PlanNode {
+  bool hierarchical = false;
+  // Store entry of a leaf, -1 for leaves held in memory such as Empty
+  int64_t index = -1;
+  std::array<int64_t, 2> dim = {0, 0};
+  std::vector<PlanNode> blocks;
+
+  PlanNode& operator()(const int64_t i, const int64_t j) {
+    return blocks[i*dim[1] + j];
+  }
+
+  const PlanNode& operator()(const int64_t i, const int64_t j) const {
+    return blocks[i*dim[1] + j];
+  }
+};
+
+declare_method(PlanNode, plan_node, (virtual_<const Matrix&>))
+
+define_method(PlanNode, plan_node, (const Hierarchical& A)) {
+  PlanNode node;
+  node.hierarchical = true;
+  node.dim = A.dim;
+  for (int64_t i=0; i<A.dim[0]; ++i) {
+    for (int64_t j=0; j<A.dim[1]; ++j) node.blocks.push_back(plan_node(A(i, j)));
+  }
+  return node;
+}
+
+define_method(PlanNode, plan_node, (const SpilledBlock& A)) {
+  PlanNode node;
+  node.index = A.handle->index;
+  return node;
+}
+
+define_method(PlanNode, plan_node, (const Matrix&)) {
+  return PlanNode();
+}
+
+// Follows the recursion of getrf, trsm and gemm on Hierarchical matrices and
+// records the order in which they pin leaves through ResidentBlock
+class Planner {
+ public:
+  BlockStore& store;
+  std::vector<int64_t> accesses;
+
+  explicit Planner(BlockStore& store) : store(store) {}
+
+  void use(const PlanNode& A) {
+    if (!A.hierarchical && A.index != -1) accesses.push_back(A.index);
+  }
+
+  void leaves(const PlanNode& A) {
+    use(A);
+    for (const PlanNode& block : A.blocks) leaves(block);
+  }
+
+  // getrf_omm and getrf_step, returns the shape of L
+  PlanNode getrf(PlanNode& A) {
+    if (!A.hierarchical) {
+      use(A);
+      PlanNode L;
+      if (A.index != -1) L.index = store.reserve_lower(A.index);
+      return L;
+    }
+    PlanNode L;
+    L.hierarchical = true;
+    L.dim = A.dim;
+    L.blocks.resize(A.blocks.size());
+    for (int64_t i=0; i<A.dim[0]; ++i) {
+      L(i, i) = getrf(A(i, i));
+      for (int64_t i_c=i+1; i_c<A.dim[0]; ++i_c) {
+        L(i_c, i) = std::move(A(i_c, i));
+        A(i_c, i) = PlanNode();
+        trsm(A(i, i), L(i_c, i), Mode::Upper, Side::Right);
+      }
+      for (int64_t j=i+1; j<A.dim[1]; ++j) {
+        trsm(L(i, i), A(i, j), Mode::Lower, Side::Left);
+      }
+      for (int64_t i_c=i+1; i_c<A.dim[0]; ++i_c) {
+        for (int64_t k=i+1; k<A.dim[1]; ++k) {
+          gemm(L(i_c, i), A(i, k), A(i_c, k));
+        }
+      }
+    }
+    return L;
+  }
+
+  // trsm_omm, where B is a leaf
+  void trsm(
+    const PlanNode& A, const PlanNode& B, const Mode uplo, const Side side
+  ) {
+    use(A);
+    use(B);
+    if (A.hierarchical && B.hierarchical) {
+      if (uplo == Mode::Upper && side == Side::Left) {
+        for (int64_t i=B.dim[0]-1; i>=0; --i) {
+          for (int64_t j=B.dim[0]-1; j>i; --j) gemm(A(i, j), B(j, 0), B(i, 0));
+          trsm(A(i, i), B(i, 0), uplo, side);
+        }
+      } else if (uplo == Mode::Upper) {
+        for (int64_t i=0; i<B.dim[0]; ++i) {
+          for (int64_t j=0; j<B.dim[1]; ++j) {
+            for (int64_t k=0; k<j; ++k) gemm(B(i, k), A(k, j), B(i, j));
+            trsm(A(j, j), B(i, j), uplo, side);
+          }
+        }
+      } else {
+        for (int64_t j=0; j<B.dim[1]; ++j) {
+          for (int64_t i=0; i<B.dim[0]; ++i) {
+            for (int64_t k=0; k<i; ++k) gemm(A(i, k), B(k, j), B(i, j));
+            trsm(A(i, i), B(i, j), uplo, side);
+          }
+        }
+      }
+    } else if (A.hierarchical) {
+      solve(A, uplo, side);
+    } else {
+      for (const PlanNode& block : B.blocks) leaves(block);
+    }
+  }
+
+  // trsm_omm with a right hand side held in memory, split like A
+  void solve(const PlanNode& A, const Mode uplo, const Side side) {
+    if (!A.hierarchical) {
+      use(A);
+      return;
+    }
+    if (uplo == Mode::Upper && side == Side::Left) {
+      for (int64_t i=A.dim[0]-1; i>=0; --i) {
+        for (int64_t j=A.dim[0]-1; j>i; --j) leaves(A(i, j));
+        solve(A(i, i), uplo, side);
+      }
+    } else if (uplo == Mode::Upper) {
+      for (int64_t j=0; j<A.dim[1]; ++j) {
+        for (int64_t k=0; k<j; ++k) leaves(A(k, j));
+        solve(A(j, j), uplo, side);
+      }
+    } else {
+      for (int64_t i=0; i<A.dim[0]; ++i) {
+        for (int64_t k=0; k<i; ++k) leaves(A(i, k));
+        solve(A(i, i), uplo, side);
+      }
+    }
+  }
+
+  // gemm_omm with alpha and beta of the LU update
+  void gemm(const PlanNode& A, const PlanNode& B, const PlanNode& C) {
+    use(A);
+    use(B);
+    use(C);
+    if (
+      A.hierarchical && B.hierarchical && C.hierarchical
+      && A.dim[0] == C.dim[0] && A.dim[1] == B.dim[0] && B.dim[1] == C.dim[1]
+    ) {
+      for (int64_t i=0; i<C.dim[0]; ++i) {
+        for (int64_t j=0; j<C.dim[1]; ++j) {
+          for (int64_t k=0; k<A.dim[1]; ++k) gemm(A(i, k), B(k, j), C(i, j));
+        }
+      }
+    } else {
+      // Mixed products convert or split their operands, which uses the leaves
+      // of the hierarchical operands roughly in order
+      for (const PlanNode* X : {&A, &B, &C}) {
+        for (const PlanNode& block : X->blocks) leaves(block);
+      }
+    }
+  }
+};
+
+OutOfCoreHierarchical::~OutOfCoreHierarchical() = default;
+
+OutOfCoreHierarchical::OutOfCoreHierarchical(
+  OutOfCoreHierarchical&& A
+) = default;
+
+OutOfCoreHierarchical& OutOfCoreHierarchical::operator=(
+  OutOfCoreHierarchical&& A
+) = default;
+
+declare_method(
+  void, spill_leaves, (virtual_<Matrix&>, MatrixProxy&, const std::shared_ptr<BlockStore>&)
+)
+
+define_method(
+  void, spill_leaves,
+  (Hierarchical& A, MatrixProxy&, const std::shared_ptr<BlockStore>& store)
+) {
+  for (int64_t i=0; i<A.dim[0]; ++i) {
+    for (int64_t j=0; j<A.dim[1]; ++j) spill_leaves(A(i, j), A(i, j), store);
+  }
+}
+
+define_method(
+  void, spill_leaves,
+  (Dense& A, MatrixProxy& slot, const std::shared_ptr<BlockStore>& store)
+) {
+  slot = SpilledBlock(store, std::move(A));
+}
+
+define_method(
+  void, spill_leaves,
+  (LowRank& A, MatrixProxy& slot, const std::shared_ptr<BlockStore>& store)
+) {
+  slot = SpilledBlock(store, std::move(A));
+}
+
+define_method(
+  void, spill_leaves, (Matrix&, MatrixProxy&, const std::shared_ptr<BlockStore>&)
+) {
+  // Empty and spilled blocks stay as they are
+}
+
+OutOfCoreHierarchical::OutOfCoreHierarchical(
+  Hierarchical&& A, const uint64_t memory_budget,
+  const std::string& directory, const int64_t lookahead
+) : dim(A.dim),
+    store(std::make_shared<BlockStore>(memory_budget, directory, lookahead)) {
+  for (int64_t i=0; i<dim[0]; ++i) n_rows.push_back(FRANK::get_n_rows(A(i, 0)));
+  for (int64_t j=0; j<dim[1]; ++j) n_cols.push_back(FRANK::get_n_cols(A(0, j)));
+  upper = std::move(A);
+  spill_leaves(upper, upper, store);
+}
+
+// Same blocks as Hierarchical(const ClusterTree&, ...), one leaf at a time
+Hierarchical build_out_of_core(
+  const ClusterTree& node, const MatrixInitializer& initializer,
+  const bool fixed_rank, const std::shared_ptr<BlockStore>& store
+) {
+  Hierarchical A(node.block_dim[0], node.block_dim[1]);
+  for (const ClusterTree& child : node) {
+    if (initializer.is_admissible(child)) {
+      A[child.rel_pos] = SpilledBlock(
+        store, initializer.get_compressed_representation(child, fixed_rank)
+      );
+    } else if (child.is_leaf()) {
+      A[child.rel_pos] = SpilledBlock(
+        store, initializer.get_dense_representation(child)
+      );
+    } else {
+      A[child.rel_pos] = build_out_of_core(child, initializer, fixed_rank, store);
+    }
+  }
+  return A;
+}
+
+OutOfCoreHierarchical::OutOfCoreHierarchical(
+  const ClusterTree& node,
+  const MatrixInitializer& initializer,
+  const bool fixed_rank,
+  const uint64_t memory_budget,
+  const std::string& directory,
+  const int64_t lookahead
+) : dim(node.block_dim),
+    store(std::make_shared<BlockStore>(memory_budget, directory, lookahead)) {
+  upper = build_out_of_core(node, initializer, fixed_rank, store);
+  for (const ClusterTree& child : node) {
+    if (child.rel_pos[1] == 0) n_rows.push_back(child.rows.n);
+    if (child.rel_pos[0] == 0) n_cols.push_back(child.cols.n);
+  }
+}
+
+void OutOfCoreHierarchical::plan_getrf() const {
+  Planner planner(*store);
+  PlanNode A = plan_node(upper);
+  planner.getrf(A);
+  store->plan(std::move(planner.accesses));
+}
+
+void OutOfCoreHierarchical::plan_trsm(const Mode uplo) const {
+  Planner planner(*store);
+  planner.solve(plan_node(uplo == Mode::Lower ? lower : upper), uplo, Side::Left);
+  store->plan(std::move(planner.accesses));
+}
+
+int64_t OutOfCoreHierarchical::get_n_rows(const int64_t i) const {
+  return n_rows[i];
+}
+
+int64_t OutOfCoreHierarchical::get_n_cols(const int64_t j) const {
+  return n_cols[j];
+}
+
+OutOfCoreStatistics OutOfCoreHierarchical::get_statistics() const {
+  std::lock_guard<std::mutex> lock(store->mutex);
+  return store->statistics;
+}
+
+} // namespace FRANK
@@ -0,0 +1,98 @@
+#include "FRANK/classes/permuted_hierarchical.h"
+
+#include "FRANK/classes/dense.h"
+#include "FRANK/classes/hierarchical.h"
+#include "FRANK/classes/initialization_helpers/cluster_tree.h"
+#include "FRANK/classes/initialization_helpers/index_tree.h"
+#include "FRANK/classes/initialization_helpers/matrix_initializer_kernel.h"
+
+#include <algorithm>
+#include <cassert>
+#include <cstdint>
+#include <thread>
+#include <utility>
+#include <vector>
+
+
+namespace FRANK
+{
+
+PermutedHierarchical::PermutedHierarchical(
+  Hierarchical&& A, const std::vector<int64_t>& perm
+) : A(std::move(A)), perm(perm), inverse(perm.size()) {
+  for (uint64_t i=0; i<perm.size(); ++i) inverse[perm[i]] = i;
+  std::vector<bool> visited(perm.size(), false);
+  for (uint64_t i=0; i<perm.size(); ++i) {
+    if (visited[i]) continue;
+    if (perm[i] != int64_t(i)) cycles.push_back(i);
+    for (int64_t j=i; !visited[j]; j=perm[j]) visited[j] = true;
+  }
+}
+
+PermutedHierarchical::PermutedHierarchical(
+  void (*kernel)(
+    double* A, const uint64_t A_rows, const uint64_t A_cols, const uint64_t A_stride,
+    const std::vector<std::vector<double>>& params,
+    const int64_t row_start, const int64_t col_start
+  ),
+  std::vector<std::vector<double>> params,
+  const int64_t nleaf, const double eps, const double admis,
+  const BisectionType type
+) {
+  std::vector<int64_t> permutation;
+  const IndexTree tree = geometric_bisection(params, permutation, nleaf, type);
+  const ClusterTree cluster_tree(tree, tree);
+  MatrixInitializerKernel initializer(
+    kernel, std::move(params), admis, eps, 0, AdmisType::GeometryBased
+  );
+  initializer.find_admissible_blocks(cluster_tree);
+  *this = PermutedHierarchical(
+    Hierarchical(cluster_tree, initializer, false), permutation
+  );
+}
+
+// Replace row i of B by row source[i], following the cycles of source
+void permute_rows(
+  Dense& B, const std::vector<int64_t>& source,
+  const std::vector<int64_t>& cycles
+) {
+  assert(B.dim[0] == int64_t(source.size()));
+  double* const data = &B;
+  const auto row = [&](const int64_t i) { return data + i*B.stride; };
+  const auto move_columns = [&](const int64_t col_begin, const int64_t col_end) {
+    std::vector<double> first(col_end-col_begin);
+    for (const int64_t start : cycles) {
+      std::copy(row(start)+col_begin, row(start)+col_end, first.begin());
+      int64_t i = start;
+      while (source[i] != start) {
+        std::copy(
+          row(source[i])+col_begin, row(source[i])+col_end, row(i)+col_begin
+        );
+        i = source[i];
+      }
+      std::copy(first.begin(), first.end(), row(i)+col_begin);
+    }
+  };
+  const int64_t n_threads = std::min<int64_t>(
+    B.dim[0]*B.dim[1] < (1 << 16) ? 1 : std::thread::hardware_concurrency(),
+    B.dim[1]
+  );
+  std::vector<std::thread> threads;
+  for (int64_t t=1; t<n_threads; ++t) {
+    threads.emplace_back(
+      move_columns, B.dim[1]*t/n_threads, B.dim[1]*(t+1)/n_threads
+    );
+  }
+  move_columns(0, B.dim[1]/std::max<int64_t>(n_threads, 1));
+  for (std::thread& thread : threads) thread.join();
+}
+
+void PermutedHierarchical::to_permuted(Dense& B) const {
+  permute_rows(B, perm, cycles);
+}
+
+void PermutedHierarchical::to_original(Dense& B) const {
+  permute_rows(B, inverse, cycles);
+}
+
+} // namespace FRANK
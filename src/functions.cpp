@@ -4,6 +4,7 @@
 
 #include <algorithm>
 #include <cmath>
+#include <complex>
 #include <cstdint>
 #include <random>
 #include <vector>
@@ -127,4 +128,25 @@ void helmholtznd(
   }
 }
 
+void helmholtznd_complex(
+  std::complex<double>* A,
+  const uint64_t A_rows, const uint64_t A_cols, const uint64_t A_stride,
+  const std::vector<std::vector<double>>& x,
+  const int64_t row_start, const int64_t col_start
+) {
+  for (uint64_t i=0; i<A_rows; i++) {
+    for (uint64_t j=0; j<A_cols; j++) {
+      double rij = 0.0;
+      for(size_t k=0; k<x.size(); k++) {
+        rij += (
+          (x[k][i+row_start] - x[k][j+col_start])
+          * (x[k][i+row_start] - x[k][j+col_start])
+        );
+      }
+      const double r = std::sqrt(rij);
+      A[i*A_stride+j] = std::polar(1.0, r) / (r + 1e-3);
+    }
+  }
+}
+
 } // namespace FRANK
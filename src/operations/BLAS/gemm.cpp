@@ -1,12 +1,21 @@
 #include "FRANK/operations/BLAS.h"
 
+#include "FRANK/classes/basic_dense.h"
+#include "FRANK/classes/basic_low_rank.h"
 #include "FRANK/classes/dense.h"
+#include "FRANK/classes/diagonal.h"
+#include "FRANK/classes/empty.h"
 #include "FRANK/classes/hierarchical.h"
+#include "FRANK/classes/identity.h"
 #include "FRANK/classes/low_rank.h"
 #include "FRANK/classes/matrix.h"
+#include "FRANK/classes/mixed_precision_low_rank.h"
+#include "FRANK/classes/out_of_core_hierarchical.h"
+#include "FRANK/classes/permuted_hierarchical.h"
 #include "FRANK/operations/arithmetic.h"
 #include "FRANK/operations/BLAS.h"
 #include "FRANK/operations/misc.h"
+#include "FRANK/operations/small_kernels.h"
 #include "FRANK/util/omm_error_handler.h"
 #include "FRANK/util/timer.h"
 
@@ -20,14 +29,126 @@ using yorel::yomm2::virtual_;
 #include <lapacke.h>
 #endif
 
+#include <algorithm>
+#include <array>
 #include <cassert>
+#include <complex>
 #include <cstdint>
 #include <cstdlib>
+#include <vector>
 
 
 namespace FRANK
 {
 
+// C = beta*C + alpha*D*op(B) (side == Side::Left) or
+// C = beta*C + alpha*op(B)*D (side == Side::Right), where D is diagonal. The
+// identity is passed as D == nullptr. Only axpy updates are used, so no
+// temporary is allocated and the cost is O(m*n).
+void diagonal_scaled_addition(
+  const Diagonal* D, const Dense& B, Dense& C,
+  const double alpha, const double beta, const bool TransB, const Side side
+) {
+  if (beta == 0) {
+    C = 0.0;
+  } else if (beta != 1) {
+    C *= beta;
+  }
+  if (side == Side::Left) {
+    for (int64_t i=0; i<C.dim[0]; ++i) {
+      cblas_daxpy(
+        C.dim[1], D == nullptr ? alpha : alpha*D->diag[i],
+        &B + (TransB ? i : i*B.stride), TransB ? B.stride : 1,
+        &C + i*C.stride, 1
+      );
+    }
+  } else {
+    for (int64_t j=0; j<C.dim[1]; ++j) {
+      cblas_daxpy(
+        C.dim[0], D == nullptr ? alpha : alpha*D->diag[j],
+        &B + (TransB ? j*B.stride : j), TransB ? 1 : B.stride,
+        &C + j, C.stride
+      );
+    }
+  }
+}
+
+// C = beta*C, used when one of the factors is structurally zero
+void scale_gemm_output(Matrix& C, const double beta) {
+  if (beta == 0) {
+    zero_all(C);
+  } else if (beta != 1) {
+    C *= beta;
+  }
+}
+
+// Thread-local scratch space for the intermediate products of the LowRank
+// kernels below. Buffers only ever grow, so repeated products of blocks of
+// similar size do not allocate. Separate slots allow a kernel to keep several
+// intermediates alive at the same time.
+double* lowrank_workspace(const int slot, const int64_t size) {
+  thread_local std::array<std::vector<double>, 2> workspace;
+  if (static_cast<int64_t>(workspace[slot].size()) < size) {
+    workspace[slot].resize(size);
+  }
+  return workspace[slot].data();
+}
+
+// op(M) for a row-major matrix M stored at data with the given stride
+struct GemmFactor {
+  const double* data;
+  int64_t stride;
+  bool trans;
+};
+
+// C = alpha*op(A)*op(B) + beta*C for raw row-major C of size m x n
+void gemm_raw(
+  const int64_t m, const int64_t n, const int64_t k, const double alpha,
+  const GemmFactor& A, const GemmFactor& B,
+  const double beta, double* C, const int64_t ldc
+) {
+  if (m == 0 || n == 0) return;
+  cblas_dgemm(
+    CblasRowMajor,
+    A.trans?CblasTrans:CblasNoTrans, B.trans?CblasTrans:CblasNoTrans,
+    m, n, k,
+    alpha,
+    A.data, std::max<int64_t>(1, A.stride),
+    B.data, std::max<int64_t>(1, B.stride),
+    beta,
+    C, std::max<int64_t>(1, ldc)
+  );
+}
+
+// Factors {U, S, V} of op(A), i.e. {V^T, S^T, U^T} if A is transposed
+std::array<GemmFactor, 3> lowrank_factors(const LowRank& A, const bool trans) {
+  const GemmFactor U{&A.U, A.U.stride, trans};
+  const GemmFactor S{&A.S, A.S.stride, trans};
+  const GemmFactor V{&A.V, A.V.stride, trans};
+  if (trans) return {V, S, U};
+  return {U, S, V};
+}
+
+// alpha*op(A.S)*op(A.V)*op(B.U)*op(B.S), the rank(A) x rank(B) inner matrix
+// of the product of two LowRank matrices. Only the result is allocated.
+Dense lowrank_product_core(
+  const LowRank& A, const LowRank& B,
+  const double alpha, const bool TransA, const bool TransB
+) {
+  const std::array<GemmFactor, 3> FA = lowrank_factors(A, TransA);
+  const std::array<GemmFactor, 3> FB = lowrank_factors(B, TransB);
+  const int64_t k = TransA ? A.dim[0] : A.dim[1];
+  double* W = lowrank_workspace(0, A.rank*B.rank);
+  double* T = lowrank_workspace(1, A.rank*B.rank);
+  gemm_raw(A.rank, B.rank, k, alpha, FA[2], FB[0], 0, W, B.rank);
+  gemm_raw(A.rank, B.rank, A.rank, 1, FA[1], {W, B.rank, false}, 0, T, B.rank);
+  Dense out(A.rank, B.rank);
+  gemm_raw(
+    A.rank, B.rank, B.rank, 1, {T, B.rank, false}, FB[1], 0, &out, out.stride
+  );
+  return out;
+}
+
 declare_method(
   void, gemm_omm,
   (
@@ -47,7 +168,25 @@ void gemm(
     == (TransB ? get_n_cols(B) : get_n_rows(B))
   );
   assert((TransB ? get_n_rows(B) : get_n_cols(B)) == get_n_cols(C));
-  gemm_omm(A, B, C, alpha, beta, TransA, TransB);
+  const ResidentBlock A_resident(A), B_resident(B), C_resident(C, true);
+  gemm_omm(
+    A_resident.get(), B_resident.get(), C_resident.get(),
+    alpha, beta, TransA, TransB
+  );
+}
+
+void gemm(
+  const PermutedHierarchical& A, const Dense& B, Dense& C,
+  const double alpha, const double beta
+) {
+  assert(get_n_cols(A.A) == B.dim[0]);
+  Dense B_permuted(B.dim[0], B.dim[1]);
+  for (int64_t i=0; i<B.dim[0]; ++i) {
+    std::copy(&B(A.perm[i], 0), &B(A.perm[i], 0)+B.dim[1], &B_permuted(i, 0));
+  }
+  A.to_permuted(C);
+  gemm(A.A, B_permuted, C, alpha, beta);
+  A.to_original(C);
 }
 
 declare_method(
@@ -66,7 +205,8 @@ MatrixProxy gemm(
     (TransA ? get_n_rows(A) : get_n_cols(A))
     == (TransB ? get_n_cols(B) : get_n_rows(B))
   );
-  return gemm_omm(A, B, alpha, TransA, TransB);
+  const ResidentBlock A_resident(A), B_resident(B);
+  return gemm_omm(A_resident.get(), B_resident.get(), alpha, TransA, TransB);
 }
 
 define_method(
@@ -132,6 +272,7 @@ define_method(
   )
 ) {
   // D D D
+  if (small_gemm(A, B, C, alpha, beta, TransA, TransB)) return;
   const int64_t k = TransA ? A.dim[0] : A.dim[1];
   cblas_dgemm(
     CblasRowMajor,
@@ -154,11 +295,38 @@ define_method(
   )
 ) {
   // LR D D
-  const Dense AS_basis_B = gemm(
-    A.S, gemm(TransA ? A.U : A.V, B, alpha, TransA, TransB),
-    1, TransA, false
-  );
-  gemm(TransA ? A.V : A.U, AS_basis_B, C, 1, beta, TransA, false);
+  if (A.rank == 0) {
+    scale_gemm_output(C, beta);
+    return;
+  }
+  const std::array<GemmFactor, 3> FA = lowrank_factors(A, TransA);
+  const GemmFactor opB{&B, B.stride, TransB};
+  const int64_t m = C.dim[0], n = C.dim[1], r = A.rank;
+  const int64_t k = TransA ? A.dim[0] : A.dim[1];
+  // op(V)*op(B) always comes first. The rank x rank S is multiplied into
+  // whichever neighbour has the smallest outer dimension.
+  if (n <= std::min(m, k)) {
+    // U*(S*(V*B))
+    double* VB = lowrank_workspace(0, r*n);
+    double* SVB = lowrank_workspace(1, r*n);
+    gemm_raw(r, n, k, alpha, FA[2], opB, 0, VB, n);
+    gemm_raw(r, n, r, 1, FA[1], {VB, n, false}, 0, SVB, n);
+    gemm_raw(m, n, r, 1, FA[0], {SVB, n, false}, beta, &C, C.stride);
+  } else if (k <= m) {
+    // U*((S*V)*B)
+    double* SV = lowrank_workspace(0, r*k);
+    double* SVB = lowrank_workspace(1, r*n);
+    gemm_raw(r, k, r, alpha, FA[1], FA[2], 0, SV, k);
+    gemm_raw(r, n, k, 1, {SV, k, false}, opB, 0, SVB, n);
+    gemm_raw(m, n, r, 1, FA[0], {SVB, n, false}, beta, &C, C.stride);
+  } else {
+    // (U*S)*(V*B)
+    double* US = lowrank_workspace(0, m*r);
+    double* VB = lowrank_workspace(1, r*n);
+    gemm_raw(m, r, r, alpha, FA[0], FA[1], 0, US, r);
+    gemm_raw(r, n, k, 1, FA[2], opB, 0, VB, n);
+    gemm_raw(m, n, r, 1, {US, r, false}, {VB, n, false}, beta, &C, C.stride);
+  }
 }
 
 define_method(
@@ -170,11 +338,38 @@ define_method(
   )
 ) {
   // D LR D
-  const Dense A_basis_BS = gemm(
-    gemm(A, TransB ? B.V : B.U, alpha, TransA, TransB), B.S,
-    1, false, TransB
-  );
-  gemm(A_basis_BS, TransB ? B.U : B.V, C, 1, beta, false, TransB);
+  if (B.rank == 0) {
+    scale_gemm_output(C, beta);
+    return;
+  }
+  const GemmFactor opA{&A, A.stride, TransA};
+  const std::array<GemmFactor, 3> FB = lowrank_factors(B, TransB);
+  const int64_t m = C.dim[0], n = C.dim[1], r = B.rank;
+  const int64_t k = TransA ? A.dim[0] : A.dim[1];
+  // op(A)*op(U) always comes first. The rank x rank S is multiplied into
+  // whichever neighbour has the smallest outer dimension.
+  if (m <= std::min(k, n)) {
+    // ((A*U)*S)*V
+    double* AU = lowrank_workspace(0, m*r);
+    double* AUS = lowrank_workspace(1, m*r);
+    gemm_raw(m, r, k, alpha, opA, FB[0], 0, AU, r);
+    gemm_raw(m, r, r, 1, {AU, r, false}, FB[1], 0, AUS, r);
+    gemm_raw(m, n, r, 1, {AUS, r, false}, FB[2], beta, &C, C.stride);
+  } else if (k <= n) {
+    // (A*(U*S))*V
+    double* US = lowrank_workspace(0, k*r);
+    double* AUS = lowrank_workspace(1, m*r);
+    gemm_raw(k, r, r, 1, FB[0], FB[1], 0, US, r);
+    gemm_raw(m, r, k, alpha, opA, {US, r, false}, 0, AUS, r);
+    gemm_raw(m, n, r, 1, {AUS, r, false}, FB[2], beta, &C, C.stride);
+  } else {
+    // (A*U)*(S*V)
+    double* AU = lowrank_workspace(0, m*r);
+    double* SV = lowrank_workspace(1, r*n);
+    gemm_raw(m, r, k, alpha, opA, FB[0], 0, AU, r);
+    gemm_raw(r, n, r, 1, FB[1], FB[2], 0, SV, n);
+    gemm_raw(m, n, r, 1, {AU, r, false}, {SV, n, false}, beta, &C, C.stride);
+  }
 }
 
 define_method(
@@ -186,17 +381,32 @@ define_method(
   )
 ) {
   // LR LR D
-  // TODO Many optimizations possible
-  // Even in non-shared case, UxS, SxV may be optimized across blocks!
-  const Dense Abasis_inner_matrices = gemm(
-    TransA ? A.V : A.U, gemm(
-      gemm(
-        A.S, gemm(TransA ? A.U : A.V, TransB ? B.V : B.U, alpha, TransA, TransB),
-        1, TransA, false
-      ), B.S, 1, false, TransB
-    ), 1, TransA, false
-  );
-  gemm(Abasis_inner_matrices, TransB ? B.U : B.V, C, 1, beta, false, TransB);
+  // TODO Even in non-shared case, UxS, SxV may be optimized across blocks!
+  if (A.rank == 0 || B.rank == 0) {
+    scale_gemm_output(C, beta);
+    return;
+  }
+  const std::array<GemmFactor, 3> FA = lowrank_factors(A, TransA);
+  const std::array<GemmFactor, 3> FB = lowrank_factors(B, TransB);
+  const int64_t m = C.dim[0], n = C.dim[1], ra = A.rank, rb = B.rank;
+  const int64_t k = TransA ? A.dim[0] : A.dim[1];
+  // M = S_A*(V_A*U_B)*S_B is rank(A) x rank(B)
+  double* M = lowrank_workspace(0, ra*rb);
+  double* T = lowrank_workspace(1, ra*rb);
+  gemm_raw(ra, rb, k, alpha, FA[2], FB[0], 0, M, rb);
+  gemm_raw(ra, rb, ra, 1, FA[1], {M, rb, false}, 0, T, rb);
+  gemm_raw(ra, rb, rb, 1, {T, rb, false}, FB[1], 0, M, rb);
+  if (m*rb*(ra+n) <= n*ra*(rb+m)) {
+    // (U_A*M)*V_B
+    double* UM = lowrank_workspace(1, m*rb);
+    gemm_raw(m, rb, ra, 1, FA[0], {M, rb, false}, 0, UM, rb);
+    gemm_raw(m, n, rb, 1, {UM, rb, false}, FB[2], beta, &C, C.stride);
+  } else {
+    // U_A*(M*V_B)
+    double* MV = lowrank_workspace(1, ra*n);
+    gemm_raw(ra, n, rb, 1, {M, rb, false}, FB[2], 0, MV, n);
+    gemm_raw(m, n, ra, 1, FA[0], {MV, n, false}, beta, &C, C.stride);
+  }
 }
 
 define_method(
@@ -260,11 +470,7 @@ define_method(
 ) {
   // LR LR LR
   const Dense AxB_U = TransA ? transpose(A.V) : shallow_copy(A.U);
-  const Dense AxB_S = gemm(
-      gemm(A.S, TransA ? A.U : A.V, 1, TransA, TransA),
-      gemm(TransB ? B.V : B.U, B.S, 1, TransB, TransB),
-      alpha
-  );
+  const Dense AxB_S = lowrank_product_core(A, B, alpha, TransA, TransB);
   const Dense AxB_V = TransB ? transpose(B.U) : shallow_copy(B.V);
   const LowRank AxB(AxB_U, AxB_S, AxB_V, false);
   C *= beta;
@@ -381,11 +587,7 @@ define_method(
 ) {
   // LR LR H
   const Dense AxB_U = TransA ? transpose(A.V) : shallow_copy(A.U);
-  const Dense AxB_S = gemm(
-      gemm(A.S, TransA ? A.U : A.V, 1, TransA, TransA),
-      gemm(TransB ? B.V : B.U, B.S, 1, TransB, TransB),
-      alpha
-  );
+  const Dense AxB_S = lowrank_product_core(A, B, alpha, TransA, TransB);
   const Dense AxB_V = TransB ? transpose(B.U) : shallow_copy(B.V);
   const LowRank AxB(AxB_U, AxB_S, AxB_V, false);
   C *= beta;
@@ -614,14 +816,1056 @@ define_method(
   }
 }
 
-// Fallback default, abort with error message
 define_method(
   void, gemm_omm,
-  (const Matrix& A, const Matrix& B, Matrix& C,
-   const double, const double, const bool, const bool)
+  (
+    [[maybe_unused]] const Identity& A, const Dense& B, Dense& C,
+    const double alpha, const double beta,
+    const bool, const bool TransB
+  )
 ) {
-  omm_error_handler("gemm", {A, B, C}, __FILE__, __LINE__);
-  std::abort();
+  // I D D
+  assert(A.dim[0] == C.dim[0]);
+  diagonal_scaled_addition(nullptr, B, C, alpha, beta, TransB, Side::Left);
+}
+
+define_method(
+  void, gemm_omm,
+  (
+    const Dense& A, [[maybe_unused]] const Identity& B, Dense& C,
+    const double alpha, const double beta,
+    const bool TransA, const bool
+  )
+) {
+  // D I D
+  assert(B.dim[1] == C.dim[1]);
+  diagonal_scaled_addition(nullptr, A, C, alpha, beta, TransA, Side::Right);
+}
+
+define_method(
+  void, gemm_omm,
+  (
+    const Diagonal& A, const Dense& B, Dense& C,
+    const double alpha, const double beta,
+    const bool, const bool TransB
+  )
+) {
+  // Diag D D
+  assert(A.dim[0] == C.dim[0]);
+  diagonal_scaled_addition(&A, B, C, alpha, beta, TransB, Side::Left);
+}
+
+define_method(
+  void, gemm_omm,
+  (
+    const Dense& A, const Diagonal& B, Dense& C,
+    const double alpha, const double beta,
+    const bool TransA, const bool
+  )
+) {
+  // D Diag D
+  assert(B.dim[1] == C.dim[1]);
+  diagonal_scaled_addition(&B, A, C, alpha, beta, TransA, Side::Right);
+}
+
+define_method(
+  void, gemm_omm,
+  (
+    [[maybe_unused]] const Identity& A, const LowRank& B, Dense& C,
+    const double alpha, const double beta,
+    const bool, const bool TransB
+  )
+) {
+  // I LR D
+  assert(A.dim[0] == C.dim[0]);
+  const Dense SV = gemm(B.S, TransB ? B.U : B.V, alpha, TransB, TransB);
+  gemm(TransB ? B.V : B.U, SV, C, 1, beta, TransB, false);
+}
+
+define_method(
+  void, gemm_omm,
+  (
+    const LowRank& A, [[maybe_unused]] const Identity& B, Dense& C,
+    const double alpha, const double beta,
+    const bool TransA, const bool
+  )
+) {
+  // LR I D
+  assert(B.dim[1] == C.dim[1]);
+  const Dense SV = gemm(A.S, TransA ? A.U : A.V, alpha, TransA, TransA);
+  gemm(TransA ? A.V : A.U, SV, C, 1, beta, TransA, false);
+}
+
+define_method(
+  void, gemm_omm,
+  (
+    [[maybe_unused]] const Identity& A, const Dense& B, LowRank& C,
+    const double alpha, const double beta,
+    const bool, const bool TransB
+  )
+) {
+  // I D LR
+  assert(A.dim[0] == C.dim[0]);
+  Dense AxB = TransB ? transpose(B) : MatrixProxy(B);
+  AxB *= alpha;
+  C.S *= beta;
+  const bool use_eps = (C.eps != 0.0);
+  if(use_eps)
+    C += LowRank(AxB, C.eps);
+  else
+    C += LowRank(AxB, C.rank);
+}
+
+define_method(
+  void, gemm_omm,
+  (
+    const Dense& A, [[maybe_unused]] const Identity& B, LowRank& C,
+    const double alpha, const double beta,
+    const bool TransA, const bool
+  )
+) {
+  // D I LR
+  assert(B.dim[1] == C.dim[1]);
+  Dense AxB = TransA ? transpose(A) : MatrixProxy(A);
+  AxB *= alpha;
+  C.S *= beta;
+  const bool use_eps = (C.eps != 0.0);
+  if(use_eps)
+    C += LowRank(AxB, C.eps);
+  else
+    C += LowRank(AxB, C.rank);
+}
+
+define_method(
+  void, gemm_omm,
+  (
+    [[maybe_unused]] const Identity& A, const LowRank& B, LowRank& C,
+    const double alpha, const double beta,
+    const bool, const bool TransB
+  )
+) {
+  // I LR LR
+  assert(A.dim[0] == C.dim[0]);
+  const Dense AxB_U = TransB ? transpose(B.V) : shallow_copy(B.U);
+  Dense AxB_S = TransB ? transpose(B.S) : MatrixProxy(B.S);
+  AxB_S *= alpha;
+  const Dense AxB_V = TransB ? transpose(B.U) : shallow_copy(B.V);
+  const LowRank AxB(AxB_U, AxB_S, AxB_V, false);
+  C *= beta;
+  C += AxB;
+}
+
+define_method(
+  void, gemm_omm,
+  (
+    const LowRank& A, [[maybe_unused]] const Identity& B, LowRank& C,
+    const double alpha, const double beta,
+    const bool TransA, const bool
+  )
+) {
+  // LR I LR
+  assert(B.dim[1] == C.dim[1]);
+  const Dense AxB_U = TransA ? transpose(A.V) : shallow_copy(A.U);
+  Dense AxB_S = TransA ? transpose(A.S) : MatrixProxy(A.S);
+  AxB_S *= alpha;
+  const Dense AxB_V = TransA ? transpose(A.U) : shallow_copy(A.V);
+  const LowRank AxB(AxB_U, AxB_S, AxB_V, false);
+  C *= beta;
+  C += AxB;
+}
+
+// Products with Identity and a Hierarchical operand reduce to
+// C = beta*C + alpha*op(X), computed block by block where X is the other factor
+define_method(
+  void, gemm_omm,
+  (
+    const Identity& A, const Hierarchical& B, Hierarchical& C,
+    const double alpha, const double beta,
+    const bool, const bool TransB
+  )
+) {
+  // I H H
+  assert(A.dim[0] == C.dim[0]);
+  if (B.dim[TransB ? 1 : 0] != C.dim[0] || B.dim[TransB ? 0 : 1] != C.dim[1]) {
+    // Different subdivision, add the dense product into the blocks of C
+    gemm(A, Dense(B), C, alpha, beta, false, TransB);
+    return;
+  }
+  for (int64_t i=0; i<C.dim[0]; i++) {
+    for (int64_t j=0; j<C.dim[1]; j++) {
+      gemm(
+        Identity(get_n_rows(C(i, j))), TransB ? B(j, i) : B(i, j), C(i, j),
+        alpha, beta, false, TransB
+      );
+    }
+  }
+}
+
+define_method(
+  void, gemm_omm,
+  (
+    const Hierarchical& A, const Identity& B, Hierarchical& C,
+    const double alpha, const double beta,
+    const bool TransA, const bool
+  )
+) {
+  // H I H
+  assert(B.dim[1] == C.dim[1]);
+  gemm(Identity(C.dim[0]), A, C, alpha, beta, false, TransA);
+}
+
+define_method(
+  void, gemm_omm,
+  (
+    const Identity& A, const Dense& B, Hierarchical& C,
+    const double alpha, const double beta,
+    const bool, const bool TransB
+  )
+) {
+  // I D H
+  assert(A.dim[0] == C.dim[0]);
+  const Dense AxB = TransB ? transpose(B) : shallow_copy(B);
+  const Hierarchical AxBH = split(AxB, C);
+  for (int64_t i=0; i<C.dim[0]; i++) {
+    for (int64_t j=0; j<C.dim[1]; j++) {
+      gemm(
+        Identity(get_n_rows(C(i, j))), AxBH(i, j), C(i, j), alpha, beta
+      );
+    }
+  }
+}
+
+define_method(
+  void, gemm_omm,
+  (
+    const Dense& A, const Identity& B, Hierarchical& C,
+    const double alpha, const double beta,
+    const bool TransA, const bool
+  )
+) {
+  // D I H
+  assert(B.dim[1] == C.dim[1]);
+  gemm(Identity(C.dim[0]), A, C, alpha, beta, false, TransA);
+}
+
+define_method(
+  void, gemm_omm,
+  (
+    const Identity& A, const LowRank& B, Hierarchical& C,
+    const double alpha, const double beta,
+    const bool, const bool TransB
+  )
+) {
+  // I LR H
+  assert(A.dim[0] == C.dim[0]);
+  LowRank AxB = TransB ? transpose(B) : MatrixProxy(B);
+  AxB *= alpha;
+  C *= beta;
+  C += AxB;
+}
+
+define_method(
+  void, gemm_omm,
+  (
+    const LowRank& A, const Identity& B, Hierarchical& C,
+    const double alpha, const double beta,
+    const bool TransA, const bool
+  )
+) {
+  // LR I H
+  assert(B.dim[1] == C.dim[1]);
+  gemm(Identity(C.dim[0]), A, C, alpha, beta, false, TransA);
+}
+
+define_method(
+  void, gemm_omm,
+  (
+    const Identity& A, const Hierarchical& B, Dense& C,
+    const double alpha, const double beta,
+    const bool, const bool TransB
+  )
+) {
+  // I H D
+  assert(A.dim[0] == C.dim[0]);
+  if (TransB) {
+    gemm(A, Hierarchical(transpose(B)), C, alpha, beta);
+    return;
+  }
+  Hierarchical CH = split(C, B);
+  gemm(A, B, CH, alpha, beta);
+}
+
+define_method(
+  void, gemm_omm,
+  (
+    const Hierarchical& A, const Identity& B, Dense& C,
+    const double alpha, const double beta,
+    const bool TransA, const bool
+  )
+) {
+  // H I D
+  assert(B.dim[1] == C.dim[1]);
+  gemm(Identity(C.dim[0]), A, C, alpha, beta, false, TransA);
+}
+
+define_method(
+  void, gemm_omm,
+  (
+    const Identity& A, const Hierarchical& B, LowRank& C,
+    const double alpha, const double beta,
+    const bool, const bool TransB
+  )
+) {
+  // I H LR
+  assert(A.dim[0] == C.dim[0]);
+  gemm(A, Dense(B), C, alpha, beta, false, TransB);
+}
+
+define_method(
+  void, gemm_omm,
+  (
+    const Hierarchical& A, const Identity& B, LowRank& C,
+    const double alpha, const double beta,
+    const bool TransA, const bool
+  )
+) {
+  // H I LR
+  assert(B.dim[1] == C.dim[1]);
+  gemm(Identity(C.dim[0]), A, C, alpha, beta, false, TransA);
+}
+
+define_method(
+  void, gemm_omm,
+  (
+    const Empty&, const Matrix&, Matrix& C,
+    const double, const double beta, const bool, const bool
+  )
+) {
+  // E * *
+  scale_gemm_output(C, beta);
+}
+
+define_method(
+  void, gemm_omm,
+  (
+    const Matrix&, const Empty&, Matrix& C,
+    const double, const double beta, const bool, const bool
+  )
+) {
+  // * E *
+  scale_gemm_output(C, beta);
+}
+
+// The following resolve ambiguities between the Empty specializations above
+// and the splitting specializations for Hierarchical operands
+define_method(
+  void, gemm_omm,
+  (
+    const Empty&, const Empty&, Matrix& C,
+    const double, const double beta, const bool, const bool
+  )
+) {
+  // E E *
+  scale_gemm_output(C, beta);
+}
+
+define_method(
+  void, gemm_omm,
+  (
+    const Empty&, const Hierarchical&, Hierarchical& C,
+    const double, const double beta, const bool, const bool
+  )
+) {
+  // E H H
+  scale_gemm_output(C, beta);
+}
+
+define_method(
+  void, gemm_omm,
+  (
+    const Hierarchical&, const Empty&, Hierarchical& C,
+    const double, const double beta, const bool, const bool
+  )
+) {
+  // H E H
+  scale_gemm_output(C, beta);
+}
+
+define_method(
+  void, gemm_omm,
+  (
+    const Empty&, const Hierarchical&, Dense& C,
+    const double, const double beta, const bool, const bool
+  )
+) {
+  // E H D
+  scale_gemm_output(C, beta);
+}
+
+define_method(
+  void, gemm_omm,
+  (
+    const Hierarchical&, const Empty&, Dense& C,
+    const double, const double beta, const bool, const bool
+  )
+) {
+  // H E D
+  scale_gemm_output(C, beta);
+}
+
+define_method(
+  void, gemm_omm,
+  (
+    const MixedPrecisionLowRank& A, const Dense& B, Dense& C,
+    const double alpha, const double beta,
+    const bool TransA, const bool TransB
+  )
+) {
+  // MPLR D D
+  A.multiply_right(B, C, alpha, beta, TransA, TransB);
+}
+
+define_method(
+  void, gemm_omm,
+  (
+    const Dense& A, const MixedPrecisionLowRank& B, Dense& C,
+    const double alpha, const double beta,
+    const bool TransA, const bool TransB
+  )
+) {
+  // D MPLR D
+  B.multiply_left(A, C, alpha, beta, TransA, TransB);
+}
+
+define_method(
+  void, gemm_omm,
+  (
+    const MixedPrecisionLowRank& A, const LowRank& B, Dense& C,
+    const double alpha, const double beta,
+    const bool TransA, const bool TransB
+  )
+) {
+  // MPLR LR D
+  if (B.rank == 0) {
+    scale_gemm_output(C, beta);
+    return;
+  }
+  Dense AxU(C.dim[0], B.rank);
+  A.multiply_right(TransB ? B.V : B.U, AxU, alpha, 0, TransA, TransB);
+  gemm(
+    gemm(AxU, B.S, 1, false, TransB), TransB ? B.U : B.V, C,
+    1, beta, false, TransB
+  );
+}
+
+define_method(
+  void, gemm_omm,
+  (
+    const LowRank& A, const MixedPrecisionLowRank& B, Dense& C,
+    const double alpha, const double beta,
+    const bool TransA, const bool TransB
+  )
+) {
+  // LR MPLR D
+  if (A.rank == 0) {
+    scale_gemm_output(C, beta);
+    return;
+  }
+  Dense VxB(A.rank, C.dim[1]);
+  B.multiply_left(TransA ? A.U : A.V, VxB, alpha, 0, TransA, TransB);
+  gemm(gemm(TransA ? A.V : A.U, A.S, 1, TransA, TransA), VxB, C, 1, beta);
+}
+
+define_method(
+  void, gemm_omm,
+  (
+    const MixedPrecisionLowRank& A, const Dense& B, LowRank& C,
+    const double alpha, const double beta,
+    const bool TransA, const bool TransB
+  )
+) {
+  // MPLR D LR
+  C *= beta;
+  C += A.multiply_right(B, alpha, TransA, TransB);
+}
+
+define_method(
+  void, gemm_omm,
+  (
+    const Dense& A, const MixedPrecisionLowRank& B, LowRank& C,
+    const double alpha, const double beta,
+    const bool TransA, const bool TransB
+  )
+) {
+  // D MPLR LR
+  C *= beta;
+  C += B.multiply_left(A, alpha, TransA, TransB);
+}
+
+define_method(
+  void, gemm_omm,
+  (
+    const MixedPrecisionLowRank& A, const LowRank& B, LowRank& C,
+    const double alpha, const double beta,
+    const bool TransA, const bool TransB
+  )
+) {
+  // MPLR LR LR
+  Dense AxB_U(C.dim[0], B.rank);
+  A.multiply_right(TransB ? B.V : B.U, AxB_U, alpha, 0, TransA, TransB);
+  const Dense AxB_S = TransB ? transpose(B.S) : shallow_copy(B.S);
+  const Dense AxB_V = TransB ? transpose(B.U) : shallow_copy(B.V);
+  const LowRank AxB(AxB_U, AxB_S, AxB_V, false);
+  C *= beta;
+  C += AxB;
+}
+
+define_method(
+  void, gemm_omm,
+  (
+    const LowRank& A, const MixedPrecisionLowRank& B, LowRank& C,
+    const double alpha, const double beta,
+    const bool TransA, const bool TransB
+  )
+) {
+  // LR MPLR LR
+  const Dense AxB_U = TransA ? transpose(A.V) : shallow_copy(A.U);
+  const Dense AxB_S = TransA ? transpose(A.S) : shallow_copy(A.S);
+  Dense AxB_V(A.rank, C.dim[1]);
+  B.multiply_left(TransA ? A.U : A.V, AxB_V, alpha, 0, TransA, TransB);
+  const LowRank AxB(AxB_U, AxB_S, AxB_V, false);
+  C *= beta;
+  C += AxB;
+}
+
+define_method(
+  void, gemm_omm,
+  (
+    const MixedPrecisionLowRank& A, const Hierarchical& B, LowRank& C,
+    const double alpha, const double beta,
+    const bool TransA, const bool TransB
+  )
+) {
+  // MPLR H LR
+  const Hierarchical HA = split(A,
+                                TransA ? B.dim[TransB ? 1 : 0] : 1,
+                                TransA ? 1 : B.dim[TransB ? 1 : 0],
+                                false);
+  gemm(HA, B, C, alpha, beta, TransA, TransB);
+}
+
+define_method(
+  void, gemm_omm,
+  (
+    const Hierarchical& A, const MixedPrecisionLowRank& B, LowRank& C,
+    const double alpha, const double beta,
+    const bool TransA, const bool TransB
+  )
+) {
+  // H MPLR LR
+  const Hierarchical HB = split(B,
+                          TransB ? 1 : A.dim[TransA ? 0 : 1],
+                          TransB ? A.dim[TransA ? 0 : 1] : 1,
+                          false);
+  gemm(A, HB, C, alpha, beta, TransA, TransB);
+}
+
+define_method(
+  void, gemm_omm,
+  (
+    const MixedPrecisionLowRank& A, const Dense& B, Hierarchical& C,
+    const double alpha, const double beta,
+    const bool TransA, const bool TransB
+  )
+) {
+  // MPLR D H
+  C *= beta;
+  C += A.multiply_right(B, alpha, TransA, TransB);
+}
+
+define_method(
+  void, gemm_omm,
+  (
+    const Dense& A, const MixedPrecisionLowRank& B, Hierarchical& C,
+    const double alpha, const double beta,
+    const bool TransA, const bool TransB
+  )
+) {
+  // D MPLR H
+  C *= beta;
+  C += B.multiply_left(A, alpha, TransA, TransB);
+}
+
+define_method(
+  void, gemm_omm,
+  (
+    const MixedPrecisionLowRank& A, const LowRank& B, Hierarchical& C,
+    const double alpha, const double beta,
+    const bool TransA, const bool TransB
+  )
+) {
+  // MPLR LR H
+  Dense AxB_U(get_n_rows(C), B.rank);
+  A.multiply_right(TransB ? B.V : B.U, AxB_U, alpha, 0, TransA, TransB);
+  const Dense AxB_S = TransB ? transpose(B.S) : shallow_copy(B.S);
+  const Dense AxB_V = TransB ? transpose(B.U) : shallow_copy(B.V);
+  const LowRank AxB(AxB_U, AxB_S, AxB_V, false);
+  C *= beta;
+  C += AxB;
+}
+
+define_method(
+  void, gemm_omm,
+  (
+    const LowRank& A, const MixedPrecisionLowRank& B, Hierarchical& C,
+    const double alpha, const double beta,
+    const bool TransA, const bool TransB
+  )
+) {
+  // LR MPLR H
+  const Dense AxB_U = TransA ? transpose(A.V) : shallow_copy(A.U);
+  const Dense AxB_S = TransA ? transpose(A.S) : shallow_copy(A.S);
+  Dense AxB_V(A.rank, get_n_cols(C));
+  B.multiply_left(TransA ? A.U : A.V, AxB_V, alpha, 0, TransA, TransB);
+  const LowRank AxB(AxB_U, AxB_S, AxB_V, false);
+  C *= beta;
+  C += AxB;
+}
+
+// Fallback default, abort with error message
+define_method(
+  void, gemm_omm,
+  (const Matrix& A, const Matrix& B, Matrix& C,
+   const double, const double, const bool, const bool)
+) {
+  omm_error_handler("gemm", {A, B, C}, __FILE__, __LINE__);
+  std::abort();
+}
+
+// Scalar type specific BLAS routines for BasicDense
+void basic_gemm(
+  const bool TransA, const bool TransB,
+  const int64_t m, const int64_t n, const int64_t k,
+  const float alpha, const float* A, const int64_t lda,
+  const float* B, const int64_t ldb,
+  const float beta, float* C, const int64_t ldc
+) {
+  cblas_sgemm(
+    CblasRowMajor,
+    TransA?CblasTrans:CblasNoTrans, TransB?CblasTrans:CblasNoTrans,
+    m, n, k, alpha, A, lda, B, ldb, beta, C, ldc
+  );
+}
+
+void basic_gemm(
+  const bool TransA, const bool TransB,
+  const int64_t m, const int64_t n, const int64_t k,
+  const std::complex<float> alpha, const std::complex<float>* A, const int64_t lda,
+  const std::complex<float>* B, const int64_t ldb,
+  const std::complex<float> beta, std::complex<float>* C, const int64_t ldc
+) {
+  cblas_cgemm(
+    CblasRowMajor,
+    TransA?CblasTrans:CblasNoTrans, TransB?CblasTrans:CblasNoTrans,
+    m, n, k, &alpha, A, lda, B, ldb, &beta, C, ldc
+  );
+}
+
+void basic_gemm(
+  const bool TransA, const bool TransB,
+  const int64_t m, const int64_t n, const int64_t k,
+  const std::complex<double> alpha, const std::complex<double>* A, const int64_t lda,
+  const std::complex<double>* B, const int64_t ldb,
+  const std::complex<double> beta, std::complex<double>* C, const int64_t ldc
+) {
+  cblas_zgemm(
+    CblasRowMajor,
+    TransA?CblasTrans:CblasNoTrans, TransB?CblasTrans:CblasNoTrans,
+    m, n, k, &alpha, A, lda, B, ldb, &beta, C, ldc
+  );
+}
+
+template<typename T>
+void gemm(
+  const BasicDense<T>& A, const BasicDense<T>& B, BasicDense<T>& C,
+  const typename BasicDense<T>::value_type alpha,
+  const typename BasicDense<T>::value_type beta,
+  const bool TransA, const bool TransB
+) {
+  const int64_t k = TransA ? A.dim[0] : A.dim[1];
+  assert(C.dim[0] == (TransA ? A.dim[1] : A.dim[0]));
+  assert(C.dim[1] == (TransB ? B.dim[0] : B.dim[1]));
+  assert(k == (TransB ? B.dim[1] : B.dim[0]));
+  if (C.dim[0] == 0 || C.dim[1] == 0) return;
+  basic_gemm(
+    TransA, TransB, C.dim[0], C.dim[1], k,
+    alpha, &A, std::max<int64_t>(1, A.stride),
+    &B, std::max<int64_t>(1, B.stride),
+    beta, &C, C.stride
+  );
+}
+
+template<typename T>
+BasicDense<T> gemm(
+  const BasicDense<T>& A, const BasicDense<T>& B,
+  const typename BasicDense<T>::value_type alpha,
+  const bool TransA, const bool TransB
+) {
+  BasicDense<T> C(
+    TransA ? A.dim[1] : A.dim[0], TransB ? B.dim[0] : B.dim[1]
+  );
+  gemm(A, B, C, alpha, T(0), TransA, TransB);
+  return C;
+}
+
+template void gemm(
+  const SDense&, const SDense&, SDense&,
+  const float, const float, const bool, const bool
+);
+template void gemm(
+  const CDense&, const CDense&, CDense&,
+  const std::complex<float>, const std::complex<float>, const bool, const bool
+);
+template void gemm(
+  const ZDense&, const ZDense&, ZDense&,
+  const std::complex<double>, const std::complex<double>, const bool, const bool
+);
+template SDense gemm(
+  const SDense&, const SDense&, const float, const bool, const bool
+);
+template CDense gemm(
+  const CDense&, const CDense&, const std::complex<float>, const bool, const bool
+);
+template ZDense gemm(
+  const ZDense&, const ZDense&, const std::complex<double>, const bool, const bool
+);
+
+// Scalar passed through basic_gemm_omm, converted back to the scalar type of
+// the blocks
+float basic_scalar(const std::complex<double> alpha, float) {
+  return alpha.real();
+}
+
+template<typename U>
+std::complex<U> basic_scalar(
+  const std::complex<double> alpha, std::complex<U>
+) {
+  return std::complex<U>(alpha);
+}
+
+// C[row:row+m, :] += alpha * A * B[col:col+k, :] for a block A of a
+// Hierarchical matrix, where row and col are the offsets of A
+declare_method(
+  void, basic_gemm_omm,
+  (
+    virtual_<const Matrix&>, virtual_<const Matrix&>, virtual_<Matrix&>,
+    const int64_t, const int64_t, const std::complex<double>
+  )
+)
+
+template<typename T>
+void gemm(
+  const Hierarchical& A, const BasicDense<T>& B, BasicDense<T>& C,
+  const typename BasicDense<T>::value_type alpha,
+  const typename BasicDense<T>::value_type beta
+) {
+  assert(get_n_rows(A) == C.dim[0]);
+  assert(get_n_cols(A) == B.dim[0]);
+  assert(B.dim[1] == C.dim[1]);
+  // Scale C once, the blocks then only accumulate into it
+  if (beta != T(1)) {
+    for (int64_t i=0; i<C.dim[0]; ++i) {
+      T* c = &C + i*C.stride;
+      if (beta == T(0)) std::fill(c, c + C.dim[1], T(0));
+      else for (int64_t j=0; j<C.dim[1]; ++j) c[j] *= beta;
+    }
+  }
+  basic_gemm_omm(A, B, C, 0, 0, alpha);
+}
+
+template void gemm(
+  const Hierarchical&, const SDense&, SDense&, const float, const float
+);
+template void gemm(
+  const Hierarchical&, const CDense&, CDense&,
+  const std::complex<float>, const std::complex<float>
+);
+template void gemm(
+  const Hierarchical&, const ZDense&, ZDense&,
+  const std::complex<double>, const std::complex<double>
+);
+
+template<typename T>
+void hierarchical_basic_gemm(
+  const Hierarchical& A, const BasicDense<T>& B, BasicDense<T>& C,
+  const int64_t row, const int64_t col, const std::complex<double> alpha
+) {
+  int64_t row_i = row;
+  for (int64_t i=0; i<A.dim[0]; ++i) {
+    int64_t col_j = col;
+    for (int64_t j=0; j<A.dim[1]; ++j) {
+      basic_gemm_omm(A(i, j), B, C, row_i, col_j, alpha);
+      col_j += get_n_cols(A(i, j));
+    }
+    row_i += get_n_rows(A(i, 0));
+  }
+}
+
+template<typename T>
+void dense_basic_gemm(
+  const BasicDense<T>& A, const BasicDense<T>& B, BasicDense<T>& C,
+  const int64_t row, const int64_t col, const std::complex<double> alpha
+) {
+  if (A.dim[0] == 0 || A.dim[1] == 0 || C.dim[1] == 0) return;
+  basic_gemm(
+    false, false, A.dim[0], C.dim[1], A.dim[1],
+    basic_scalar(alpha, T()), &A, A.stride,
+    &B + col*B.stride, B.stride,
+    T(1), &C + row*C.stride, C.stride
+  );
+}
+
+template<typename T>
+void low_rank_basic_gemm(
+  const BasicLowRank<T>& A, const BasicDense<T>& B, BasicDense<T>& C,
+  const int64_t row, const int64_t col, const std::complex<double> alpha
+) {
+  if (C.dim[1] == 0) return;
+  BasicDense<T> VB(A.rank, C.dim[1]), SVB(A.rank, C.dim[1]);
+  basic_gemm(
+    false, false, A.rank, C.dim[1], A.dim[1],
+    T(1), &A.V, A.V.stride, &B + col*B.stride, B.stride,
+    T(0), &VB, VB.stride
+  );
+  gemm(A.S, VB, SVB, T(1), T(0));
+  basic_gemm(
+    false, false, A.dim[0], C.dim[1], A.rank,
+    basic_scalar(alpha, T()), &A.U, A.U.stride, &SVB, SVB.stride,
+    T(1), &C + row*C.stride, C.stride
+  );
+}
+
+define_method(
+  void, basic_gemm_omm,
+  (
+    const Hierarchical& A, const SDense& B, SDense& C,
+    const int64_t row, const int64_t col, const std::complex<double> alpha
+  )
+) {
+  hierarchical_basic_gemm(A, B, C, row, col, alpha);
+}
+
+define_method(
+  void, basic_gemm_omm,
+  (
+    const Hierarchical& A, const CDense& B, CDense& C,
+    const int64_t row, const int64_t col, const std::complex<double> alpha
+  )
+) {
+  hierarchical_basic_gemm(A, B, C, row, col, alpha);
+}
+
+define_method(
+  void, basic_gemm_omm,
+  (
+    const Hierarchical& A, const ZDense& B, ZDense& C,
+    const int64_t row, const int64_t col, const std::complex<double> alpha
+  )
+) {
+  hierarchical_basic_gemm(A, B, C, row, col, alpha);
+}
+
+define_method(
+  void, basic_gemm_omm,
+  (
+    const SDense& A, const SDense& B, SDense& C,
+    const int64_t row, const int64_t col, const std::complex<double> alpha
+  )
+) {
+  dense_basic_gemm(A, B, C, row, col, alpha);
+}
+
+define_method(
+  void, basic_gemm_omm,
+  (
+    const CDense& A, const CDense& B, CDense& C,
+    const int64_t row, const int64_t col, const std::complex<double> alpha
+  )
+) {
+  dense_basic_gemm(A, B, C, row, col, alpha);
+}
+
+define_method(
+  void, basic_gemm_omm,
+  (
+    const ZDense& A, const ZDense& B, ZDense& C,
+    const int64_t row, const int64_t col, const std::complex<double> alpha
+  )
+) {
+  dense_basic_gemm(A, B, C, row, col, alpha);
+}
+
+define_method(
+  void, basic_gemm_omm,
+  (
+    const SLowRank& A, const SDense& B, SDense& C,
+    const int64_t row, const int64_t col, const std::complex<double> alpha
+  )
+) {
+  low_rank_basic_gemm(A, B, C, row, col, alpha);
+}
+
+define_method(
+  void, basic_gemm_omm,
+  (
+    const CLowRank& A, const CDense& B, CDense& C,
+    const int64_t row, const int64_t col, const std::complex<double> alpha
+  )
+) {
+  low_rank_basic_gemm(A, B, C, row, col, alpha);
+}
+
+define_method(
+  void, basic_gemm_omm,
+  (
+    const ZLowRank& A, const ZDense& B, ZDense& C,
+    const int64_t row, const int64_t col, const std::complex<double> alpha
+  )
+) {
+  low_rank_basic_gemm(A, B, C, row, col, alpha);
+}
+
+define_method(
+  void, basic_gemm_omm,
+  (
+    const Matrix& A, const Matrix& B, Matrix& C,
+    const int64_t, const int64_t, const std::complex<double>
+  )
+) {
+  omm_error_handler("gemm", {A, B, C}, __FILE__, __LINE__);
+  std::abort();
+}
+
+// Single precision blocks of a Hierarchical matrix, see to_single_precision().
+// Products of two single precision blocks run in single precision, while
+// products involving double precision operands are computed in double
+// precision.
+define_method(
+  void, gemm_omm,
+  (
+    const SDense& A, const SDense& B, SDense& C,
+    const double alpha, const double beta,
+    const bool TransA, const bool TransB
+  )
+) {
+  // SD SD SD
+  gemm(A, B, C, float(alpha), float(beta), TransA, TransB);
+}
+
+define_method(
+  void, gemm_omm,
+  (
+    const SDense& A, const Dense& B, Dense& C,
+    const double alpha, const double beta,
+    const bool TransA, const bool TransB
+  )
+) {
+  // SD D D
+  gemm(Dense(A), B, C, alpha, beta, TransA, TransB);
+}
+
+define_method(
+  void, gemm_omm,
+  (
+    const Dense& A, const SDense& B, Dense& C,
+    const double alpha, const double beta,
+    const bool TransA, const bool TransB
+  )
+) {
+  // D SD D
+  gemm(A, Dense(B), C, alpha, beta, TransA, TransB);
+}
+
+void gemm_double(
+  const Matrix& A, const Matrix& B, SDense& C,
+  const double alpha, const double beta,
+  const bool TransA, const bool TransB
+) {
+  Dense CD(C);
+  gemm(A, B, CD, alpha, beta, TransA, TransB);
+  C = SDense(CD);
+}
+
+define_method(
+  void, gemm_omm,
+  (
+    const LowRank& A, const SDense& B, SDense& C,
+    const double alpha, const double beta,
+    const bool TransA, const bool TransB
+  )
+) {
+  // LR SD SD
+  gemm_double(A, Dense(B), C, alpha, beta, TransA, TransB);
+}
+
+define_method(
+  void, gemm_omm,
+  (
+    const SDense& A, const LowRank& B, SDense& C,
+    const double alpha, const double beta,
+    const bool TransA, const bool TransB
+  )
+) {
+  // SD LR SD
+  gemm_double(Dense(A), B, C, alpha, beta, TransA, TransB);
+}
+
+define_method(
+  void, gemm_omm,
+  (
+    const LowRank& A, const LowRank& B, SDense& C,
+    const double alpha, const double beta,
+    const bool TransA, const bool TransB
+  )
+) {
+  // LR LR SD
+  gemm_double(A, B, C, alpha, beta, TransA, TransB);
+}
+
+define_method(
+  void, gemm_omm,
+  (
+    const SDense& A, const SDense& B, LowRank& C,
+    const double alpha, const double beta,
+    const bool TransA, const bool TransB
+  )
+) {
+  // SD SD LR
+  gemm(Dense(A), Dense(B), C, alpha, beta, TransA, TransB);
+}
+
+define_method(
+  void, gemm_omm,
+  (
+    const LowRank& A, const SDense& B, LowRank& C,
+    const double alpha, const double beta,
+    const bool TransA, const bool TransB
+  )
+) {
+  // LR SD LR
+  gemm(A, Dense(B), C, alpha, beta, TransA, TransB);
+}
+
+define_method(
+  void, gemm_omm,
+  (
+    const SDense& A, const LowRank& B, LowRank& C,
+    const double alpha, const double beta,
+    const bool TransA, const bool TransB
+  )
+) {
+  // SD LR LR
+  gemm(Dense(A), B, C, alpha, beta, TransA, TransB);
 }
 
 } // namespace FRANK
@@ -0,0 +1,303 @@
+#include "FRANK/operations/small_kernels.h"
+
+#include "FRANK/classes/dense.h"
+
+#include <algorithm>
+#include <array>
+#include <cassert>
+#include <cmath>
+#include <cstdint>
+#include <utility>
+
+
+namespace FRANK
+{
+
+constexpr int64_t MAX_DIM = SMALL_KERNEL_MAX_DIM;
+
+bool fits_small_kernel(const int64_t dim) {
+  return dim > 0 && dim <= MAX_DIM;
+}
+
+// C = alpha*op(A)*op(B) + beta*C with op(A) of size m x K and op(B) of size
+// K x n. op(B) is packed row by row so that the innermost loop is contiguous,
+// and C is only read if beta != 0 like in BLAS.
+template<int64_t K>
+void gemm_kernel(
+  const int64_t m, const int64_t n, const double alpha,
+  const double* A, const int64_t lda, const bool TransA,
+  const double* B, const int64_t ldb, const bool TransB,
+  const double beta, double* C, const int64_t ldc
+) {
+  std::array<double, K*MAX_DIM> b;
+  for (int64_t l=0; l<K; ++l) {
+    for (int64_t j=0; j<n; ++j) {
+      b[l*n+j] = TransB ? B[j*ldb+l] : B[l*ldb+j];
+    }
+  }
+  std::array<double, K> a;
+  std::array<double, MAX_DIM> c;
+  for (int64_t i=0; i<m; ++i) {
+    for (int64_t l=0; l<K; ++l) {
+      a[l] = alpha * (TransA ? A[l*lda+i] : A[i*lda+l]);
+    }
+    std::fill(c.begin(), c.begin()+n, 0);
+    for (int64_t l=0; l<K; ++l) {
+      for (int64_t j=0; j<n; ++j) {
+        c[j] += a[l] * b[l*n+j];
+      }
+    }
+    double* C_row = C + i*ldc;
+    if (beta == 0) {
+      std::copy(c.begin(), c.begin()+n, C_row);
+    } else {
+      for (int64_t j=0; j<n; ++j) C_row[j] = c[j] + beta*C_row[j];
+    }
+  }
+}
+
+// Copy op(A) of the N x N triangular matrix A into the contiguous T, with
+// explicit zeros in the other triangle and ones on a unit diagonal.
+template<int64_t N>
+void pack_triangle(
+  const double* A, const int64_t lda, const Mode uplo, const bool trans,
+  const bool unit, double* T
+) {
+  for (int64_t i=0; i<N; ++i) {
+    for (int64_t j=0; j<N; ++j) {
+      // Position in A of element (i, j) of op(A)
+      const int64_t p = trans ? j : i;
+      const int64_t q = trans ? i : j;
+      const bool stored = uplo == Mode::Upper ? q >= p : q <= p;
+      T[i*N+j] = (p == q && unit) ? 1 : (stored ? A[p*lda+q] : 0);
+    }
+  }
+}
+
+// At these sizes, multiplying with the explicitly zero-padded triangle is
+// cheaper than branching on the triangle inside the innermost loop.
+template<int64_t N>
+void trmm_kernel(
+  const Dense& A, Dense& B,
+  const Side side, const Mode uplo, const bool trans, const bool unit,
+  const double alpha
+) {
+  std::array<double, N*N> T;
+  pack_triangle<N>(&A, A.stride, uplo, trans, unit, T.data());
+  std::array<double, N*MAX_DIM> W;
+  if (side == Side::Left) {
+    gemm_kernel<N>(
+      N, B.dim[1], alpha, T.data(), N, false, &B, B.stride, false,
+      0, W.data(), B.dim[1]
+    );
+  } else {
+    gemm_kernel<N>(
+      B.dim[0], N, alpha, &B, B.stride, false, T.data(), N, false,
+      0, W.data(), N
+    );
+  }
+  for (int64_t i=0; i<B.dim[0]; ++i) {
+    std::copy(W.data()+i*B.dim[1], W.data()+(i+1)*B.dim[1], &B+i*B.stride);
+  }
+}
+
+template<int64_t N>
+void trsm_kernel(const Dense& A, Dense& B, const Mode uplo, const Side side) {
+  // Same convention as the BLAS version: lower triangles have a unit diagonal
+  const bool unit = uplo == Mode::Lower;
+  std::array<double, N*N> T;
+  pack_triangle<N>(&A, A.stride, uplo, false, unit, T.data());
+  std::array<double, N> inv_diag;
+  for (int64_t i=0; i<N; ++i) inv_diag[i] = 1 / T[i*N+i];
+  double* b = &B;
+  const int64_t ldb = B.stride;
+  if (side == Side::Left) {
+    // Solve A*X = B by eliminating whole rows of B
+    const int64_t n = B.dim[1];
+    for (int64_t s=0; s<N; ++s) {
+      const int64_t i = uplo == Mode::Lower ? s : N-1-s;
+      double* b_i = b + i*ldb;
+      const int64_t k_begin = uplo == Mode::Lower ? 0 : i+1;
+      const int64_t k_end = uplo == Mode::Lower ? i : N;
+      for (int64_t k=k_begin; k<k_end; ++k) {
+        const double t = T[i*N+k];
+        const double* b_k = b + k*ldb;
+        for (int64_t j=0; j<n; ++j) b_i[j] -= t * b_k[j];
+      }
+      if (!unit) {
+        for (int64_t j=0; j<n; ++j) b_i[j] *= inv_diag[i];
+      }
+    }
+  } else {
+    // Solve X*A = B independently for each row of B
+    for (int64_t r=0; r<B.dim[0]; ++r) {
+      double* x = b + r*ldb;
+      for (int64_t s=0; s<N; ++s) {
+        const int64_t j = uplo == Mode::Upper ? s : N-1-s;
+        const int64_t k_begin = uplo == Mode::Upper ? 0 : j+1;
+        const int64_t k_end = uplo == Mode::Upper ? j : N;
+        double sum = x[j];
+        for (int64_t k=k_begin; k<k_end; ++k) sum -= x[k] * T[k*N+j];
+        x[j] = unit ? sum : sum * inv_diag[j];
+      }
+    }
+  }
+}
+
+// Apply H = I - tau*v*v^T from the left to rows i..m-1 and columns
+// j_begin..j_end-1 of a, where v = [1; a(i+1:m, i)].
+void apply_reflector(
+  double* a, const int64_t lda, const int64_t m, const int64_t i,
+  const int64_t j_begin, const int64_t j_end, const double tau
+) {
+  if (tau == 0) return;
+  std::array<double, MAX_DIM> w;
+  for (int64_t j=j_begin; j<j_end; ++j) w[j] = a[i*lda+j];
+  for (int64_t r=i+1; r<m; ++r) {
+    const double v = a[r*lda+i];
+    for (int64_t j=j_begin; j<j_end; ++j) w[j] += v * a[r*lda+j];
+  }
+  for (int64_t j=j_begin; j<j_end; ++j) {
+    w[j] *= tau;
+    a[i*lda+j] -= w[j];
+  }
+  for (int64_t r=i+1; r<m; ++r) {
+    const double v = a[r*lda+i];
+    for (int64_t j=j_begin; j<j_end; ++j) a[r*lda+j] -= v * w[j];
+  }
+}
+
+template<int64_t N>
+void qr_kernel(Dense& A, Dense& Q, Dense& R) {
+  const int64_t m = A.dim[0];
+  const int64_t k = std::min(m, N);
+  std::array<double, N> tau;
+  double* a = &A;
+  const int64_t lda = A.stride;
+  // dgeqr2
+  for (int64_t i=0; i<k; ++i) {
+    const double alpha = a[i*lda+i];
+    double xnorm = 0;
+    for (int64_t r=i+1; r<m; ++r) xnorm += a[r*lda+i] * a[r*lda+i];
+    xnorm = std::sqrt(xnorm);
+    if (xnorm == 0) {
+      tau[i] = 0;
+    } else {
+      const double beta = -std::copysign(std::hypot(alpha, xnorm), alpha);
+      tau[i] = (beta-alpha) / beta;
+      const double scale = 1 / (alpha-beta);
+      for (int64_t r=i+1; r<m; ++r) a[r*lda+i] *= scale;
+      a[i*lda+i] = beta;
+    }
+    apply_reflector(a, lda, m, i, i+1, N, tau[i]);
+  }
+  // Copy upper triangular (or trapezoidal) part of A into R
+  for (int64_t i=0; i<std::min(m, R.dim[0]); i++) {
+    for (int64_t j=i; j<R.dim[1]; j++) {
+      R(i, j) = A(i, j);
+    }
+  }
+  // dorg2r
+  double* q = &Q;
+  const int64_t ldq = Q.stride;
+  const int64_t nq = Q.dim[1];
+  for (int64_t i=0; i<m; ++i) {
+    for (int64_t j=0; j<nq; ++j) {
+      q[i*ldq+j] = (j < std::min(i, k)) ? a[i*lda+j] : (i == j ? 1 : 0);
+    }
+  }
+  for (int64_t i=k-1; i>=0; --i) {
+    q[i*ldq+i] = 1;
+    apply_reflector(q, ldq, m, i, i+1, nq, tau[i]);
+    for (int64_t r=i+1; r<m; ++r) q[r*ldq+i] *= -tau[i];
+    q[i*ldq+i] = 1 - tau[i];
+    for (int64_t r=0; r<i; ++r) q[r*ldq+i] = 0;
+  }
+}
+
+// Tables of all instantiations, indexed by the template parameter minus one
+template<int64_t... I>
+constexpr auto make_gemm_table(std::integer_sequence<int64_t, I...>) {
+  return std::array{&gemm_kernel<I+1>...};
+}
+
+template<int64_t... I>
+constexpr auto make_trmm_table(std::integer_sequence<int64_t, I...>) {
+  return std::array{&trmm_kernel<I+1>...};
+}
+
+template<int64_t... I>
+constexpr auto make_trsm_table(std::integer_sequence<int64_t, I...>) {
+  return std::array{&trsm_kernel<I+1>...};
+}
+
+template<int64_t... I>
+constexpr auto make_qr_table(std::integer_sequence<int64_t, I...>) {
+  return std::array{&qr_kernel<I+1>...};
+}
+
+constexpr auto gemm_table = make_gemm_table(
+  std::make_integer_sequence<int64_t, MAX_DIM>{}
+);
+constexpr auto trmm_table = make_trmm_table(
+  std::make_integer_sequence<int64_t, MAX_DIM>{}
+);
+constexpr auto trsm_table = make_trsm_table(
+  std::make_integer_sequence<int64_t, MAX_DIM>{}
+);
+constexpr auto qr_table = make_qr_table(
+  std::make_integer_sequence<int64_t, MAX_DIM>{}
+);
+
+bool small_gemm(
+  const Dense& A, const Dense& B, Dense& C,
+  const double alpha, const double beta,
+  const bool TransA, const bool TransB
+) {
+  const int64_t k = TransA ? A.dim[0] : A.dim[1];
+  if (!(
+    fits_small_kernel(C.dim[0]) && fits_small_kernel(C.dim[1])
+    && fits_small_kernel(k)
+  )) return false;
+  gemm_table[k-1](
+    C.dim[0], C.dim[1], alpha, &A, A.stride, TransA, &B, B.stride, TransB,
+    beta, &C, C.stride
+  );
+  return true;
+}
+
+bool small_trmm(
+  const Dense& A, Dense& B,
+  const Side side, const Mode uplo, const char& trans, const char& diag,
+  const double alpha
+) {
+  if (!(fits_small_kernel(B.dim[0]) && fits_small_kernel(B.dim[1]))) {
+    return false;
+  }
+  assert(A.dim[0] == A.dim[1]);
+  assert(A.dim[0] == (side == Side::Left ? B.dim[0] : B.dim[1]));
+  trmm_table[A.dim[0]-1](A, B, side, uplo, trans == 't', diag == 'u', alpha);
+  return true;
+}
+
+bool small_trsm(const Dense& A, Dense& B, const Mode uplo, const Side side) {
+  if (!(fits_small_kernel(B.dim[0]) && fits_small_kernel(B.dim[1]))) {
+    return false;
+  }
+  assert(A.dim[0] == A.dim[1]);
+  assert(A.dim[0] == (side == Side::Left ? B.dim[0] : B.dim[1]));
+  trsm_table[A.dim[0]-1](A, B, uplo, side);
+  return true;
+}
+
+bool small_qr(Dense& A, Dense& Q, Dense& R) {
+  // dorg2r needs at least as many columns in Q as there are reflectors
+  if (!(
+    fits_small_kernel(A.dim[0]) && fits_small_kernel(A.dim[1])
+    && Q.dim[1] >= std::min(A.dim[0], A.dim[1]) && Q.dim[1] <= A.dim[0]
+  )) return false;
+  qr_table[A.dim[1]-1](A, Q, R);
+  return true;
+}
+
+} // namespace FRANK
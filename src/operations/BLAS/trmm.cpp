@@ -1,11 +1,16 @@
 #include "FRANK/operations/BLAS.h"
 
 #include "FRANK/classes/dense.h"
+#include "FRANK/classes/diagonal.h"
+#include "FRANK/classes/empty.h"
 #include "FRANK/classes/hierarchical.h"
+#include "FRANK/classes/identity.h"
 #include "FRANK/classes/low_rank.h"
 #include "FRANK/classes/matrix.h"
+#include "FRANK/operations/arithmetic.h"
 #include "FRANK/operations/BLAS.h"
 #include "FRANK/operations/misc.h"
+#include "FRANK/operations/small_kernels.h"
 #include "FRANK/util/omm_error_handler.h"
 #include "FRANK/util/timer.h"
 
@@ -61,6 +66,7 @@ define_method(
   // D D
   assert(A.dim[0] == A.dim[1]);
   assert(A.dim[0] == (side == Side::Left ? B.dim[0] : B.dim[1]));
+  if (small_trmm(A, B, side, uplo, trans, diag, alpha)) return;
   cblas_dtrmm(
     CblasRowMajor,
     side == Side::Left ? CblasLeft : CblasRight,
@@ -80,6 +86,7 @@ define_method(
   )
 ) {
   // D LR
+  if (B.rank == 0) return;
   assert(A.dim[0] == A.dim[1]);
   assert(A.dim[0] == (side == Side::Left ? B.dim[0] : B.dim[1]));
   if(side == Side::Left)
@@ -133,6 +140,7 @@ define_method(
   )
 ) {
   // H LR
+  if (B.rank == 0) return;
   assert(A.dim[0] == A.dim[1]);
   assert(get_n_rows(A) == (side == Side::Left ? B.dim[0] : B.dim[1]));
   Hierarchical BH = split(
@@ -154,9 +162,14 @@ define_method(
   // H H
   assert(A.dim[0] == A.dim[1]);
   assert(A.dim[0] == (side == Side::Left ? B.dim[0] : B.dim[1]));
-  assert(trans != 't'); //TODO implement for transposed case: need transposed gemm complete
+  // op(A) = A^T is triangular in the opposite part, its blocks are A(k, i)^T
+  const bool transA = (trans == 't');
+  auto op_A = [&A, transA](const int64_t i, const int64_t k) -> const MatrixProxy& {
+    return transA ? A(k, i) : A(i, k);
+  };
+  const Mode op_uplo = transA ? (uplo == Mode::Upper ? Mode::Lower : Mode::Upper) : uplo;
   const Hierarchical B_copy(B);
-  switch(uplo) {
+  switch(op_uplo) {
     case Mode::Upper:
       switch(side) {
         case Side::Left:
@@ -166,7 +179,7 @@ define_method(
                 if(k == i)
                   trmm(A(i, k), B(k, j), side, uplo, trans, diag, alpha);
                 else
-                  gemm(A(i, k), B_copy(k, j), B(i, j), alpha, 1.);
+                  gemm(op_A(i, k), B_copy(k, j), B(i, j), alpha, 1., transA, false);
               }
             }
           }
@@ -178,7 +191,7 @@ define_method(
                 if(k == j)
                   trmm(A(k, j), B(i, k), side, uplo, trans, diag, alpha);
                 else
-                  gemm(B_copy(i, k), A(k, j), B(i, j), alpha, 1);
+                  gemm(B_copy(i, k), op_A(k, j), B(i, j), alpha, 1, false, transA);
               }
             }
           }
@@ -194,7 +207,7 @@ define_method(
                 if(k == i)
                   trmm(A(i, k), B(k, j), side, uplo, trans, diag, alpha);
                 else
-                  gemm(A(i, k), B_copy(k, j), B(i, j), alpha, 1);
+                  gemm(op_A(i, k), B_copy(k, j), B(i, j), alpha, 1, transA, false);
               }
             }
           }
@@ -206,7 +219,7 @@ define_method(
                 if(k == j)
                   trmm(A(k, j), B(i, k), side, uplo, trans, diag, alpha);
                 else
-                  gemm(B_copy(i, k), A(k, j), B(i, j), alpha, 1);
+                  gemm(B_copy(i, k), op_A(k, j), B(i, j), alpha, 1, false, transA);
               }
             }
           }
@@ -216,6 +229,66 @@ define_method(
   }
 }
 
+define_method(
+  void, trmm_omm,
+  (
+    [[maybe_unused]] const Identity& A, Matrix& B,
+    [[maybe_unused]] const Side side, const Mode, const char&, const char&,
+    const double alpha
+  )
+) {
+  // I *
+  assert(A.dim[0] == (side == Side::Left ? get_n_rows(B) : get_n_cols(B)));
+  if (alpha != 1) B *= alpha;
+}
+
+define_method(
+  void, trmm_omm,
+  (
+    const Diagonal& A, Dense& B,
+    const Side side, const Mode, const char&, const char& diag,
+    const double alpha
+  )
+) {
+  // Diag D
+  assert(A.dim[0] == (side == Side::Left ? B.dim[0] : B.dim[1]));
+  if (diag == 'u') {
+    if (alpha != 1) B *= alpha;
+    return;
+  }
+  if (side == Side::Left) {
+    for (int64_t i=0; i<B.dim[0]; i++) {
+      cblas_dscal(B.dim[1], alpha*A.diag[i], &B + i*B.stride, 1);
+    }
+  } else {
+    for (int64_t j=0; j<B.dim[1]; j++) {
+      cblas_dscal(B.dim[0], alpha*A.diag[j], &B + j, B.stride);
+    }
+  }
+}
+
+define_method(
+  void, trmm_omm,
+  (
+    const Matrix&, Empty&,
+    const Side, const Mode, const char&, const char&, const double
+  )
+) {
+  // * E
+  // Nothing to do, the product with a zero block stays zero
+}
+
+define_method(
+  void, trmm_omm,
+  (
+    const Identity&, Empty&,
+    const Side, const Mode, const char&, const char&, const double
+  )
+) {
+  // I E
+  // Resolves the ambiguity between the (I, *) and (*, E) specializations
+}
+
 // Fallback default, abort with error message
 define_method(
   void, trmm_omm,
@@ -1,10 +1,15 @@
 #include "FRANK/operations/BLAS.h"
 
+#include "FRANK/classes/basic_dense.h"
 #include "FRANK/classes/dense.h"
+#include "FRANK/classes/empty.h"
 #include "FRANK/classes/hierarchical.h"
 #include "FRANK/classes/low_rank.h"
 #include "FRANK/classes/matrix.h"
+#include "FRANK/classes/out_of_core_hierarchical.h"
+#include "FRANK/classes/permuted_hierarchical.h"
 #include "FRANK/operations/misc.h"
+#include "FRANK/operations/small_kernels.h"
 #include "FRANK/util/omm_error_handler.h"
 #include "FRANK/util/timer.h"
 
@@ -18,7 +23,9 @@ using yorel::yomm2::virtual_;
 #include <lapacke.h>
 #endif
 
+#include <algorithm>
 #include <cassert>
+#include <complex>
 #include <cstdint>
 #include <cstdlib>
 
@@ -34,7 +41,8 @@ declare_method(
 void trsm(const Matrix& A, Matrix& B, const Mode uplo, const Side side) {
   assert(uplo == Mode::Upper || uplo == Mode::Lower);
   assert(side == Side::Left || side == Side::Right);
-  trsm_omm(A, B, uplo, side);
+  const ResidentBlock A_resident(A), B_resident(B, true);
+  trsm_omm(A_resident.get(), B_resident.get(), uplo, side);
 }
 
 define_method(
@@ -90,6 +98,7 @@ define_method(
 }
 
 define_method(void, trsm_omm, (const Dense& A, Dense& B, const Mode uplo, const Side side)) {
+  if (small_trsm(A, B, uplo, side)) return;
   cblas_dtrsm(
     CblasRowMajor,
     side==Side::Left?CblasLeft:CblasRight,
@@ -104,6 +113,7 @@ define_method(void, trsm_omm, (const Dense& A, Dense& B, const Mode uplo, const
 }
 
 define_method(void, trsm_omm, (const Matrix& A, LowRank& B, const Mode uplo, const Side side)) {
+  if (B.rank == 0) return;
   switch (side) {
   case Side::Left:
     trsm(A, B.U, uplo, side);
@@ -124,10 +134,102 @@ define_method(
   trsm(A, BH, uplo, side);
 }
 
+define_method(void, trsm_omm, (const Matrix&, Empty&, const Mode, const Side)) {
+  // Solving with a zero right hand side leaves it unchanged
+}
+
 // Fallback default, abort with error message
 define_method(void, trsm_omm, (const Matrix& A, Matrix& B, const Mode, const Side)) {
   omm_error_handler("trsm", {A, B}, __FILE__, __LINE__);
   std::abort();
 }
 
+void trsm(const OutOfCoreHierarchical& A, Dense& B, const Mode uplo) {
+  assert(A.dim[0] == A.dim[1]);
+  A.plan_trsm(uplo);
+  trsm(uplo == Mode::Lower ? A.lower : A.upper, B, uplo, Side::Left);
+}
+
+void trsm(const PermutedHierarchical& A, Dense& B, const Mode uplo) {
+  A.to_permuted(B);
+  trsm(A.A, B, uplo);
+  A.to_original(B);
+}
+
+// Scalar type specific BLAS routines for BasicDense
+void basic_trsm(
+  const CBLAS_SIDE side, const CBLAS_UPLO uplo, const CBLAS_DIAG diag,
+  const int64_t m, const int64_t n,
+  const float* A, const int64_t lda, float* B, const int64_t ldb
+) {
+  cblas_strsm(
+    CblasRowMajor, side, uplo, CblasNoTrans, diag, m, n, 1, A, lda, B, ldb
+  );
+}
+
+void basic_trsm(
+  const CBLAS_SIDE side, const CBLAS_UPLO uplo, const CBLAS_DIAG diag,
+  const int64_t m, const int64_t n,
+  const std::complex<float>* A, const int64_t lda,
+  std::complex<float>* B, const int64_t ldb
+) {
+  const std::complex<float> alpha = 1;
+  cblas_ctrsm(
+    CblasRowMajor, side, uplo, CblasNoTrans, diag, m, n, &alpha, A, lda, B, ldb
+  );
+}
+
+void basic_trsm(
+  const CBLAS_SIDE side, const CBLAS_UPLO uplo, const CBLAS_DIAG diag,
+  const int64_t m, const int64_t n,
+  const std::complex<double>* A, const int64_t lda,
+  std::complex<double>* B, const int64_t ldb
+) {
+  const std::complex<double> alpha = 1;
+  cblas_ztrsm(
+    CblasRowMajor, side, uplo, CblasNoTrans, diag, m, n, &alpha, A, lda, B, ldb
+  );
+}
+
+template<typename T>
+void trsm(
+  const BasicDense<T>& A, BasicDense<T>& B, const Mode uplo, const Side side
+) {
+  assert(A.dim[0] == A.dim[1]);
+  assert(A.dim[0] == (side == Side::Left ? B.dim[0] : B.dim[1]));
+  if (B.dim[0] == 0 || B.dim[1] == 0) return;
+  basic_trsm(
+    side==Side::Left?CblasLeft:CblasRight,
+    uplo==Mode::Upper?CblasUpper:CblasLower,
+    uplo==Mode::Upper?CblasNonUnit:CblasUnit,
+    B.dim[0], B.dim[1],
+    &A, std::max<int64_t>(1, A.stride),
+    &B, B.stride
+  );
+}
+
+template void trsm(const SDense&, SDense&, const Mode, const Side);
+template void trsm(const CDense&, CDense&, const Mode, const Side);
+template void trsm(const ZDense&, ZDense&, const Mode, const Side);
+
+// Single precision blocks of a Hierarchical matrix, see to_single_precision()
+define_method(
+  void, trsm_omm, (const SDense& A, SDense& B, const Mode uplo, const Side side)
+) {
+  trsm(A, B, uplo, side);
+}
+
+define_method(
+  void, trsm_omm, (const SDense& A, Dense& B, const Mode uplo, const Side side)
+) {
+  // B may be a view of a larger matrix, so the result is copied back into it
+  SDense BS(B);
+  trsm(A, BS, uplo, side);
+  for (int64_t i=0; i<B.dim[0]; i++) {
+    for (int64_t j=0; j<B.dim[1]; j++) {
+      B(i, j) = BS(i, j);
+    }
+  }
+}
+
 } // namespace FRANK
@@ -0,0 +1,66 @@
+#include "FRANK/operations/LAPACK.h"
+
+#include "FRANK/classes/dense.h"
+#include "FRANK/classes/matrix.h"
+#include "FRANK/classes/matrix_proxy.h"
+#include "FRANK/operations/arithmetic.h"
+#include "FRANK/operations/BLAS.h"
+#include "FRANK/operations/misc.h"
+
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <tuple>
+#include <utility>
+
+
+namespace FRANK
+{
+
+// Refine x until the residual is small enough, return false if it stalls
+bool refine_solution(
+  const Matrix& A, const Matrix& L, const Matrix& U, const Dense& b, Dense& x,
+  const double tol, const int64_t max_iter, int64_t& iter
+) {
+  const double b_norm = std::sqrt(norm(b));
+  double r_norm_prev = std::numeric_limits<double>::infinity();
+  for (int64_t k=0; k<=max_iter; ++k) {
+    Dense r(b);
+    gemm(A, x, r, -1, 1);
+    const double r_norm = std::sqrt(norm(r));
+    if (r_norm <= tol*b_norm) return true;
+    if (k == max_iter || r_norm > 0.5*r_norm_prev) return false;
+    r_norm_prev = r_norm;
+    trsm(L, r, Mode::Lower);
+    trsm(U, r, Mode::Upper);
+    x += r;
+    ++iter;
+  }
+  return false;
+}
+
+std::tuple<Dense, int64_t, bool, bool> dsgesv(
+  const Matrix& A, const Dense& b, const double tol, const int64_t max_iter
+) {
+  int64_t iter = 0;
+  MatrixProxy L, U;
+  {
+    MatrixProxy A_single = to_single_precision(A);
+    std::tie(L, U) = getrf(A_single);
+  }
+  Dense x(b);
+  trsm(L, x, Mode::Lower);
+  trsm(U, x, Mode::Upper);
+  if (refine_solution(A, L, U, b, x, tol, max_iter, iter)) {
+    return {std::move(x), iter, false, true};
+  }
+  // Refinement stalled, fall back to the double precision factorization
+  {
+    MatrixProxy A_double(A);
+    std::tie(L, U) = getrf(A_double);
+  }
+  const bool converged = refine_solution(A, L, U, b, x, tol, max_iter, iter);
+  return {std::move(x), iter, true, converged};
+}
+
+} // namespace FRANK
@@ -39,8 +39,9 @@ define_method(DenseIndexSetPair, geqp3_omm, (Dense& A)) {
   // TODO The 0 initial value is important! Otherwise axes are fixed and results
   // can be wrong. See netlib dgeqp3 reference.
   // However, much faster with -1... maybe better starting values exist?
-  std::vector<int> jpvt(A.dim[1], 0);
+  std::vector<lapack_int> jpvt(A.dim[1], 0);
   std::vector<double> tau(std::min(A.dim[0], A.dim[1]), 0);
+  // Column pivoting has no dual on the transpose, so LAPACKE transposes A here
   LAPACKE_dgeqp3(
     LAPACK_ROW_MAJOR,
     A.dim[0], A.dim[1],
@@ -72,26 +73,26 @@ std::tuple<Dense, Dense> truncated_geqp3(const Dense& _A, const double eps) {
   // Pointer aliases
   Dense A(_A);
   double* a = &A;
-  const int m = A.dim[0];
-  const int n = A.dim[1];
-  const int lda = A.stride;
+  const int64_t m = A.dim[0];
+  const int64_t n = A.dim[1];
+  const int64_t lda = A.stride;
 
   // Initialize variables for pivoted QR
   const double tol = LAPACKE_dlamch('e');
   const double tol3z = std::sqrt(tol);
-  const int min_dim = std::min(m, n);
+  const int64_t min_dim = std::min(m, n);
   std::vector<double> tau(min_dim, 0);
-  std::vector<double> ipiv(n, 0);
+  std::vector<int64_t> ipiv(n, 0);
   std::vector<double> cnorm(n, 0);
   std::vector<double> partial_cnorm(n, 0);
-  for(int j=0; j<n; j++) {
+  for(int64_t j=0; j<n; j++) {
     ipiv[j] = j;
     cnorm[j] = cblas_dnrm2(m, a + j, lda);
     partial_cnorm[j] = cnorm[j];
   }
 
   // Begin pivoted QR
-  int r = 0;
+  int64_t r = 0;
   const double threshold = eps*std::sqrt(norm(A));
   double max_cnorm = *std::max_element(cnorm.begin(), cnorm.end());
   //Handle zero matrix case
@@ -102,7 +103,7 @@ std::tuple<Dense, Dense> truncated_geqp3(const Dense& _A, const double eps) {
   }
   while((r < min_dim) && (max_cnorm > threshold)) {
     // Select pivot column and swap
-    const int k = std::max_element(cnorm.begin() + r, cnorm.end()) - cnorm.begin();
+    const int64_t k = std::max_element(cnorm.begin() + r, cnorm.end()) - cnorm.begin();
     cblas_dswap(m, a + r, lda, a + k, lda);
     std::swap(cnorm[r], cnorm[k]);
     std::swap(partial_cnorm[r], partial_cnorm[k]);
@@ -135,7 +136,7 @@ std::tuple<Dense, Dense> truncated_geqp3(const Dense& _A, const double eps) {
       A(r, r) = _arr;
     }
     // Update partial column norm
-    for(int j=r+1; j<n; j++) {
+    for(int64_t j=r+1; j<n; j++) {
       //See LAPACK Working Note 176 (Section 3.2.1) for detail
       if(cnorm[j] != 0.0) {
         double temp = std::fabs(A(r, j)/cnorm[j]);
@@ -163,26 +164,27 @@ std::tuple<Dense, Dense> truncated_geqp3(const Dense& _A, const double eps) {
   // Construct truncated Q
   Dense Q(m, r);
   // Copy strictly lower triangular (or trapezoidal) part of A into Q
-  for(int i=0; i<Q.dim[0]; i++) {
-    for(int j=0; j<std::min(i, r); j++) {
+  for(int64_t i=0; i<Q.dim[0]; i++) {
+    for(int64_t j=0; j<std::min(i, r); j++) {
       Q(i, j) = A(i, j);
     }
   }
-  LAPACKE_dorgqr(LAPACK_ROW_MAJOR, Q.dim[0], Q.dim[1], r, &Q, Q.stride, &tau[0]);
+  // Generate Q as the LQ factor of the column-major transpose, see qr()
+  LAPACKE_dorglq(LAPACK_COL_MAJOR, Q.dim[1], Q.dim[0], r, &Q, Q.stride, &tau[0]);
   // Construct truncated R
   Dense R(r, n);
   // Copy first r rows of upper triangular part of A into R
-  for(int i=0; i<r; i++) {
-    for(int j=i; j<n; j++) {
+  for(int64_t i=0; i<r; i++) {
+    for(int64_t j=i; j<n; j++) {
       R(i, j) = A(i, j);
     }
   }
   // Permute columns of R
-  std::vector<int> ipivT(ipiv.size(), 0);
+  std::vector<int64_t> ipivT(ipiv.size(), 0);
   for(size_t i=0; i<ipiv.size(); i++) ipivT[ipiv[i]] = i;
   Dense RP(R);
-  for(int i=0; i<R.dim[0]; i++) {
-    for(int j=0; j<R.dim[1]; j++) {
+  for(int64_t i=0; i<R.dim[0]; i++) {
+    for(int64_t j=0; j<R.dim[1]; j++) {
       RP(i, j) = R(i, ipivT[j]);
     }
   }
@@ -1,14 +1,18 @@
 #include "FRANK/operations/LAPACK.h"
 
 #include "FRANK/definitions.h"
+#include "FRANK/classes/basic_dense.h"
 #include "FRANK/classes/dense.h"
 #include "FRANK/classes/empty.h"
 #include "FRANK/classes/hierarchical.h"
 #include "FRANK/classes/low_rank.h"
 #include "FRANK/classes/matrix.h"
+#include "FRANK/classes/out_of_core_hierarchical.h"
+#include "FRANK/classes/permuted_hierarchical.h"
 #include "FRANK/operations/BLAS.h"
 #include "FRANK/operations/misc.h"
 #include "FRANK/util/omm_error_handler.h"
+#include "FRANK/util/serialization.h"
 #include "FRANK/util/timer.h"
 
 #include "yorel/yomm2/cute.hpp"
@@ -22,8 +26,12 @@ using yorel::yomm2::virtual_;
 #endif
 
 #include <algorithm>
+#include <array>
+#include <cassert>
+#include <complex>
 #include <cstdint>
 #include <cstdlib>
+#include <string>
 #include <tuple>
 #include <utility>
 #include <vector>
@@ -42,31 +50,73 @@ std::tuple<MatrixProxy, MatrixProxy> getrf(Matrix& A) {
   return out;
 }
 
+// Factorize block column and row i of A, moving the factors of L into L
+void getrf_step(Hierarchical& L, Hierarchical& A, const int64_t i) {
+  std::tie(L(i, i), A(i, i)) = getrf_omm(A(i, i));
+  for (int64_t i_c=i+1; i_c<L.dim[0]; i_c++) {
+    L(i_c, i) = std::move(A(i_c, i));
+    A(i_c, i) = Empty(get_n_rows(L(i_c, i)), get_n_cols(L(i_c, i)));
+    trsm(A(i, i), L(i_c, i), Mode::Upper, Side::Right);
+  }
+  for (int64_t j=i+1; j<A.dim[1]; j++) {
+    L(i, j) = Empty(get_n_rows(A(i, j)), get_n_cols(A(i, j)));
+    trsm(L(i, i), A(i, j), Mode::Lower, Side::Left);
+  }
+  for (int64_t i_c=i+1; i_c<L.dim[0]; i_c++) {
+    for (int64_t k=i+1; k<A.dim[1]; k++) {
+      gemm(L(i_c, i), A(i, k), A(i_c, k), -1, 1);
+    }
+  }
+}
+
 define_method(MatrixPair, getrf_omm, (Hierarchical& A)) {
   Hierarchical L(A.dim[0], A.dim[1]);
   for (int64_t i=0; i<A.dim[0]; i++) {
-    std::tie(L(i, i), A(i, i)) = getrf_omm(A(i, i));
-    for (int64_t i_c=i+1; i_c<L.dim[0]; i_c++) {
-      L(i_c, i) = std::move(A(i_c, i));
-      A(i_c, i) = Empty(get_n_rows(L(i_c, i)), get_n_cols(L(i_c, i)));
-      trsm(A(i, i), L(i_c, i), Mode::Upper, Side::Right);
-    }
-    for (int64_t j=i+1; j<A.dim[1]; j++) {
-      L(i, j) = Empty(get_n_rows(A(i, j)), get_n_cols(A(i, j)));
-      trsm(L(i, i), A(i, j), Mode::Lower, Side::Left);
-    }
-    for (int64_t i_c=i+1; i_c<L.dim[0]; i_c++) {
-      for (int64_t k=i+1; k<A.dim[1]; k++) {
-        gemm(L(i_c, i), A(i, k), A(i_c, k), -1, 1);
+    getrf_step(L, A, i);
+  }
+  return {std::move(L), std::move(A)};
+}
+
+std::tuple<MatrixProxy, MatrixProxy> getrf(
+  Hierarchical& A, const std::string checkpoint_filename,
+  const int64_t checkpoint_interval
+) {
+  assert(checkpoint_interval > 0);
+  const std::array<int64_t, 2> dim = A.dim;
+  Hierarchical L(dim[0], dim[1]);
+  std::vector<MatrixProxy> saved;
+  int64_t first_step = 0;
+  // Checkpoints written for a different matrix are ignored and overwritten
+  const uint64_t input = fingerprint(A);
+  if (checkpoint_fingerprint(checkpoint_filename) == input) {
+    std::tie(saved, first_step) = load_checkpoint(checkpoint_filename);
+  }
+  if (saved.empty()) {
+    // Blocks of L that are not yet computed must exist to be saved
+    for (int64_t i=0; i<A.dim[0]; i++) {
+      for (int64_t j=0; j<A.dim[1]; j++) {
+        L(i, j) = Empty(get_n_rows(A(i, j)), get_n_cols(A(i, j)));
       }
     }
+  } else {
+    assert(saved.size() == 2);
+    L = std::move(saved[0]);
+    A = std::move(saved[1]);
+  }
+  assert(L.dim == dim && A.dim == dim);
+  for (int64_t i=first_step; i<A.dim[0]; i++) {
+    getrf_step(L, A, i);
+    if ((i+1) % checkpoint_interval == 0 || i+1 == A.dim[0]) {
+      save_checkpoint({&L, &A}, i+1, checkpoint_filename, true, input);
+    }
   }
   return {std::move(L), std::move(A)};
 }
 
 define_method(MatrixPair, getrf_omm, (Dense& A)) {
   Dense L(A.dim[0], A.dim[1]);
-  std::vector<int> ipiv(std::min(A.dim[0], A.dim[1]));
+  std::vector<lapack_int> ipiv(std::min(A.dim[0], A.dim[1]));
+  // LU of the transpose is not an LU of A, so LAPACKE transposes A here
   LAPACKE_dgetrf(
     LAPACK_ROW_MAJOR,
     A.dim[0], A.dim[1],
@@ -83,9 +133,88 @@ define_method(MatrixPair, getrf_omm, (Dense& A)) {
   return {std::move(L), std::move(A)};
 }
 
+define_method(MatrixPair, getrf_omm, (SpilledBlock& A)) {
+  MatrixProxy& block = A.acquire();
+  MatrixProxy L, U;
+  std::tie(L, U) = getrf_omm(block);
+  block = std::move(U);
+  A.release(true);
+  return {A.add_lower_factor(std::move(L)), SpilledBlock(A)};
+}
+
 define_method(MatrixPair, getrf_omm, (Matrix& A)) {
   omm_error_handler("getrf", {A}, __FILE__, __LINE__);
   std::abort();
 }
 
+std::tuple<PermutedHierarchical, PermutedHierarchical> getrf(
+  PermutedHierarchical& A
+) {
+  MatrixProxy L, U;
+  std::tie(L, U) = getrf(A.A);
+  return {
+    PermutedHierarchical(Hierarchical(std::move(L)), A.perm),
+    PermutedHierarchical(Hierarchical(std::move(U)), A.perm)
+  };
+}
+
+void getrf(OutOfCoreHierarchical& A) {
+  assert(A.dim[0] == A.dim[1]);
+  A.plan_getrf();
+  std::tie(A.lower, A.upper) = getrf(A.upper);
+}
+
+// Scalar type specific LAPACK routines for BasicDense
+void basic_getrf(
+  const int64_t m, const int64_t n, float* A, const int64_t lda, lapack_int* ipiv
+) {
+  LAPACKE_sgetrf(LAPACK_ROW_MAJOR, m, n, A, lda, ipiv);
+}
+
+void basic_getrf(
+  const int64_t m, const int64_t n,
+  std::complex<float>* A, const int64_t lda, lapack_int* ipiv
+) {
+  LAPACKE_cgetrf(
+    LAPACK_ROW_MAJOR, m, n, reinterpret_cast<lapack_complex_float*>(A), lda,
+    ipiv
+  );
+}
+
+void basic_getrf(
+  const int64_t m, const int64_t n,
+  std::complex<double>* A, const int64_t lda, lapack_int* ipiv
+) {
+  LAPACKE_zgetrf(
+    LAPACK_ROW_MAJOR, m, n, reinterpret_cast<lapack_complex_double*>(A), lda,
+    ipiv
+  );
+}
+
+template<typename T>
+std::tuple<BasicDense<T>, BasicDense<T>> getrf(BasicDense<T>& A) {
+  BasicDense<T> L(A.dim[0], A.dim[1]);
+  std::vector<lapack_int> ipiv(std::min(A.dim[0], A.dim[1]));
+  basic_getrf(A.dim[0], A.dim[1], &A, A.stride, &ipiv[0]);
+  for (int64_t i=0; i<A.dim[0]; i++) {
+    for (int64_t j=0; j<i; j++) {
+      L(i, j) = A(i, j);
+      A(i, j) = 0;
+    }
+    L(i, i) = 1;
+  }
+  return {std::move(L), std::move(A)};
+}
+
+template std::tuple<SDense, SDense> getrf(SDense&);
+template std::tuple<CDense, CDense> getrf(CDense&);
+template std::tuple<ZDense, ZDense> getrf(ZDense&);
+
+// Single precision blocks of a Hierarchical matrix, see to_single_precision()
+define_method(MatrixPair, getrf_omm, (SDense& A)) {
+  SDense L, U;
+  std::tie(L, U) = getrf(A);
+  return {std::move(L), std::move(U)};
+}
+
 } // namespace FRANK
@@ -38,6 +38,7 @@ define_method(
   void, larfb_omm,
   (const Dense& V, const Dense& T, Dense& C, const bool trans)
 ) {
+  // V and T come from geqrt() in row-major order, so LAPACKE transposes here
   LAPACKE_dlarfb(
     LAPACK_ROW_MAJOR,
     'L', (trans ? 'T' : 'N'), 'F', 'C',
@@ -9,6 +9,7 @@
 #include <lapacke.h>
 #endif
 
+#include <algorithm>
 #include <vector>
 
 
@@ -27,11 +28,14 @@ namespace FRANK
     const char& pack,
     Dense& A
   ) {
+    // The seed is updated in place, its integer type depends on MKL_ILP64
+    std::vector<lapack_int> seed(iseed.begin(), iseed.end());
     LAPACKE_dlatms(
       LAPACK_ROW_MAJOR, A.dim[0], A.dim[1],
-      dist, &iseed[0], sym, &d[0], mode, cond, dmax, kl, ku, pack,
+      dist, &seed[0], sym, &d[0], mode, cond, dmax, kl, ku, pack,
       &A, A.stride
     );
+    std::copy(seed.begin(), seed.end(), iseed.begin());
   }
 
 } // namespace FRANK
@@ -3,10 +3,10 @@
 #include "FRANK/definitions.h"
 #include "FRANK/classes/dense.h"
 #include "FRANK/classes/hierarchical.h"
+#include "FRANK/classes/identity.h"
 #include "FRANK/classes/low_rank.h"
 #include "FRANK/classes/matrix.h"
 #include "FRANK/classes/matrix_proxy.h"
-#include "FRANK/functions.h"
 #include "FRANK/operations/BLAS.h"
 #include "FRANK/operations/misc.h"
 #include "FRANK/util/omm_error_handler.h"
@@ -35,20 +35,19 @@ namespace FRANK
 {
 
 declare_method(
-  DensePair, make_left_orthogonal_omm,
+  MatrixPair, make_left_orthogonal_omm,
   (virtual_<const Matrix&>)
 )
 
-std::tuple<Dense, Dense> make_left_orthogonal(const Matrix& A) {
+MatrixPair make_left_orthogonal(const Matrix& A) {
   return make_left_orthogonal_omm(A);
 }
 
-define_method(DensePair, make_left_orthogonal_omm, (const Dense& A)) {
-  Dense Id(identity, {}, A.dim[0], A.dim[0]);
-  return {std::move(Id), A};
+define_method(MatrixPair, make_left_orthogonal_omm, (const Dense& A)) {
+  return {Identity(A.dim[0]), Dense(A)};
 }
 
-define_method(DensePair, make_left_orthogonal_omm, (const LowRank& A)) {
+define_method(MatrixPair, make_left_orthogonal_omm, (const LowRank& A)) {
   // U is assumed to be orthogonal here
   // Orthogonalize with QR factorization if needed
   Dense Qu(A.U);
@@ -56,7 +55,7 @@ define_method(DensePair, make_left_orthogonal_omm, (const LowRank& A)) {
   return {std::move(Qu), std::move(SV)};
 }
 
-define_method(DensePair, make_left_orthogonal_omm, (const Matrix& A)) {
+define_method(MatrixPair, make_left_orthogonal_omm, (const Matrix& A)) {
   omm_error_handler("make_left_orthogonal", {A}, __FILE__, __LINE__);
   std::abort();
 }
@@ -88,7 +87,7 @@ define_method(
   MatrixProxy, split_by_column_omm,
   (const LowRank& A, Hierarchical& storage, int64_t& currentRow)
 ) {
-  Dense U, SV;
+  MatrixProxy U, SV;
   std::tie(U, SV) = make_left_orthogonal(A);
   //Split SV
   Hierarchical splitted = split(SV, 1, storage.dim[1], true);
@@ -171,7 +170,7 @@ define_method(
   assert(A.dim[1] == concatenatedRow.dim[1]);
   assert(Q.dim[1] == concatenatedRow.dim[0]);
   const int64_t _rank = Q.dim[1];
-  LowRank _A(Dense(Q), Dense(identity, {}, _rank, _rank), concatenatedRow);
+  LowRank _A(Dense(Q), Dense(Identity(_rank)), concatenatedRow);
   _A.eps = A.eps;
   currentRow++;
   return _A;
@@ -322,12 +321,12 @@ define_method(void, mgs_qr_omm, (Dense& A, Dense& Q, Dense& R)) {
   assert(Q.dim[1] == A.dim[1]);
   assert(R.dim[0] == A.dim[1]);
   assert(R.dim[1] == A.dim[1]);
-  for(int j = 0; j < A.dim[1]; j++) {
-    R(j, j) = LAPACKE_dlange(LAPACK_ROW_MAJOR, 'F',
-                             A.dim[0], 1, &A + j, A.dim[1]);
+  for(int64_t j = 0; j < A.dim[1]; j++) {
+    R(j, j) = LAPACKE_dlange(LAPACK_COL_MAJOR, 'F',
+                             1, A.dim[0], &A + j, A.dim[1]);
     const double alpha = 1./R(j, j);
     cblas_dscal(A.dim[0], alpha, &A + j, A.dim[1]);
-    for(int k = j + 1; k < A.dim[1]; k++) {
+    for(int64_t k = j + 1; k < A.dim[1]; k++) {
       R(j, k) = cblas_ddot(A.dim[0], &A + j, A.dim[1],
                            &A + k, A.dim[1]);
       cblas_daxpy(A.dim[0], -R(j, k),
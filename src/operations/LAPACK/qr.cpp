@@ -2,12 +2,13 @@
 
 #include "FRANK/classes/dense.h"
 #include "FRANK/classes/hierarchical.h"
+#include "FRANK/classes/identity.h"
 #include "FRANK/classes/low_rank.h"
 #include "FRANK/classes/matrix.h"
 #include "FRANK/classes/matrix_proxy.h"
-#include "FRANK/functions.h"
 #include "FRANK/operations/BLAS.h"
 #include "FRANK/operations/misc.h"
+#include "FRANK/operations/small_kernels.h"
 #include "FRANK/util/omm_error_handler.h"
 #include "FRANK/util/timer.h"
 
@@ -66,9 +67,14 @@ define_method(void, qr_omm, (Dense& A, Dense& Q, Dense& R)) {
   assert(Q.dim[0] == A.dim[0]);
   assert(Q.dim[1] == R.dim[0]);
   assert(R.dim[1] == A.dim[1]);
+  if (small_qr(A, Q, R)) return;
   const int64_t k = std::min(A.dim[0], A.dim[1]);
   std::vector<double> tau(k);
-  LAPACKE_dgeqrf(LAPACK_ROW_MAJOR, A.dim[0], A.dim[1], &A, A.stride, &tau[0]);
+  // The row-major A is the column-major transpose of A, and the LQ
+  // factorization of the transpose stores exactly the reflectors of the QR
+  // factorization of A. Calling LAPACK with its native layout avoids the
+  // transposed copies LAPACKE makes for LAPACK_ROW_MAJOR.
+  LAPACKE_dgelqf(LAPACK_COL_MAJOR, A.dim[1], A.dim[0], &A, A.stride, &tau[0]);
   // Copy upper triangular (or trapezoidal) part of A into R
   for(int64_t i=0; i<std::min(A.dim[0], R.dim[0]); i++) {
     for(int64_t j=i; j<R.dim[1]; j++) {
@@ -86,7 +92,7 @@ define_method(void, qr_omm, (Dense& A, Dense& Q, Dense& R)) {
   // Alternatively, create Dense derivative that remains in elementary
   // reflector form, uses dormqr instead of gemm and can be transformed to
   // Dense via dorgqr!
-  LAPACKE_dorgqr(LAPACK_ROW_MAJOR, Q.dim[0], Q.dim[1], k, &Q, Q.stride, &tau[0]);
+  LAPACKE_dorglq(LAPACK_COL_MAJOR, Q.dim[1], Q.dim[0], k, &Q, Q.stride, &tau[0]);
 }
 
 define_method(void, qr_omm, (Matrix& A, Matrix& Q, Matrix& R)) {
@@ -103,6 +109,11 @@ define_method(Dense, get_right_factor_omm, (const LowRank& A)) {
   return SV;
 }
 
+define_method(Dense, get_right_factor_omm, (const Hierarchical& A)) {
+  // Treated like a Dense block, the left factor is the identity
+  return Dense(A);
+}
+
 define_method(
   void, update_right_factor_omm,
   (Dense& A, Dense& R)
@@ -110,6 +121,14 @@ define_method(
   A = std::move(R);
 }
 
+define_method(
+  void, update_right_factor_omm,
+  (Hierarchical& A, Dense& R)
+) {
+  // Keep the block structure, with the Householder vectors in Dense blocks
+  A = split(R, A, true);
+}
+
 define_method(
   void, update_right_factor_omm,
   (LowRank& A, Dense& R)
@@ -169,10 +188,7 @@ void apply_block_col_householder(
     if(i == k) { //Use trmm since Ykk is unit lower triangular
       Hierarchical _C(C);
       trmm(Y(k, k), _C(0, 0), Side::Left, Mode::Lower, 'n', 'u', 1);
-      gemm(
-        Dense(identity, {}, get_n_rows(_C(0, 0)), get_n_rows(_C(0, 0))),
-        _C(0, 0), A(k, j), -1, 1
-      );
+      gemm(Identity(get_n_rows(_C(0, 0))), _C(0, 0), A(k, j), -1, 1);
     }
     else { //Use gemm otherwise
       gemm(Y(i, k), C(0, 0), A(i, j), -1, 1);
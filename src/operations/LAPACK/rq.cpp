@@ -46,7 +46,8 @@ define_method(void, rq_omm, (Dense& A, Dense& R, Dense& Q)) {
   assert(Q.dim[1] == A.dim[1]);
   const int64_t k = std::min(A.dim[0], A.dim[1]);
   std::vector<double> tau(k);
-  LAPACKE_dgerqf(LAPACK_ROW_MAJOR, A.dim[0], A.dim[1], &A, A.stride, &tau[0]);
+  // RQ of the row-major A is QL of its column-major transpose, see qr()
+  LAPACKE_dgeqlf(LAPACK_COL_MAJOR, A.dim[1], A.dim[0], &A, A.stride, &tau[0]);
   // Copy upper triangular into R
   for(int64_t i=0; i<R.dim[0]; i++) {
     for(int64_t j=std::max(i+A.dim[1]-A.dim[0], (int64_t)0); j<A.dim[1]; j++) {
@@ -64,8 +65,8 @@ define_method(void, rq_omm, (Dense& A, Dense& R, Dense& Q)) {
   // Alternatively, create Dense derivative that remains in elementary reflector
   // form, uses dormrq instead of gemm and can be transformed to Dense via
   // dorgrq!
-  LAPACKE_dorgrq(
-    LAPACK_ROW_MAJOR, Q.dim[0], Q.dim[1], k, &Q, Q.stride, &tau[0]
+  LAPACKE_dorgql(
+    LAPACK_COL_MAJOR, Q.dim[1], Q.dim[0], k, &Q, Q.stride, &tau[0]
   );
 }
 
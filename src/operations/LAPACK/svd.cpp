@@ -27,14 +27,19 @@ std::tuple<Dense, Dense, Dense> svd(Dense& A) {
   Dense V(dim_min, A.dim[1]);
   std::vector<double> Sdiag(S.dim[0], 0);
   std::vector<double> work(S.dim[0]-1, 0);
+  // The row-major A is the column-major transpose of A. Since
+  // transpose(A) = transpose(V)*S*transpose(U), the left singular vectors of
+  // the transpose are written to V and its right singular vectors to U, each
+  // already in row-major form. This avoids the transposed copies LAPACKE makes
+  // for LAPACK_ROW_MAJOR.
   LAPACKE_dgesvd(
-    LAPACK_ROW_MAJOR,
+    LAPACK_COL_MAJOR,
     'S', 'S',
-    A.dim[0], A.dim[1],
+    A.dim[1], A.dim[0],
     &A, A.stride,
     &Sdiag[0],
-    &U, U.stride,
     &V, V.stride,
+    &U, U.stride,
     &work[0]
   );
   for(int64_t i=0; i<S.dim[0]; i++){
@@ -46,11 +51,12 @@ std::tuple<Dense, Dense, Dense> svd(Dense& A) {
 std::vector<double> get_singular_values(Dense& A) {
   std::vector<double> Sdiag(std::min(A.dim[0], A.dim[1]), 1);
   Dense work(A.dim[1]-1,1);
-  // Since we use 'N' we can avoid allocating memory for U and V
+  // Since we use 'N' we can avoid allocating memory for U and V. Singular
+  // values are invariant under transposition, see svd().
   LAPACKE_dgesvd(
-    LAPACK_ROW_MAJOR,
+    LAPACK_COL_MAJOR,
     'N', 'N',
-    A.dim[0], A.dim[1],
+    A.dim[1], A.dim[0],
     &A, A.stride,
     Sdiag.data(),
     &work, A.stride,
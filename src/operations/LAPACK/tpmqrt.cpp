@@ -2,9 +2,9 @@
 
 #include "FRANK/classes/dense.h"
 #include "FRANK/classes/hierarchical.h"
+#include "FRANK/classes/identity.h"
 #include "FRANK/classes/low_rank.h"
 #include "FRANK/classes/matrix.h"
-#include "FRANK/functions.h"
 #include "FRANK/operations/BLAS.h"
 #include "FRANK/operations/misc.h"
 #include "FRANK/util/omm_error_handler.h"
@@ -47,6 +47,7 @@ define_method(
   (const Dense& V, const Dense& T, Dense& A, Dense& B, const bool trans)
 ) {
   // D D D D
+  // V and T come from tpqrt() in row-major order, so LAPACKE transposes here
   LAPACKE_dtprfb(
     LAPACK_ROW_MAJOR,
     'L', (trans ? 'T': 'N'), 'F', 'C',
@@ -67,10 +68,7 @@ define_method(
   LowRank Vt = transpose(V);
   gemm(Vt, B, C, 1, 1); //C = A + Y^t*B
   trmm(T, C, Side::Left, Mode::Upper, trans ? 't' : 'n', 'n', 1); //C = T*C or T^t*C
-  gemm(
-    Dense(identity, {}, C.dim[0], C.dim[0]),
-    C, A, -1, 1
-  ); //A = A - I*C
+  gemm(Identity(C.dim[0]), C, A, -1, 1); //A = A - I*C
   gemm(V, C, B, -1, 1); //B = B - Y*C
 }
 
@@ -82,10 +80,7 @@ define_method(
   Dense C(A);
   gemm(V, B, C, 1, 1, true, false); //C = A + Y^t*B
   trmm(T, C, Side::Left, Mode::Upper, trans ? 't' : 'n', 'n', 1); //C = T*C or T^t*C
-  gemm(
-    Dense(identity, {}, C.dim[0], C.dim[0]),
-    C, A, -1, 1
-  ); //A = A - I*C //Recompression
+  gemm(Identity(C.dim[0]), C, A, -1, 1); //A = A - I*C //Recompression
   gemm(V, C, B, -1, 1); //B = B - Y*C
 }
 
@@ -98,10 +93,7 @@ define_method(
   Dense Vt = transpose(V);
   gemm(Vt, B, C, 1, 1); //C = A + Y^t*B
   trmm(T, C, Side::Left, Mode::Upper, trans ? 't' : 'n', 'n', 1); //C = T*C or T^t*C
-  gemm(
-    Dense(identity, {}, C.dim[0], C.dim[0]),
-    C, A, -1, 1
-  ); //A = A - I*C
+  gemm(Identity(C.dim[0]), C, A, -1, 1); //A = A - I*C
   gemm(V, C, B, -1, 1); //B = B - Y*C
 }
 
@@ -114,10 +106,7 @@ define_method(
   LowRank Vt = transpose(V);
   gemm(Vt, B, C, 1, 1); //C = A + Y^t*B
   trmm(T, C, Side::Left, Mode::Upper, trans ? 't' : 'n', 'n', 1); //C = T*C or T^t*C
-  gemm(
-    Dense(identity, {}, C.dim[0], C.dim[0]),
-    C, A, -1, 1
-  ); //A = A - I*C
+  gemm(Identity(C.dim[0]), C, A, -1, 1); //A = A - I*C
   gemm(V, C, B, -1, 1); //B = B - Y*C
 }
 
@@ -130,10 +119,7 @@ define_method(
   LowRank Vt = transpose(V);
   gemm(Vt, B, C, 1, 1); //C = A + Y^t * B
   trmm(T, C, Side::Left, Mode::Upper, trans ? 't' : 'n', 'n', 1); //C = T*C or T^t*C
-  gemm(
-    Dense(identity, {}, C.dim[0], C.dim[0]),
-    C, A, -1, 1
-  ); //A = A - I*C
+  gemm(Identity(C.dim[0]), C, A, -1, 1); //A = A - I*C
   gemm(V, C, B, -1, 1); //B = B - Y*C
 }
 
@@ -146,10 +132,7 @@ define_method(
   Dense Vt = transpose(V);
   gemm(Vt, B, C, 1, 1); //C = A + Y^t*B
   trmm(T, C, Side::Left, Mode::Upper, trans ? 't' : 'n', 'n', 1); //C = T*C or T^t*C
-  gemm(
-    Dense(identity, {}, C.dim[0], C.dim[0]),
-    C, A, -1, 1
-  ); //A = A - I*C
+  gemm(Identity(C.dim[0]), C, A, -1, 1); //A = A - I*C
   gemm(V, C, B, -1, 1); //B = B - Y*C
 }
 
@@ -162,10 +145,7 @@ define_method(
   LowRank Vt = transpose(V);
   gemm(Vt, B, C, 1, 1); //C = A + Y^t*B
   trmm(T, C, Side::Left, Mode::Upper, trans ? 't' : 'n', 'n', 1); //C = T*C or T^t*C
-  gemm(
-    Dense(identity, {}, C.dim[0], C.dim[0]),
-    C, A, -1, 1
-  ); //A = A - I*C
+  gemm(Identity(C.dim[0]), C, A, -1, 1); //A = A - I*C
   gemm(V, C, B, -1, 1); //B = B - Y*C
 }
 
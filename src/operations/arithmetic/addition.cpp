@@ -1,11 +1,16 @@
 #include "FRANK/operations/arithmetic.h"
 
 #include "FRANK/definitions.h"
+#include "FRANK/classes/basic_dense.h"
 #include "FRANK/classes/dense.h"
+#include "FRANK/classes/diagonal.h"
+#include "FRANK/classes/empty.h"
 #include "FRANK/classes/hierarchical.h"
+#include "FRANK/classes/identity.h"
 #include "FRANK/classes/low_rank.h"
 #include "FRANK/classes/matrix.h"
 #include "FRANK/classes/matrix_proxy.h"
+#include "FRANK/classes/out_of_core_hierarchical.h"
 #include "FRANK/classes/initialization_helpers/index_range.h"
 #include "FRANK/operations/BLAS.h"
 #include "FRANK/operations/LAPACK.h"
@@ -34,7 +39,11 @@ declare_method(
   (virtual_<Matrix&>, virtual_<const Matrix&>)
 )
 
-Matrix& operator+=(Matrix& A, const Matrix& B) { return addition_omm(A, B); }
+Matrix& operator+=(Matrix& A, const Matrix& B) {
+  const ResidentBlock A_resident(A, true), B_resident(B);
+  addition_omm(A_resident.get(), B_resident.get());
+  return A;
+}
 
 define_method(Matrix&, addition_omm, (Dense& A, const Dense& B)) {
   for (int64_t i=0; i<A.dim[0]; i++) {
@@ -46,7 +55,38 @@ define_method(Matrix&, addition_omm, (Dense& A, const Dense& B)) {
 }
 
 define_method(Matrix&, addition_omm, (Dense& A, const LowRank& B)) {
-  gemm(gemm(B.U, B.S), B.V, A, 1, 1);
+  if (B.rank == 0) return A;
+  (B.U * B.S * B.V).evaluate(A, 1, 1);
+  return A;
+}
+
+define_method(Matrix&, addition_omm, (SDense& A, const LowRank& B)) {
+  if (B.rank == 0) return A;
+  // The low-rank product is formed in double precision before rounding
+  const Dense BD(B);
+  for (int64_t i=0; i<A.dim[0]; i++) {
+    for (int64_t j=0; j<A.dim[1]; j++) {
+      A(i, j) += BD(i, j);
+    }
+  }
+  return A;
+}
+
+define_method(Matrix&, addition_omm, (Dense& A, [[maybe_unused]] const Identity& B)) {
+  assert(A.dim[0] == B.dim[0]);
+  assert(A.dim[1] == B.dim[1]);
+  for (int64_t i=0; i<A.dim[0]; i++) {
+    A(i, i) += 1;
+  }
+  return A;
+}
+
+define_method(Matrix&, addition_omm, (Dense& A, const Diagonal& B)) {
+  assert(A.dim[0] == B.dim[0]);
+  assert(A.dim[1] == B.dim[1]);
+  for (int64_t i=0; i<A.dim[0]; i++) {
+    A(i, i) += B.diag[i];
+  }
   return A;
 }
 
@@ -60,6 +100,7 @@ define_method(Matrix&, addition_omm, (Hierarchical& A, const Hierarchical& B)) {
 }
 
 define_method(Matrix&, addition_omm, (Hierarchical& A, const LowRank& B)) {
+  if (B.rank == 0) return A;
   const Hierarchical BH = split(B, A.dim[0], A.dim[1]);
   A += BH;
   return A;
@@ -121,9 +162,9 @@ void rounded_addition(LowRank& A, const LowRank& B) {
   const bool use_eps = (A.eps != 0);
   if(use_eps) A.rank = find_svd_truncation_rank(RRS, A.eps);
   // Truncate
-  A.S = resize(RRS, A.rank, A.rank);
-  A.U = gemm(Qu, resize(RRU, RRU.dim[0], A.rank));
-  A.V = gemm(resize(RRV, A.rank, RRV.dim[1]), QvT);
+  A.S = resize(std::move(RRS), A.rank, A.rank);
+  A.U = gemm(Qu, resize(std::move(RRU), RRU.dim[0], A.rank));
+  A.V = gemm(resize(std::move(RRV), A.rank, RRV.dim[1]), QvT);
 }
 
 // Fast rounded addition that exploits existing orthogonality in U and V matrices
@@ -183,14 +224,24 @@ void fast_rounded_addition(LowRank& A, const LowRank& B) {
   // SVD and truncate
   Dense Um, Sm, VmT;
   std::tie(Um, Sm, VmT) = svd(M);
-  A.S = resize(Sm, A.rank, A.rank);
-  A.U = gemm(Uc, resize(Um, Um.dim[0], A.rank));
-  A.V = gemm(resize(VmT, A.rank, VmT.dim[1]), VcT);  
+  A.S = resize(std::move(Sm), A.rank, A.rank);
+  A.U = gemm(Uc, resize(std::move(Um), Um.dim[0], A.rank));
+  A.V = gemm(resize(std::move(VmT), A.rank, VmT.dim[1]), VcT);
 }
 
 define_method(Matrix&, addition_omm, (LowRank& A, const LowRank& B)) {
   assert(A.dim[0] == B.dim[0]);
   assert(A.dim[1] == B.dim[1]);
+  // Adding a zero block is a no-op. A zero block compressed with a fixed
+  // accuracy takes over the factors of B, since its rank is not prescribed.
+  if (B.rank == 0) return A;
+  if (A.rank == 0 && A.eps != 0) {
+    A.rank = B.rank;
+    A.U = B.U;
+    A.S = B.S;
+    A.V = B.V;
+    return A;
+  }
   if (getGlobalValue("FRANK_LRA") == "naive") {
     naive_addition(A, B);
   } else if (getGlobalValue("FRANK_LRA") == "rounded_addition") {
@@ -202,6 +253,10 @@ define_method(Matrix&, addition_omm, (LowRank& A, const LowRank& B)) {
   return A;
 }
 
+define_method(Matrix&, addition_omm, (Matrix& A, const Empty&)) {
+  return A;
+}
+
 define_method(Matrix&, addition_omm, (Matrix& A, const Matrix& B)) {
   omm_error_handler("operator+=", {A, B}, __FILE__, __LINE__);
   std::abort();
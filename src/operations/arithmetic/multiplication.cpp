@@ -1,9 +1,13 @@
 #include "FRANK/operations/arithmetic.h"
 
+#include "FRANK/classes/basic_dense.h"
 #include "FRANK/classes/dense.h"
+#include "FRANK/classes/empty.h"
 #include "FRANK/classes/hierarchical.h"
 #include "FRANK/classes/low_rank.h"
 #include "FRANK/classes/matrix.h"
+#include "FRANK/classes/matrix_product.h"
+#include "FRANK/classes/out_of_core_hierarchical.h"
 #include "FRANK/util/omm_error_handler.h"
 
 #include "yorel/yomm2/cute.hpp"
@@ -11,6 +15,7 @@ using yorel::yomm2::virtual_;
 
 #include <cstdint>
 #include <cstdlib>
+#include <utility>
 
 
 namespace FRANK
@@ -22,7 +27,19 @@ declare_method(
 )
 
 Matrix& operator*=(Matrix& A, const double b) {
-  return multiplication_omm(A, b);
+  // Scaling by one would only read spilled blocks back
+  if (b == 1) return A;
+  const ResidentBlock A_resident(A, true);
+  multiplication_omm(A_resident.get(), b);
+  return A;
+}
+
+MatrixProduct operator*(const Dense& A, const Dense& B) {
+  return MatrixProduct(A).times(B);
+}
+
+MatrixProduct operator*(MatrixProduct AB, const Dense& C) {
+  return std::move(AB.times(C));
 }
 
 define_method(
@@ -36,6 +53,17 @@ define_method(
   return A;
 }
 
+define_method(
+  Matrix&, multiplication_omm, (SDense& A, const double b)
+) {
+  for (int64_t i=0; i<A.dim[0]; i++) {
+    for (int64_t j=0; j<A.dim[1]; j++) {
+      A(i, j) *= b;
+    }
+  }
+  return A;
+}
+
 define_method(
   Matrix&, multiplication_omm, (LowRank& A, const double b)
 ) {
@@ -54,6 +82,10 @@ define_method(
   return A;
 }
 
+define_method(Matrix&, multiplication_omm, (Empty& A, const double)) {
+  return A;
+}
+
 define_method(Matrix&, multiplication_omm, (Matrix& A, const double)) {
   omm_error_handler("operator*<double>", {A}, __FILE__, __LINE__);
   std::abort();
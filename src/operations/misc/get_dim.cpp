@@ -1,10 +1,16 @@
 #include "FRANK/operations/misc.h"
 
+#include "FRANK/classes/basic_dense.h"
+#include "FRANK/classes/basic_low_rank.h"
 #include "FRANK/classes/dense.h"
+#include "FRANK/classes/diagonal.h"
 #include "FRANK/classes/empty.h"
 #include "FRANK/classes/hierarchical.h"
+#include "FRANK/classes/identity.h"
 #include "FRANK/classes/low_rank.h"
 #include "FRANK/classes/matrix.h"
+#include "FRANK/classes/mixed_precision_low_rank.h"
+#include "FRANK/classes/out_of_core_hierarchical.h"
 #include "FRANK/util/omm_error_handler.h"
 
 #include "yorel/yomm2/cute.hpp"
@@ -23,10 +29,32 @@ int64_t get_n_rows(const Matrix& A) { return get_n_rows_omm(A); }
 
 define_method(int64_t, get_n_rows_omm, (const Dense& A)) { return A.dim[0]; }
 
+define_method(int64_t, get_n_rows_omm, (const SDense& A)) { return A.dim[0]; }
+
+define_method(int64_t, get_n_rows_omm, (const CDense& A)) { return A.dim[0]; }
+
+define_method(int64_t, get_n_rows_omm, (const ZDense& A)) { return A.dim[0]; }
+
+define_method(int64_t, get_n_rows_omm, (const SLowRank& A)) { return A.dim[0]; }
+
+define_method(int64_t, get_n_rows_omm, (const CLowRank& A)) { return A.dim[0]; }
+
+define_method(int64_t, get_n_rows_omm, (const ZLowRank& A)) { return A.dim[0]; }
+
 define_method(int64_t, get_n_rows_omm, (const Empty& A)) { return A.dim[0]; }
 
+define_method(int64_t, get_n_rows_omm, (const Identity& A)) { return A.dim[0]; }
+
+define_method(int64_t, get_n_rows_omm, (const Diagonal& A)) { return A.dim[0]; }
+
+define_method(int64_t, get_n_rows_omm, (const SpilledBlock& A)) { return A.dim[0]; }
+
 define_method(int64_t, get_n_rows_omm, (const LowRank& A)) { return A.dim[0]; }
 
+define_method(
+  int64_t, get_n_rows_omm, (const MixedPrecisionLowRank& A)
+) { return A.dim[0]; }
+
 define_method(int64_t, get_n_rows_omm, (const Hierarchical& A)) {
   int64_t n_rows = 0;
   for (int64_t i=0; i<A.dim[0]; i++) {
@@ -47,10 +75,32 @@ int64_t get_n_cols(const Matrix& A) { return get_n_cols_omm(A); }
 
 define_method(int64_t, get_n_cols_omm, (const Dense& A)) { return A.dim[1]; }
 
+define_method(int64_t, get_n_cols_omm, (const SDense& A)) { return A.dim[1]; }
+
+define_method(int64_t, get_n_cols_omm, (const CDense& A)) { return A.dim[1]; }
+
+define_method(int64_t, get_n_cols_omm, (const ZDense& A)) { return A.dim[1]; }
+
+define_method(int64_t, get_n_cols_omm, (const SLowRank& A)) { return A.dim[1]; }
+
+define_method(int64_t, get_n_cols_omm, (const CLowRank& A)) { return A.dim[1]; }
+
+define_method(int64_t, get_n_cols_omm, (const ZLowRank& A)) { return A.dim[1]; }
+
 define_method(int64_t, get_n_cols_omm, (const Empty& A)) { return A.dim[1]; }
 
+define_method(int64_t, get_n_cols_omm, (const Identity& A)) { return A.dim[1]; }
+
+define_method(int64_t, get_n_cols_omm, (const Diagonal& A)) { return A.dim[1]; }
+
+define_method(int64_t, get_n_cols_omm, (const SpilledBlock& A)) { return A.dim[1]; }
+
 define_method(int64_t, get_n_cols_omm, (const LowRank& A)) { return A.dim[1]; }
 
+define_method(
+  int64_t, get_n_cols_omm, (const MixedPrecisionLowRank& A)
+) { return A.dim[1]; }
+
 define_method(int64_t, get_n_cols_omm, (const Hierarchical& A)) {
   int64_t n_cols = 0;
   for (int64_t j=0; j<A.dim[1]; j++) {
@@ -1,9 +1,12 @@
 #include "FRANK/operations/misc.h"
 
+#include "FRANK/classes/basic_dense.h"
 #include "FRANK/classes/dense.h"
+#include "FRANK/classes/empty.h"
 #include "FRANK/classes/hierarchical.h"
 #include "FRANK/classes/low_rank.h"
 #include "FRANK/classes/matrix.h"
+#include "FRANK/classes/mixed_precision_low_rank.h"
 #include "FRANK/classes/initialization_helpers/index_range.h"
 #include "FRANK/operations/BLAS.h"
 #include "FRANK/operations/LAPACK.h"
@@ -17,6 +20,7 @@ using yorel::yomm2::virtual_;
 #include <cmath>
 #include <cstdint>
 #include <cstdlib>
+#include <limits>
 #include <numeric>
 #include <vector>
 
@@ -46,6 +50,10 @@ define_method(void, zero_all_omm, (LowRank& A)) {
   }
 }
 
+define_method(void, zero_all_omm, (Empty&)) {
+  // Nothing to do, Empty is already zero
+}
+
 define_method(void, zero_all_omm, (Hierarchical& A)) {
   for(int64_t i = 0; i < A.dim[0]; i++)
     for(int64_t j = 0; j < A.dim[1]; j++) {
@@ -239,6 +247,27 @@ define_method(
   return out;
 }
 
+define_method(
+  Hierarchical, split_omm,
+  (
+    const MixedPrecisionLowRank& A,
+    const std::vector<IndexRange>& row_splits,
+    const std::vector<IndexRange>& col_splits,
+    const bool
+  )
+) {
+  // The reduced precision singular vectors can not be shared, so the blocks
+  // are always copies
+  Hierarchical out(row_splits.size(), col_splits.size());
+  std::vector<MixedPrecisionLowRank> result = A.split(row_splits, col_splits);
+  for (int64_t i=0; i<out.dim[0]; ++i) {
+    for (int64_t j=0; j<out.dim[1]; ++j) {
+      out(i, j) = std::move(result[i*out.dim[1]+j]);
+    }
+  }
+  return out;
+}
+
 define_method(
   Hierarchical, split_omm,
   (
@@ -314,4 +343,76 @@ define_method(MatrixProxy, shallow_copy_omm, (const Matrix& A)) {
   std::abort();
 }
 
+declare_method(MatrixProxy, to_single_precision_omm, (virtual_<const Matrix&>))
+
+MatrixProxy to_single_precision(const Matrix& A) {
+  return to_single_precision_omm(A);
+}
+
+define_method(MatrixProxy, to_single_precision_omm, (const Dense& A)) {
+  return SDense(A);
+}
+
+define_method(MatrixProxy, to_single_precision_omm, (const Hierarchical& A)) {
+  Hierarchical out(A.dim[0], A.dim[1]);
+  for (int64_t i=0; i<A.dim[0]; ++i) {
+    for (int64_t j=0; j<A.dim[1]; ++j) {
+      out(i, j) = to_single_precision(A(i, j));
+    }
+  }
+  return out;
+}
+
+define_method(MatrixProxy, to_single_precision_omm, (const Matrix& A)) {
+  // LowRank, Empty and blocks already in single precision are kept as they are
+  return MatrixProxy(A);
+}
+
+declare_method(
+  MatrixProxy, adapt_precision_omm, (virtual_<const Matrix&>, const double)
+)
+
+MatrixProxy adapt_precision(const Matrix& A, const double eps) {
+  // Admissible error per element, a block of N elements may then introduce an
+  // error of tol*sqrt(N) so that the total error is at most eps*||A||
+  const double tol = eps * std::sqrt(
+    norm(A) / (get_n_rows(A) * get_n_cols(A))
+  );
+  return adapt_precision_omm(A, tol);
+}
+
+define_method(
+  MatrixProxy, adapt_precision_omm, (const Dense& A, const double tol)
+) {
+  const double block_tol = tol * std::sqrt(A.dim[0] * A.dim[1]);
+  // Rounding to single precision changes each element by a relative u at most
+  const double u = std::numeric_limits<float>::epsilon() / 2;
+  if (u * std::sqrt(norm(A)) <= block_tol) return SDense(A);
+  return MatrixProxy(A);
+}
+
+define_method(
+  MatrixProxy, adapt_precision_omm, (const LowRank& A, const double tol)
+) {
+  return MixedPrecisionLowRank(A, tol * std::sqrt(A.dim[0] * A.dim[1]));
+}
+
+define_method(
+  MatrixProxy, adapt_precision_omm, (const Hierarchical& A, const double tol)
+) {
+  Hierarchical out(A.dim[0], A.dim[1]);
+  for (int64_t i=0; i<A.dim[0]; ++i) {
+    for (int64_t j=0; j<A.dim[1]; ++j) {
+      out(i, j) = adapt_precision_omm(A(i, j), tol);
+    }
+  }
+  return out;
+}
+
+define_method(
+  MatrixProxy, adapt_precision_omm, (const Matrix& A, const double)
+) {
+  return MatrixProxy(A);
+}
+
 } // namespace FRANK
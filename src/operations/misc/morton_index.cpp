@@ -10,11 +10,13 @@
 #include "FRANK/util/omm_error_handler.h"
 
 #include <algorithm>
+#include <array>
 #include <cassert>
 #include <cmath>
 #include <cstdint>
 #include <cstdlib>
 #include <numeric>
+#include <thread>
 #include <vector>
 
 
@@ -33,67 +35,126 @@ std::vector<int64_t> getCartesianIndex(const int64_t dim, int64_t mortonIndex) {
   return index;
 }
 
-int64_t getMortonIndex(std::vector<int64_t>& iX, const int64_t level) {
-  int64_t mortonIndex = 0;
-  for(int64_t lev=0; lev<level; lev++) {
-    for(size_t d=0; d<iX.size(); d++) {
-      mortonIndex += (iX[d] & 1) << (iX.size() * lev + d);
-      iX[d] >>= 1;
-    }
-  }
-  return mortonIndex;
+// Spread the lower 32 bits of v so that there is one zero bit between bits
+uint64_t spread_bits_by_1(uint64_t v) {
+  v &= 0x00000000ffffffff;
+  v = (v | (v << 16)) & 0x0000ffff0000ffff;
+  v = (v | (v << 8)) & 0x00ff00ff00ff00ff;
+  v = (v | (v << 4)) & 0x0f0f0f0f0f0f0f0f;
+  v = (v | (v << 2)) & 0x3333333333333333;
+  v = (v | (v << 1)) & 0x5555555555555555;
+  return v;
+}
+
+// Spread the lower 21 bits of v so that there are two zero bits between bits
+uint64_t spread_bits_by_2(uint64_t v) {
+  v &= 0x00000000001fffff;
+  v = (v | (v << 32)) & 0x001f00000000ffff;
+  v = (v | (v << 16)) & 0x001f0000ff0000ff;
+  v = (v | (v << 8)) & 0x100f00f00f00f00f;
+  v = (v | (v << 4)) & 0x10c30c30c30c30c3;
+  v = (v | (v << 2)) & 0x1249249249249249;
+  return v;
 }
 
-int64_t getBoxNumber(const std::vector<double>& p, const int64_t level) {
-  const int64_t nx = (1 << level);
-  std::vector<int64_t> iX;
-  for(size_t dim=0; dim<p.size(); dim++) {
-    iX.push_back(p[dim] * nx);
+// Run f(begin, end) on consecutive chunks of [0, n), in parallel if n is large
+template<typename Function>
+void parallel_chunks(const int64_t n, const int64_t n_threads, Function f) {
+  if (n_threads == 1) {
+    f(0, 0, n);
+    return;
+  }
+  std::vector<std::thread> threads;
+  for (int64_t t=0; t<n_threads; ++t) {
+    threads.emplace_back(f, t, n*t/n_threads, n*(t+1)/n_threads);
   }
-  return getMortonIndex(iX, level);
+  for (std::thread& thread : threads) thread.join();
 }
 
-std::vector<std::vector<double>> normalizeWithinBox(std::vector<std::vector<double>>& x, const double eps) {
-  std::vector<double> bmin;
+void sortByMortonIndex(std::vector<std::vector<double>> &x, const int64_t level, std::vector<int64_t>& perm) {
+  const int64_t dim = x.size();
+  const int64_t n = x[0].size();
+  // Keys have 64 bits, deeper levels are truncated
+  const int64_t bits = std::min<int64_t>({level, 64/dim, 32});
+  const int64_t n_threads = n < (1 << 16) ? 1 : std::max<int64_t>(
+    1, std::min<int64_t>(std::thread::hardware_concurrency(), n >> 15)
+  );
+
+  // Normalize all points into a box of edge length one with a margin of eps
+  // and get their integer position on the finest level
+  const double eps = 5e-1;
+  std::vector<double> bmin(dim);
   double bsize = 0.0;
-  for(size_t dim=0; dim<x.size(); dim++) {
-    const double xmin = *std::min_element(x[dim].begin(), x[dim].end());
-    const double xmax = *std::max_element(x[dim].begin(), x[dim].end());
-    bsize = std::max(bsize, xmax-xmin);
-    bmin.push_back(xmin - eps);
+  for (int64_t d=0; d<dim; ++d) {
+    const auto minmax = std::minmax_element(x[d].begin(), x[d].end());
+    bsize = std::max(bsize, *minmax.second - *minmax.first);
+    bmin[d] = *minmax.first - eps;
   }
   bsize += 2*eps;
-  std::vector<std::vector<double>> normalized(x);
-  for(size_t dim=0; dim<x.size(); dim++) {
-    for(size_t i=0; i<x[dim].size(); i++) {
-      normalized[dim][i] = (x[dim][i] - bmin[dim]) / bsize;
+  const double nx = uint64_t(1) << bits;
+  std::vector<uint64_t> keys(n);
+  parallel_chunks(n, n_threads, [&](int64_t, const int64_t begin, const int64_t end) {
+    for (int64_t i=begin; i<end; ++i) {
+      uint64_t key = 0;
+      if (dim == 1) {
+        key = uint64_t((x[0][i] - bmin[0]) / bsize * nx);
+      } else if (dim == 2) {
+        key = spread_bits_by_1(uint64_t((x[0][i] - bmin[0]) / bsize * nx))
+          | spread_bits_by_1(uint64_t((x[1][i] - bmin[1]) / bsize * nx)) << 1;
+      } else if (dim == 3) {
+        key = spread_bits_by_2(uint64_t((x[0][i] - bmin[0]) / bsize * nx))
+          | spread_bits_by_2(uint64_t((x[1][i] - bmin[1]) / bsize * nx)) << 1
+          | spread_bits_by_2(uint64_t((x[2][i] - bmin[2]) / bsize * nx)) << 2;
+      } else {
+        for (int64_t d=0; d<dim; ++d) {
+          const uint64_t position = uint64_t((x[d][i] - bmin[d]) / bsize * nx);
+          for (int64_t b=0; b<bits; ++b) {
+            key |= ((position >> b) & 1) << (dim*b + d);
+          }
+        }
+      }
+      keys[i] = key;
     }
-  }
-  return normalized;
-}
+  });
 
-void sortByMortonIndex(std::vector<std::vector<double>> &x, const int64_t level, std::vector<int64_t>& perm) {
-  std::vector<std::vector<double>> xn = normalizeWithinBox(x, 5e-1);
-  std::vector<std::vector<double>> xnT (xn[0].size(), std::vector<double>());
-  for(size_t i=0; i<xnT.size(); i++) {
-    for(size_t dim=0; dim<xn.size(); dim++) {
-      xnT[i].push_back(xn[dim][i]);
+  // Stable least significant digit radix sort of the indices by key, one byte
+  // per pass. Each thread counts and scatters its own chunk.
+  perm.resize(n);
+  std::iota(perm.begin(), perm.end(), 0);
+  std::vector<uint64_t> keys_buffer(n);
+  std::vector<int64_t> perm_buffer(n);
+  std::vector<std::array<int64_t, 256>> counts(n_threads);
+  for (int64_t shift=0; shift<dim*bits; shift+=8) {
+    parallel_chunks(n, n_threads, [&](const int64_t t, const int64_t begin, const int64_t end) {
+      counts[t].fill(0);
+      for (int64_t i=begin; i<end; ++i) counts[t][(keys[i] >> shift) & 0xff]++;
+    });
+    int64_t offset = 0;
+    for (int64_t digit=0; digit<256; ++digit) {
+      for (int64_t t=0; t<n_threads; ++t) {
+        const int64_t count = counts[t][digit];
+        counts[t][digit] = offset;
+        offset += count;
+      }
     }
+    parallel_chunks(n, n_threads, [&](const int64_t t, const int64_t begin, const int64_t end) {
+      for (int64_t i=begin; i<end; ++i) {
+        const int64_t position = counts[t][(keys[i] >> shift) & 0xff]++;
+        keys_buffer[position] = keys[i];
+        perm_buffer[position] = perm[i];
+      }
+    });
+    std::swap(keys, keys_buffer);
+    std::swap(perm, perm_buffer);
   }
-  std::vector<std::pair<int64_t, int64_t>> indexWithBoxNum;
-  for(size_t i=0; i<xnT.size(); i++)
-    indexWithBoxNum.push_back(std::make_pair((int64_t)i, getBoxNumber(xnT[i], level)));
-  std::sort(indexWithBoxNum.begin(),
-            indexWithBoxNum.end(),
-            [](std::pair<int64_t, int64_t> a, std::pair<int64_t, int64_t> b) {
-              return a.second < b.second;
-            });
-  std::vector<std::vector<double>> x_copy(x);
-  for(size_t i=0; i<indexWithBoxNum.size(); i++) {
-    perm[i] = indexWithBoxNum[i].first;
-    for(size_t dim=0; dim<x.size(); dim++) {
-      x[dim][i] = x_copy[dim][indexWithBoxNum[i].first];
-    }
+
+  // Reorder the coordinates one axis at a time through a single buffer
+  std::vector<double> gathered(n);
+  for (int64_t d=0; d<dim; ++d) {
+    parallel_chunks(n, n_threads, [&](int64_t, const int64_t begin, const int64_t end) {
+      for (int64_t i=begin; i<end; ++i) gathered[i] = x[d][perm[i]];
+    });
+    std::swap(x[d], gathered);
   }
 }
 
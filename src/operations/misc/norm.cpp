@@ -1,15 +1,21 @@
 #include "FRANK/operations/misc.h"
 
+#include "FRANK/classes/basic_dense.h"
+#include "FRANK/classes/basic_low_rank.h"
 #include "FRANK/classes/dense.h"
+#include "FRANK/classes/empty.h"
 #include "FRANK/classes/hierarchical.h"
 #include "FRANK/classes/low_rank.h"
 #include "FRANK/classes/matrix.h"
+#include "FRANK/classes/mixed_precision_low_rank.h"
+#include "FRANK/operations/BLAS.h"
 #include "FRANK/util/omm_error_handler.h"
 #include "FRANK/util/timer.h"
 
 #include "yorel/yomm2/cute.hpp"
 using yorel::yomm2::virtual_;
 
+#include <complex>
 #include <cstdint>
 #include <cstdlib>
 
@@ -31,8 +37,54 @@ define_method(double, norm_omm, (const Dense& A)) {
   return l2;
 }
 
+template<typename T>
+double basic_dense_norm(const BasicDense<T>& A) {
+  double l2 = 0;
+  for (int64_t i=0; i<A.dim[0]; i++) {
+    for (int64_t j=0; j<A.dim[1]; j++) {
+      l2 += std::norm(A(i, j));
+    }
+  }
+  return l2;
+}
+
+define_method(double, norm_omm, (const SDense& A)) {
+  return basic_dense_norm(A);
+}
+
+define_method(double, norm_omm, (const CDense& A)) {
+  return basic_dense_norm(A);
+}
+
+define_method(double, norm_omm, (const ZDense& A)) {
+  return basic_dense_norm(A);
+}
+
+template<typename T>
+double basic_low_rank_norm(const BasicLowRank<T>& A) {
+  return basic_dense_norm(gemm(gemm(A.U, A.S), A.V));
+}
+
+define_method(double, norm_omm, (const SLowRank& A)) {
+  return basic_low_rank_norm(A);
+}
+
+define_method(double, norm_omm, (const CLowRank& A)) {
+  return basic_low_rank_norm(A);
+}
+
+define_method(double, norm_omm, (const ZLowRank& A)) {
+  return basic_low_rank_norm(A);
+}
+
 define_method(double, norm_omm, (const LowRank& A)) { return norm(Dense(A)); }
 
+define_method(double, norm_omm, (const MixedPrecisionLowRank& A)) {
+  return norm(A.decompress());
+}
+
+define_method(double, norm_omm, (const Empty&)) { return 0; }
+
 define_method(double, norm_omm, (const Hierarchical& A)) {
   double l2 = 0;
   for (int64_t i=0; i<A.dim[0]; i++) {
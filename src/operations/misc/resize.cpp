@@ -10,6 +10,7 @@ using yorel::yomm2::virtual_;
 
 #include <cassert>
 #include <cstdint>
+#include <utility>
 
 
 namespace FRANK
@@ -33,6 +34,11 @@ define_method(
   return resized;
 }
 
+Dense resize(Dense&& A, const int64_t n_rows, const int64_t n_cols) {
+  A.truncate(n_rows, n_cols);
+  return std::move(A);
+}
+
 define_method(MatrixProxy, resize_omm, (const Matrix& A, const int64_t, const int64_t)) {
   omm_error_handler("resize", {A}, __FILE__, __LINE__);
   std::abort();
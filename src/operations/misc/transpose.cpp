@@ -1,7 +1,9 @@
 #include "FRANK/operations/misc.h"
 
 #include "FRANK/classes/dense.h"
+#include "FRANK/classes/diagonal.h"
 #include "FRANK/classes/hierarchical.h"
+#include "FRANK/classes/identity.h"
 #include "FRANK/classes/low_rank.h"
 #include "FRANK/classes/matrix.h"
 #include "FRANK/classes/matrix_proxy.h"
@@ -30,6 +32,14 @@ define_method(MatrixProxy, transpose_omm, (const Dense& A)) {
   return transposed;
 }
 
+define_method(MatrixProxy, transpose_omm, (const Identity& A)) {
+  return Identity(A.dim[0]);
+}
+
+define_method(MatrixProxy, transpose_omm, (const Diagonal& A)) {
+  return Diagonal(A);
+}
+
 define_method(MatrixProxy, transpose_omm, (const LowRank& A)) {
   LowRank transposed(transpose(A.V), transpose(A.S), transpose(A.U));
   return transposed;
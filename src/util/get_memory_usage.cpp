@@ -1,9 +1,16 @@
 #include "FRANK/util/get_memory_usage.h"
 
+#include "FRANK/classes/basic_dense.h"
+#include "FRANK/classes/basic_low_rank.h"
 #include "FRANK/classes/dense.h"
+#include "FRANK/classes/diagonal.h"
+#include "FRANK/classes/empty.h"
 #include "FRANK/classes/hierarchical.h"
+#include "FRANK/classes/identity.h"
 #include "FRANK/classes/low_rank.h"
 #include "FRANK/classes/matrix.h"
+#include "FRANK/classes/mixed_precision_low_rank.h"
+#include "FRANK/classes/out_of_core_hierarchical.h"
 #include "FRANK/classes/matrix_proxy.h"
 #include "FRANK/util/omm_error_handler.h"
 #include "FRANK/util/print.h"
@@ -40,6 +47,93 @@ define_method(
   return memory_usage;
 }
 
+template<typename T>
+unsigned long basic_dense_memory_usage(
+  const BasicDense<T>& A, const bool include_structure
+) {
+  unsigned long memory_usage = 0;
+  memory_usage += A.dim[0]*A.dim[1]*sizeof(T);
+  if (include_structure) {
+    memory_usage += sizeof(BasicDense<T>);
+  }
+  return memory_usage;
+}
+
+define_method(
+  unsigned long, get_memory_usage_omm,
+  (const SDense& A, const bool include_structure)
+) {
+  return basic_dense_memory_usage(A, include_structure);
+}
+
+define_method(
+  unsigned long, get_memory_usage_omm,
+  (const CDense& A, const bool include_structure)
+) {
+  return basic_dense_memory_usage(A, include_structure);
+}
+
+define_method(
+  unsigned long, get_memory_usage_omm,
+  (const ZDense& A, const bool include_structure)
+) {
+  return basic_dense_memory_usage(A, include_structure);
+}
+
+template<typename T>
+unsigned long basic_low_rank_memory_usage(
+  const BasicLowRank<T>& A, const bool include_structure
+) {
+  unsigned long memory_usage = 0;
+  memory_usage += basic_dense_memory_usage(A.U, include_structure);
+  memory_usage += basic_dense_memory_usage(A.S, include_structure);
+  memory_usage += basic_dense_memory_usage(A.V, include_structure);
+  if (include_structure) {
+    memory_usage += sizeof(BasicLowRank<T>) - 3*sizeof(BasicDense<T>);
+  }
+  return memory_usage;
+}
+
+define_method(
+  unsigned long, get_memory_usage_omm,
+  (const SLowRank& A, const bool include_structure)
+) {
+  return basic_low_rank_memory_usage(A, include_structure);
+}
+
+define_method(
+  unsigned long, get_memory_usage_omm,
+  (const CLowRank& A, const bool include_structure)
+) {
+  return basic_low_rank_memory_usage(A, include_structure);
+}
+
+define_method(
+  unsigned long, get_memory_usage_omm,
+  (const ZLowRank& A, const bool include_structure)
+) {
+  return basic_low_rank_memory_usage(A, include_structure);
+}
+
+define_method(
+  unsigned long, get_memory_usage_omm,
+  (const Identity&, const bool include_structure)
+) {
+  return include_structure ? sizeof(Identity) : 0;
+}
+
+define_method(
+  unsigned long, get_memory_usage_omm,
+  (const Diagonal& A, const bool include_structure)
+) {
+  unsigned long memory_usage = 0;
+  memory_usage += get_memory_usage_omm(A.diag, include_structure);
+  if (include_structure) {
+    memory_usage += sizeof(Diagonal) - sizeof(Dense);
+  }
+  return memory_usage;
+}
+
 define_method(
   unsigned long, get_memory_usage_omm,
   (const LowRank& A, const bool include_structure)
@@ -54,6 +148,22 @@ define_method(
   return memory_usage;
 }
 
+define_method(
+  unsigned long, get_memory_usage_omm,
+  (const MixedPrecisionLowRank& A, const bool include_structure)
+) {
+  const int64_t n = A.dim[0] + A.dim[1];
+  unsigned long memory_usage = 0;
+  memory_usage += A.total_rank() * sizeof(double);
+  memory_usage += n * A.rank[0] * sizeof(double);
+  memory_usage += n * A.rank[1] * sizeof(float);
+  memory_usage += n * A.rank[2] * sizeof(uint16_t);
+  if (include_structure) {
+    memory_usage += sizeof(MixedPrecisionLowRank);
+  }
+  return memory_usage;
+}
+
 define_method(
   unsigned long, get_memory_usage_omm,
   (const Hierarchical& A, const bool include_structure)
@@ -71,6 +181,21 @@ define_method(
   return memory_usage;
 }
 
+define_method(
+  unsigned long, get_memory_usage_omm,
+  (const Empty&, const bool include_structure)
+) {
+  return include_structure ? sizeof(Empty) : 0;
+}
+
+define_method(
+  unsigned long, get_memory_usage_omm,
+  (const SpilledBlock&, const bool include_structure)
+) {
+  // The block itself is accounted for by the spill store
+  return include_structure ? sizeof(SpilledBlock) : 0;
+}
+
 define_method(unsigned long, get_memory_usage_omm, (const Matrix& A, const bool)) {
   omm_error_handler("get_memory_usage", {A}, __FILE__, __LINE__);
   std::abort();
@@ -9,8 +9,18 @@ namespace FRANK {
   register_class(Matrix)
   register_class(Dense, Matrix)
   register_class(Empty, Matrix)
+  register_class(Identity, Matrix)
+  register_class(Diagonal, Matrix)
   register_class(LowRank, Matrix)
+  register_class(MixedPrecisionLowRank, Matrix)
   register_class(Hierarchical, Matrix)
+  register_class(SDense, Matrix)
+  register_class(CDense, Matrix)
+  register_class(ZDense, Matrix)
+  register_class(SLowRank, Matrix)
+  register_class(CLowRank, Matrix)
+  register_class(ZLowRank, Matrix)
+  register_class(SpilledBlock, Matrix)
 
   void initialize() {
     yorel::yomm2::update_methods();
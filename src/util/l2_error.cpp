@@ -1,10 +1,13 @@
 #include "FRANK/util/l2_error.h"
 
 #include "FRANK/definitions.h"
+#include "FRANK/classes/basic_dense.h"
 #include "FRANK/classes/dense.h"
+#include "FRANK/classes/empty.h"
 #include "FRANK/classes/hierarchical.h"
 #include "FRANK/classes/low_rank.h"
 #include "FRANK/classes/matrix.h"
+#include "FRANK/classes/mixed_precision_low_rank.h"
 #include "FRANK/operations/arithmetic.h"
 #include "FRANK/operations/misc.h"
 #include "FRANK/util/omm_error_handler.h"
@@ -66,6 +69,38 @@ define_method(
   return collect_diff_norm_omm(Dense(A), Dense(B));
 }
 
+define_method(
+  DoublePair, collect_diff_norm_omm, (const Dense& A, const SDense& B)
+) {
+  return collect_diff_norm_omm(A, Dense(B));
+}
+
+define_method(
+  DoublePair, collect_diff_norm_omm, (const SDense& A, const Dense& B)
+) {
+  return collect_diff_norm_omm(Dense(A), B);
+}
+
+define_method(
+  DoublePair, collect_diff_norm_omm,
+  (const LowRank& A, const MixedPrecisionLowRank& B)
+) {
+  return collect_diff_norm_omm(Dense(A), Dense(B));
+}
+
+define_method(
+  DoublePair, collect_diff_norm_omm,
+  (const MixedPrecisionLowRank& A, const LowRank& B)
+) {
+  return collect_diff_norm_omm(Dense(A), Dense(B));
+}
+
+define_method(
+  DoublePair, collect_diff_norm_omm, (const Empty&, const Empty&)
+) {
+  return {0, 0};
+}
+
 define_method(
   DoublePair, collect_diff_norm_omm, (const Hierarchical& A, const Matrix& B)
 ) {
@@ -0,0 +1,160 @@
+#include "FRANK/util/mapped_file.h"
+
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+#include <memory>
+#include <vector>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+
+namespace FRANK
+{
+
+uint64_t page_size() {
+  static const uint64_t size = sysconf(_SC_PAGESIZE);
+  return size;
+}
+
+void check_system_call(const bool success, const char* name) {
+  if (!success) {
+    std::perror(name);
+    std::abort();
+  }
+}
+
+int create_temporary_file(const std::string& directory) {
+  std::string pattern(directory);
+  if (pattern.empty()) {
+    const char* tmpdir = std::getenv("TMPDIR");
+    pattern = tmpdir != nullptr ? tmpdir : "/tmp";
+  }
+  pattern += "/FRANK_XXXXXX";
+  std::vector<char> name(pattern.begin(), pattern.end());
+  name.push_back('\0');
+  const int file_descriptor = mkstemp(name.data());
+  check_system_call(file_descriptor != -1, "mkstemp");
+  unlink(name.data());
+  return file_descriptor;
+}
+
+MappedFile::MappedFile(
+  const int64_t n_rows, const int64_t n_cols, const std::string& filename
+) : dim{n_rows, n_cols} {
+  // Rows of at least one page are rounded up to whole pages so that split
+  // views along rows never share a page. Shorter rows are not padded, which
+  // would waste most of the file for narrow matrices such as vectors.
+  const int64_t page_elements = page_size() / sizeof(double);
+  stride = n_cols < page_elements
+    ? n_cols : (n_cols + page_elements - 1) / page_elements * page_elements;
+  const uint64_t n_bytes = size() * sizeof(double);
+  int file_descriptor;
+  if (filename.empty()) {
+    file_descriptor = create_temporary_file("");
+  } else {
+    file_descriptor = open(filename.c_str(), O_RDWR | O_CREAT | O_TRUNC, 0644);
+    check_system_call(file_descriptor != -1, filename.c_str());
+  }
+  // Extending the file does not allocate disk blocks, it reads back as zeros
+  check_system_call(ftruncate(file_descriptor, n_bytes) == 0, "ftruncate");
+  if (n_bytes > 0) {
+    void* address = mmap(
+      nullptr, n_bytes, PROT_READ | PROT_WRITE, MAP_SHARED, file_descriptor, 0
+    );
+    check_system_call(address != MAP_FAILED, "mmap");
+    region = std::shared_ptr<char>(
+      static_cast<char*>(address),
+      [n_bytes](char* address) { munmap(address, n_bytes); }
+    );
+    data_ptr = reinterpret_cast<double*>(region.get());
+  }
+  // The mapping keeps the file alive, even if it was unlinked
+  close(file_descriptor);
+}
+
+MappedFile::MappedFile(
+  const std::shared_ptr<char>& region, double* data,
+  const int64_t n_rows, const int64_t n_cols
+) : dim{n_rows, n_cols}, stride(n_cols), region(region), data_ptr(data),
+    is_window(true) {}
+
+double* MappedFile::data() const { return data_ptr; }
+
+uint64_t MappedFile::size() const { return dim[0] * stride; }
+
+void MappedFile::advise(
+  const double* begin, const uint64_t n_elements, const MemoryAccess access
+) const {
+  if (n_elements == 0) return;
+  int advice = MADV_NORMAL;
+  switch (access) {
+    case MemoryAccess::Normal: advice = MADV_NORMAL; break;
+    case MemoryAccess::Sequential: advice = MADV_SEQUENTIAL; break;
+    case MemoryAccess::Random: advice = MADV_RANDOM; break;
+    case MemoryAccess::WillNeed: advice = MADV_WILLNEED; break;
+    case MemoryAccess::DontNeed:
+      if (!is_window) {
+        advice = MADV_DONTNEED;
+        break;
+      }
+      // Windows may be private mappings, in which MADV_DONTNEED would discard
+      // modified pages instead of writing them back. Paging them out keeps
+      // their contents.
+#ifdef MADV_PAGEOUT
+      advice = MADV_PAGEOUT;
+      break;
+#else
+      return;
+#endif
+  }
+  const uintptr_t first = reinterpret_cast<uintptr_t>(begin);
+  const uintptr_t last = reinterpret_cast<uintptr_t>(begin + n_elements);
+  const uintptr_t start = first / page_size() * page_size();
+  madvise(reinterpret_cast<void*>(start), last - start, advice);
+}
+
+// Map the whole file and close the descriptor, which the mapping outlives
+std::shared_ptr<char> map_descriptor(
+  const int file_descriptor, uint64_t& n_bytes, const int protection,
+  const int flags
+) {
+  n_bytes = 0;
+  if (file_descriptor == -1) return nullptr;
+  struct stat file_status;
+  check_system_call(fstat(file_descriptor, &file_status) == 0, "fstat");
+  const uint64_t size = file_status.st_size;
+  if (size == 0) {
+    close(file_descriptor);
+    return nullptr;
+  }
+  void* address = mmap(nullptr, size, protection, flags, file_descriptor, 0);
+  close(file_descriptor);
+  check_system_call(address != MAP_FAILED, "mmap");
+  n_bytes = size;
+  return std::shared_ptr<char>(
+    static_cast<char*>(address), [size](char* address) { munmap(address, size); }
+  );
+}
+
+std::shared_ptr<char> map_file(const std::string& filename, uint64_t& n_bytes) {
+  return map_descriptor(
+    open(filename.c_str(), O_RDONLY), n_bytes,
+    PROT_READ | PROT_WRITE, MAP_PRIVATE
+  );
+}
+
+std::shared_ptr<char> map_shared_memory(
+  const std::string& name, uint64_t& n_bytes
+) {
+  return map_descriptor(
+    shm_open(name.c_str(), O_RDONLY, 0), n_bytes,
+    PROT_READ | PROT_WRITE, MAP_PRIVATE
+  );
+}
+
+} // namespace FRANK
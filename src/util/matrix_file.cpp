@@ -0,0 +1,114 @@
+#include "FRANK/util/matrix_file.h"
+
+#include "FRANK/classes/dense.h"
+
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <vector>
+
+
+namespace FRANK
+{
+
+const char matrix_file_magic[8] = {'F', 'R', 'A', 'N', 'K', 'M', 'A', 'T'};
+
+MatrixFileHeader::MatrixFileHeader(
+  const int64_t n_rows, const int64_t n_cols, const MatrixLayout ordering
+) : n_rows(n_rows), n_cols(n_cols),
+    layout(ordering == MatrixLayout::RowMajor ? 0 : 1) {
+  std::memcpy(magic, matrix_file_magic, sizeof(magic));
+}
+
+bool MatrixFileHeader::is_valid() const {
+  return (
+    std::memcmp(magic, matrix_file_magic, sizeof(magic)) == 0
+    && n_rows >= 0 && n_cols >= 0 && (layout == 0 || layout == 1)
+  );
+}
+
+MatrixLayout MatrixFileHeader::get_layout() const {
+  return layout == 0 ? MatrixLayout::RowMajor : MatrixLayout::ColumnMajor;
+}
+
+std::ofstream open_binary_matrix_file(
+  const std::string& filename, const MatrixFileHeader& header
+) {
+  std::ofstream file(filename, std::ios::binary | std::ios::trunc);
+  if (!file) {
+    std::cerr << "Could not create matrix file: " << filename << std::endl;
+    std::abort();
+  }
+  file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+  return file;
+}
+
+void write_matrix_file(
+  const Dense& A, const std::string filename, const MatrixLayout ordering
+) {
+  std::ofstream file = open_binary_matrix_file(
+    filename, MatrixFileHeader(A.dim[0], A.dim[1], ordering)
+  );
+  switch (ordering) {
+    case MatrixLayout::RowMajor:
+      for (int64_t i=0; i<A.dim[0]; ++i) {
+        file.write(
+          reinterpret_cast<const char*>(&A + i*A.stride), A.dim[1]*sizeof(double)
+        );
+      }
+      break;
+    case MatrixLayout::ColumnMajor: {
+      std::vector<double> column(A.dim[0]);
+      for (int64_t j=0; j<A.dim[1]; ++j) {
+        for (int64_t i=0; i<A.dim[0]; ++i) column[i] = A(i, j);
+        file.write(
+          reinterpret_cast<const char*>(column.data()), A.dim[0]*sizeof(double)
+        );
+      }
+      break;
+    }
+  }
+  if (!file) {
+    std::cerr << "Could not write matrix file: " << filename << std::endl;
+    std::abort();
+  }
+}
+
+void convert_matrix_file(
+  const std::string text_filename, const std::string binary_filename,
+  const MatrixLayout ordering
+) {
+  std::ifstream text_file(text_filename);
+  if (!text_file) {
+    std::cerr << "Could not open matrix file: " << text_filename << std::endl;
+    std::abort();
+  }
+  int64_t n_rows, n_cols;
+  text_file >> n_rows >> n_cols;
+  std::ofstream binary_file = open_binary_matrix_file(
+    binary_filename, MatrixFileHeader(n_rows, n_cols, ordering)
+  );
+  // The text file holds the elements in the same order as the binary file, so
+  // one line (a row or a column) is converted at a time
+  const int64_t n_lines = ordering == MatrixLayout::RowMajor ? n_rows : n_cols;
+  std::vector<double> line(ordering == MatrixLayout::RowMajor ? n_cols : n_rows);
+  for (int64_t i=0; i<n_lines; ++i) {
+    for (double& a : line) text_file >> a;
+    if (!text_file) {
+      std::cerr << "Matrix file ended early: " << text_filename << std::endl;
+      std::abort();
+    }
+    binary_file.write(
+      reinterpret_cast<const char*>(line.data()), line.size()*sizeof(double)
+    );
+  }
+  if (!binary_file) {
+    std::cerr << "Could not write matrix file: " << binary_filename << std::endl;
+    std::abort();
+  }
+}
+
+} // namespace FRANK
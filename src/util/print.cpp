@@ -1,10 +1,16 @@
 #include "FRANK/util/print.h"
 
+#include "FRANK/classes/basic_dense.h"
+#include "FRANK/classes/basic_low_rank.h"
 #include "FRANK/classes/dense.h"
+#include "FRANK/classes/diagonal.h"
 #include "FRANK/classes/empty.h"
 #include "FRANK/classes/hierarchical.h"
+#include "FRANK/classes/identity.h"
 #include "FRANK/classes/low_rank.h"
 #include "FRANK/classes/matrix.h"
+#include "FRANK/classes/mixed_precision_low_rank.h"
+#include "FRANK/classes/out_of_core_hierarchical.h"
 #include "FRANK/operations/LAPACK.h"
 #include "FRANK/operations/misc.h"
 #include "FRANK/util/omm_error_handler.h"
@@ -35,18 +41,58 @@ define_method(std::string, type_omm, (const Dense&)) {
   return "Dense";
 }
 
+define_method(std::string, type_omm, (const SDense&)) {
+  return "SDense";
+}
+
+define_method(std::string, type_omm, (const CDense&)) {
+  return "CDense";
+}
+
+define_method(std::string, type_omm, (const ZDense&)) {
+  return "ZDense";
+}
+
+define_method(std::string, type_omm, (const SLowRank&)) {
+  return "SLowRank";
+}
+
+define_method(std::string, type_omm, (const CLowRank&)) {
+  return "CLowRank";
+}
+
+define_method(std::string, type_omm, (const ZLowRank&)) {
+  return "ZLowRank";
+}
+
 define_method(std::string, type_omm, (const Empty&)) {
   return "Empty";
 }
 
+define_method(std::string, type_omm, (const Identity&)) {
+  return "Identity";
+}
+
+define_method(std::string, type_omm, (const Diagonal&)) {
+  return "Diagonal";
+}
+
 define_method(std::string, type_omm, (const LowRank&)) {
   return "LowRank";
 }
 
+define_method(std::string, type_omm, (const MixedPrecisionLowRank&)) {
+  return "MixedPrecisionLowRank";
+}
+
 define_method(std::string, type_omm, (const Hierarchical&)) {
   return "Hierarchical";
 }
 
+define_method(std::string, type_omm, (const SpilledBlock&)) {
+  return "SpilledBlock";
+}
+
 define_method(std::string, type_omm, (const Matrix&)) {
   return "Matrix";
 }
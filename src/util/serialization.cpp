@@ -0,0 +1,461 @@
+#include "FRANK/util/serialization.h"
+
+#include "FRANK/definitions.h"
+#include "FRANK/classes/dense.h"
+#include "FRANK/classes/empty.h"
+#include "FRANK/classes/hierarchical.h"
+#include "FRANK/classes/low_rank.h"
+#include "FRANK/classes/matrix.h"
+#include "FRANK/classes/matrix_proxy.h"
+#include "FRANK/util/mapped_file.h"
+#include "FRANK/util/omm_error_handler.h"
+
+#include "yorel/yomm2/cute.hpp"
+using yorel::yomm2::virtual_;
+
+#include <array>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <unistd.h>
+
+
+namespace FRANK
+{
+
+enum class BlockType : int64_t { Dense, LowRank, Hierarchical, Empty };
+
+template<typename T>
+void write_value(std::vector<char>& buffer, const T value) {
+  const char* bytes = reinterpret_cast<const char*>(&value);
+  buffer.insert(buffer.end(), bytes, bytes+sizeof(T));
+}
+
+declare_method(
+  void, write_block, (virtual_<const Matrix&>, std::vector<char>&)
+)
+
+void serialize(const Matrix& A, std::vector<char>& buffer) {
+  write_block(A, buffer);
+}
+
+define_method(void, write_block, (const Dense& A, std::vector<char>& buffer)) {
+  write_value(buffer, BlockType::Dense);
+  write_value(buffer, A.dim[0]);
+  write_value(buffer, A.dim[1]);
+  for (int64_t i=0; i<A.dim[0]; ++i) {
+    const char* row = reinterpret_cast<const char*>(&A + i*A.stride);
+    buffer.insert(buffer.end(), row, row+A.dim[1]*sizeof(double));
+  }
+}
+
+define_method(
+  void, write_block, (const LowRank& A, std::vector<char>& buffer)
+) {
+  write_value(buffer, BlockType::LowRank);
+  write_block(A.U, buffer);
+  write_block(A.S, buffer);
+  write_block(A.V, buffer);
+}
+
+define_method(
+  void, write_block, (const Hierarchical& A, std::vector<char>& buffer)
+) {
+  write_value(buffer, BlockType::Hierarchical);
+  write_value(buffer, A.dim[0]);
+  write_value(buffer, A.dim[1]);
+  for (int64_t i=0; i<A.dim[0]; ++i) {
+    for (int64_t j=0; j<A.dim[1]; ++j) {
+      write_block(A(i, j), buffer);
+    }
+  }
+}
+
+define_method(void, write_block, (const Empty& A, std::vector<char>& buffer)) {
+  write_value(buffer, BlockType::Empty);
+  write_value(buffer, A.dim[0]);
+  write_value(buffer, A.dim[1]);
+}
+
+define_method(void, write_block, (const Matrix& A, std::vector<char>&)) {
+  omm_error_handler("write_block", {A}, __FILE__, __LINE__);
+  std::abort();
+}
+
+// Reads from a representation ending at end, or of unknown length if end is
+// null. If region is set, the representation lies in that mapping and Dense
+// matrices become views into it instead of copies.
+class BlockReader {
+ public:
+  const char* position;
+  const char* end;
+  std::shared_ptr<char> region;
+
+  BlockReader(
+    const char* position, const char* end, std::shared_ptr<char> region
+  ) : position(position), end(end), region(std::move(region)) {}
+
+  [[noreturn]] void corrupt() const {
+    std::cerr << "Serialized matrix is corrupt or truncated" << std::endl;
+    std::abort();
+  }
+
+  void check(const uint64_t n_bytes) const {
+    if (end != nullptr && n_bytes > uint64_t(end - position)) corrupt();
+  }
+
+  template<typename T>
+  T read_value() {
+    check(sizeof(T));
+    T value;
+    std::memcpy(&value, position, sizeof(T));
+    position += sizeof(T);
+    return value;
+  }
+
+  std::array<int64_t, 2> read_dim() {
+    const int64_t n_rows = read_value<int64_t>();
+    const int64_t n_cols = read_value<int64_t>();
+    if (n_rows < 0 || n_cols < 0) corrupt();
+    return {n_rows, n_cols};
+  }
+
+  Dense read_dense() {
+    if (read_value<BlockType>() != BlockType::Dense) corrupt();
+    const std::array<int64_t, 2> dim = read_dim();
+    const uint64_t n_bytes = dim[0]*dim[1]*sizeof(double);
+    check(n_bytes);
+    const char* elements = position;
+    position += n_bytes;
+    if (region) {
+      double* data = reinterpret_cast<double*>(const_cast<char*>(elements));
+      return Dense(std::make_shared<MappedFile>(region, data, dim[0], dim[1]));
+    }
+    Dense A(dim[0], dim[1]);
+    std::memcpy(&A, elements, n_bytes);
+    return A;
+  }
+
+  MatrixProxy read_block() {
+    const char* start = position;
+    const BlockType type = read_value<BlockType>();
+    switch (type) {
+      case BlockType::Dense:
+        position = start;
+        return read_dense();
+      case BlockType::LowRank: {
+        Dense U = read_dense();
+        Dense S = read_dense();
+        Dense V = read_dense();
+        return LowRank(std::move(U), std::move(S), std::move(V));
+      }
+      case BlockType::Hierarchical: {
+        const std::array<int64_t, 2> dim = read_dim();
+        Hierarchical A(dim[0], dim[1]);
+        for (int64_t i=0; i<dim[0]; ++i) {
+          for (int64_t j=0; j<dim[1]; ++j) {
+            A(i, j) = read_block();
+          }
+        }
+        return A;
+      }
+      case BlockType::Empty: {
+        const std::array<int64_t, 2> dim = read_dim();
+        return Empty(dim[0], dim[1]);
+      }
+    }
+    corrupt();
+  }
+};
+
+MatrixProxy deserialize(const char*& position) {
+  BlockReader reader(position, nullptr, nullptr);
+  MatrixProxy A = reader.read_block();
+  position = reader.position;
+  return A;
+}
+
+// Binary matrix file layout: FileHeader followed by the serialized matrices
+struct FileHeader {
+  char magic[8] = {'F', 'R', 'A', 'N', 'K', 'S', 'E', 'R'};
+  int64_t version = 1;
+  int64_t n_matrices = 0;
+  int64_t step = 0;
+  uint64_t payload_size = 0;
+  int64_t has_checksum = 0;
+  uint64_t checksum = 0;
+  // Identifies the input of the algorithm writing a checkpoint, zero if unset
+  uint64_t fingerprint = 0;
+};
+
+// 64 bit FNV-1a over 8 byte words. Serialized data is always a whole number
+// of words.
+uint64_t update_checksum(uint64_t hash, const char* data, const uint64_t n_bytes) {
+  for (uint64_t i=0; i<n_bytes; i+=sizeof(uint64_t)) {
+    uint64_t word;
+    std::memcpy(&word, data+i, sizeof(word));
+    hash = (hash ^ word) * 1099511628211ull;
+  }
+  return hash;
+}
+
+constexpr uint64_t checksum_seed = 14695981039346656037ull;
+
+// Hashes the same bytes as write_streamed(), one top level block at a time
+declare_method(
+  void, update_fingerprint, (virtual_<const Matrix&>, uint64_t&)
+)
+
+uint64_t fingerprint(const Matrix& A) {
+  uint64_t hash = checksum_seed;
+  update_fingerprint(A, hash);
+  return hash;
+}
+
+define_method(
+  void, update_fingerprint, (const Hierarchical& A, uint64_t& hash)
+) {
+  std::vector<char> buffer;
+  write_value(buffer, BlockType::Hierarchical);
+  write_value(buffer, A.dim[0]);
+  write_value(buffer, A.dim[1]);
+  hash = update_checksum(hash, buffer.data(), buffer.size());
+  for (int64_t i=0; i<A.dim[0]; ++i) {
+    for (int64_t j=0; j<A.dim[1]; ++j) {
+      update_fingerprint(A(i, j), hash);
+    }
+  }
+}
+
+define_method(void, update_fingerprint, (const Matrix& A, uint64_t& hash)) {
+  std::vector<char> buffer;
+  write_block(A, buffer);
+  hash = update_checksum(hash, buffer.data(), buffer.size());
+}
+
+void write_all(
+  const int file_descriptor, const char* data, const uint64_t n_bytes,
+  const uint64_t offset
+) {
+  uint64_t done = 0;
+  while (done < n_bytes) {
+    const ssize_t n = pwrite(
+      file_descriptor, data+done, n_bytes-done, offset+done
+    );
+    if (n <= 0) {
+      std::perror("pwrite");
+      std::abort();
+    }
+    done += n;
+  }
+}
+
+// Writes serialized matrices one top level block at a time, so that a large
+// matrix is never held in memory twice. The header is written last, so that
+// readers never take a partially written file as valid.
+class FileWriter {
+ public:
+  const int file_descriptor;
+  const bool checksum;
+  FileHeader header;
+  std::vector<char> buffer;
+
+  FileWriter(
+    const int file_descriptor, const std::string& name, const bool checksum
+  ) : file_descriptor(file_descriptor), checksum(checksum) {
+    if (file_descriptor == -1) {
+      std::perror(name.c_str());
+      std::abort();
+    }
+    header.has_checksum = checksum;
+    header.checksum = checksum ? checksum_seed : 0;
+    const std::vector<char> zeros(sizeof(FileHeader), 0);
+    write_all(file_descriptor, zeros.data(), zeros.size(), 0);
+  }
+
+  void flush() {
+    if (checksum) {
+      header.checksum = update_checksum(header.checksum, buffer.data(), buffer.size());
+    }
+    write_all(
+      file_descriptor, buffer.data(), buffer.size(),
+      sizeof(header) + header.payload_size
+    );
+    header.payload_size += buffer.size();
+    buffer.clear();
+  }
+
+  void write(
+    const std::vector<const Matrix*>& matrices, const int64_t step,
+    const uint64_t fingerprint=0
+  );
+};
+
+declare_method(void, write_streamed, (virtual_<const Matrix&>, FileWriter&))
+
+define_method(void, write_streamed, (const Hierarchical& A, FileWriter& writer)) {
+  write_value(writer.buffer, BlockType::Hierarchical);
+  write_value(writer.buffer, A.dim[0]);
+  write_value(writer.buffer, A.dim[1]);
+  for (int64_t i=0; i<A.dim[0]; ++i) {
+    for (int64_t j=0; j<A.dim[1]; ++j) {
+      write_streamed(A(i, j), writer);
+    }
+  }
+}
+
+define_method(void, write_streamed, (const Matrix& A, FileWriter& writer)) {
+  write_block(A, writer.buffer);
+  writer.flush();
+}
+
+void FileWriter::write(
+  const std::vector<const Matrix*>& matrices, const int64_t step,
+  const uint64_t fingerprint
+) {
+  for (const Matrix* A : matrices) write_streamed(*A, *this);
+  flush();
+  header.n_matrices = matrices.size();
+  header.step = step;
+  header.fingerprint = fingerprint;
+  write_all(
+    file_descriptor, reinterpret_cast<const char*>(&header), sizeof(header), 0
+  );
+  close(file_descriptor);
+}
+
+// Rebuild the matrices stored in a mapping of a whole file
+std::tuple<std::vector<MatrixProxy>, int64_t> read_matrices(
+  const std::shared_ptr<char>& region, const uint64_t n_bytes,
+  const bool verify, const std::string& name
+) {
+  FileHeader header;
+  const FileHeader expected;
+  if (n_bytes >= sizeof(header)) std::memcpy(&header, region.get(), sizeof(header));
+  if (
+    n_bytes < sizeof(header)
+    || std::memcmp(header.magic, expected.magic, sizeof(header.magic)) != 0
+    || header.version != expected.version
+    || header.payload_size > n_bytes - sizeof(header)
+  ) {
+    std::cerr << "Not a valid matrix file: " << name << std::endl;
+    std::abort();
+  }
+  const char* payload = region.get() + sizeof(header);
+  if (verify && header.has_checksum) {
+    const uint64_t checksum = update_checksum(
+      checksum_seed, payload, header.payload_size
+    );
+    if (checksum != header.checksum) {
+      std::cerr << "Checksum mismatch in matrix file: " << name << std::endl;
+      std::abort();
+    }
+  }
+  BlockReader reader(payload, payload + header.payload_size, region);
+  std::vector<MatrixProxy> matrices;
+  for (int64_t i=0; i<header.n_matrices; ++i) {
+    matrices.push_back(reader.read_block());
+  }
+  return {std::move(matrices), header.step};
+}
+
+void save(const Matrix& A, const std::string filename, const bool checksum) {
+  save_checkpoint({&A}, 0, filename, checksum);
+}
+
+MatrixProxy load(const std::string filename, const bool verify) {
+  std::vector<MatrixProxy> matrices;
+  std::tie(matrices, std::ignore) = load_checkpoint(filename, verify);
+  if (matrices.size() != 1) {
+    std::cerr << "Expected a single matrix in " << filename << std::endl;
+    std::abort();
+  }
+  return std::move(matrices[0]);
+}
+
+void save_checkpoint(
+  const std::vector<const Matrix*>& matrices, const int64_t step,
+  const std::string filename, const bool checksum, const uint64_t fingerprint
+) {
+  const std::string temporary_filename = filename + ".tmp";
+  FileWriter writer(
+    open(temporary_filename.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644),
+    temporary_filename, checksum
+  );
+  writer.write(matrices, step, fingerprint);
+  if (std::rename(temporary_filename.c_str(), filename.c_str()) != 0) {
+    std::perror("rename");
+    std::abort();
+  }
+}
+
+std::tuple<std::vector<MatrixProxy>, int64_t> load_checkpoint(
+  const std::string filename, const bool verify
+) {
+  if (access(filename.c_str(), F_OK) != 0) {
+    return {std::vector<MatrixProxy>(), 0};
+  }
+  uint64_t n_bytes;
+  const std::shared_ptr<char> region = map_file(filename, n_bytes);
+  return read_matrices(region, n_bytes, verify, filename);
+}
+
+uint64_t checkpoint_fingerprint(const std::string filename) {
+  const int file_descriptor = open(filename.c_str(), O_RDONLY);
+  if (file_descriptor == -1) return 0;
+  FileHeader header;
+  const FileHeader expected;
+  const bool complete = (
+    pread(file_descriptor, &header, sizeof(header), 0) == sizeof(header)
+  );
+  close(file_descriptor);
+  if (
+    !complete
+    || std::memcmp(header.magic, expected.magic, sizeof(header.magic)) != 0
+    || header.version != expected.version
+  ) {
+    return 0;
+  }
+  return header.fingerprint;
+}
+
+void publish(
+  const std::vector<const Matrix*>& matrices, const std::string name,
+  const bool checksum
+) {
+  // Truncating an object that other processes have mapped would make their
+  // accesses fail, so a new object replaces the old one under its name
+  shm_unlink(name.c_str());
+  FileWriter writer(
+    shm_open(name.c_str(), O_RDWR | O_CREAT | O_EXCL, 0644), name, checksum
+  );
+  writer.write(matrices, 0);
+}
+
+std::vector<MatrixProxy> attach(const std::string name, const bool verify) {
+  uint64_t n_bytes;
+  const std::shared_ptr<char> region = map_shared_memory(name, n_bytes);
+  if (!region) {
+    std::cerr << "Shared memory object not found: " << name << std::endl;
+    std::abort();
+  }
+  std::vector<MatrixProxy> matrices;
+  std::tie(matrices, std::ignore) = read_matrices(region, n_bytes, verify, name);
+  return matrices;
+}
+
+void unpublish(const std::string name) {
+  shm_unlink(name.c_str());
+}
+
+} // namespace FRANK
@@ -0,0 +1,238 @@
+#include <cmath>
+#include <complex>
+#include <cstdint>
+#include <tuple>
+#include <type_traits>
+#include <vector>
+
+#include "FRANK/FRANK.h"
+#include "FRANK/classes/initialization_helpers/index_range.h"
+#include "FRANK/classes/initialization_helpers/matrix_initializer_complex_kernel.h"
+#include "gtest/gtest.h"
+
+template<typename T>
+class BasicDenseTests : public testing::Test {
+ protected:
+  void SetUp() override {
+    FRANK::initialize();
+  }
+  // Fill with a diagonally dominant matrix so that LU without pivoting is stable
+  FRANK::BasicDense<T> make_matrix(const int64_t m, const int64_t n) {
+    const FRANK::Dense real(FRANK::random_uniform, {}, m, n);
+    const FRANK::Dense imag(FRANK::random_uniform, {}, m, n);
+    FRANK::BasicDense<T> A(m, n);
+    for (int64_t i=0; i<m; ++i) {
+      for (int64_t j=0; j<n; ++j) {
+        A(i, j) = make_scalar(real(i, j), imag(i, j));
+      }
+      if (i < n) A(i, i) += T(n);
+    }
+    return A;
+  }
+  static T make_scalar(const double re, const double im) {
+    if constexpr (std::is_same_v<T, float>) {
+      return re;
+    } else {
+      return T(re, im);
+    }
+  }
+  // Relative accuracy expected from the scalar type
+  static double tolerance() {
+    return std::is_same_v<T, std::complex<double>> ? 1e-12 : 1e-4;
+  }
+};
+
+using ScalarTypes = testing::Types<
+  float, std::complex<float>, std::complex<double>
+>;
+TYPED_TEST_SUITE(BasicDenseTests, ScalarTypes);
+
+TYPED_TEST(BasicDenseTests, Gemm) {
+  constexpr int64_t M = 40, N = 24, K = 36;
+  const FRANK::BasicDense<TypeParam> A = this->make_matrix(M, K);
+  const FRANK::BasicDense<TypeParam> B = this->make_matrix(N, K);
+  FRANK::BasicDense<TypeParam> C = this->make_matrix(M, N);
+  const FRANK::BasicDense<TypeParam> C_copy(C);
+  const TypeParam alpha = this->make_scalar(0.5, -1);
+  const TypeParam beta = this->make_scalar(2, 0.25);
+  FRANK::gemm(A, B, C, alpha, beta, false, true);
+  const FRANK::BasicDense<TypeParam> AB = FRANK::gemm(A, B, alpha, false, true);
+  for (int64_t i=0; i<M; ++i) {
+    for (int64_t j=0; j<N; ++j) {
+      TypeParam check = beta * C_copy(i, j);
+      for (int64_t k=0; k<K; ++k) check += alpha * A(i, k) * B(j, k);
+      EXPECT_LE(std::abs(check - C(i, j)), this->tolerance() * std::abs(check));
+      EXPECT_LE(
+        std::abs(check - beta*C_copy(i, j) - AB(i, j)),
+        this->tolerance() * std::abs(check)
+      );
+    }
+  }
+}
+
+TYPED_TEST(BasicDenseTests, GetrfTrsm) {
+  constexpr int64_t N = 48, NRHS = 8;
+  FRANK::BasicDense<TypeParam> A = this->make_matrix(N, N);
+  const FRANK::BasicDense<TypeParam> x = this->make_matrix(N, NRHS);
+  FRANK::BasicDense<TypeParam> b = FRANK::gemm(A, x);
+  FRANK::BasicDense<TypeParam> L, U;
+  std::tie(L, U) = FRANK::getrf(A);
+  FRANK::trsm(L, b, FRANK::Mode::Lower);
+  FRANK::trsm(U, b, FRANK::Mode::Upper);
+  double diff = 0, l2 = 0;
+  for (int64_t i=0; i<N; ++i) {
+    for (int64_t j=0; j<NRHS; ++j) {
+      diff += std::norm(x(i, j) - b(i, j));
+      l2 += std::norm(x(i, j));
+    }
+  }
+  EXPECT_LE(std::sqrt(diff / l2), this->tolerance());
+}
+
+TYPED_TEST(BasicDenseTests, MatrixInterface) {
+  constexpr int64_t M = 16, N = 8;
+  const FRANK::BasicDense<TypeParam> A = this->make_matrix(M, N);
+  // Type independent functions dispatch on BasicDense
+  EXPECT_EQ(FRANK::get_n_rows(A), M);
+  EXPECT_EQ(FRANK::get_n_cols(A), N);
+  EXPECT_EQ(
+    FRANK::get_memory_usage(A, false), M * N * sizeof(TypeParam)
+  );
+  double l2 = 0;
+  for (int64_t i=0; i<M; ++i) {
+    for (int64_t j=0; j<N; ++j) l2 += std::norm(A(i, j));
+  }
+  EXPECT_DOUBLE_EQ(FRANK::norm(A), l2);
+  // Storage in a Hierarchical goes through MatrixProxy
+  FRANK::Hierarchical H(2, 1);
+  H(0, 0) = FRANK::BasicDense<TypeParam>(A);
+  H(1, 0) = FRANK::BasicDense<TypeParam>(A);
+  EXPECT_EQ(FRANK::get_n_rows(H), 2 * M);
+  EXPECT_DOUBLE_EQ(FRANK::norm(H), 2 * l2);
+}
+
+TEST(BasicDenseConversionTests, DenseRoundTrip) {
+  FRANK::initialize();
+  const FRANK::Dense D(FRANK::random_normal, {}, 12, 10);
+  const FRANK::SDense S(D);
+  const FRANK::Dense DS(S);
+  const FRANK::ZDense Z(D);
+  EXPECT_LE(FRANK::l2_error(D, DS), 1e-7);
+  for (int64_t i=0; i<D.dim[0]; ++i) {
+    for (int64_t j=0; j<D.dim[1]; ++j) {
+      EXPECT_EQ(S(i, j), static_cast<float>(D(i, j)));
+      EXPECT_EQ(Z(i, j), std::complex<double>(D(i, j), 0));
+    }
+  }
+  // Half the memory of the double precision matrix
+  EXPECT_EQ(2 * FRANK::get_memory_usage(S, false), FRANK::get_memory_usage(D, false));
+}
+
+TYPED_TEST(BasicDenseTests, LowRankCompression) {
+  constexpr int64_t M = 40, N = 32, RANK = 4;
+  const FRANK::BasicDense<TypeParam> A = FRANK::gemm(
+    this->make_matrix(M, RANK), this->make_matrix(RANK, N)
+  );
+  const FRANK::BasicLowRank<TypeParam> LR(A, this->tolerance());
+  EXPECT_EQ(LR.rank, RANK);
+  const FRANK::BasicLowRank<TypeParam> LR_fixed(A, int64_t(RANK));
+  EXPECT_EQ(LR_fixed.rank, RANK);
+  const FRANK::BasicDense<TypeParam> A_check = FRANK::gemm(
+    FRANK::gemm(LR.U, LR.S), LR.V
+  );
+  double diff = 0, l2 = 0;
+  for (int64_t i=0; i<M; ++i) {
+    for (int64_t j=0; j<N; ++j) {
+      diff += std::norm(A(i, j) - A_check(i, j));
+      l2 += std::norm(A(i, j));
+    }
+  }
+  EXPECT_LE(std::sqrt(diff / l2), 10 * this->tolerance());
+  EXPECT_NEAR(FRANK::norm(LR), l2, 10 * this->tolerance() * l2);
+  EXPECT_EQ(FRANK::get_n_rows(LR), M);
+  EXPECT_EQ(FRANK::get_n_cols(LR), N);
+  // Empty matrices are compressed to rank 0
+  const FRANK::BasicLowRank<TypeParam> LR_empty(
+    FRANK::BasicDense<TypeParam>(M, 0), int64_t(RANK)
+  );
+  EXPECT_EQ(LR_empty.rank, 0);
+  EXPECT_EQ(FRANK::get_n_rows(LR_empty), M);
+  EXPECT_EQ(FRANK::get_n_cols(LR_empty), 0);
+}
+
+TYPED_TEST(BasicDenseTests, HierarchicalGemm) {
+  constexpr int64_t N = 24, RANK = 3, NRHS = 5;
+  const FRANK::BasicDense<TypeParam> D = this->make_matrix(N, N);
+  const FRANK::BasicDense<TypeParam> A01 = FRANK::gemm(
+    this->make_matrix(N, RANK), this->make_matrix(RANK, N)
+  );
+  FRANK::Hierarchical H(2, 2);
+  H(0, 0) = FRANK::BasicDense<TypeParam>(D);
+  H(0, 1) = FRANK::BasicLowRank<TypeParam>(A01, int64_t(RANK));
+  H(1, 0) = FRANK::BasicLowRank<TypeParam>(A01, int64_t(RANK));
+  H(1, 1) = FRANK::BasicDense<TypeParam>(D);
+  const FRANK::BasicDense<TypeParam> x = this->make_matrix(2*N, NRHS);
+  const FRANK::BasicDense<TypeParam> c = this->make_matrix(2*N, NRHS);
+  FRANK::BasicDense<TypeParam> b(c);
+  const TypeParam alpha = this->make_scalar(0.5, -1);
+  const TypeParam beta = this->make_scalar(2, 1);
+  FRANK::gemm(H, x, b, alpha, beta);
+  for (int64_t i=0; i<2*N; ++i) {
+    for (int64_t j=0; j<NRHS; ++j) {
+      TypeParam check = beta * c(i, j);
+      for (int64_t k=0; k<2*N; ++k) {
+        const bool diagonal = (i < N) == (k < N);
+        const TypeParam a = diagonal ? D(i%N, k%N) : A01(i%N, k%N);
+        check += alpha * a * x(k, j);
+      }
+      EXPECT_LE(
+        std::abs(check - b(i, j)), 10 * this->tolerance() * std::abs(check)
+      );
+    }
+  }
+}
+
+TEST(BasicDenseConversionTests, ComplexKernelHierarchical) {
+  FRANK::initialize();
+  constexpr int64_t N = 256, NLEAF = 32, NRHS = 2;
+  constexpr double EPS = 1e-8;
+  const FRANK::Geometry geometry(std::vector<std::vector<double>>{
+    FRANK::get_sorted_random_vector(N)
+  });
+  const FRANK::Hierarchical A(
+    FRANK::helmholtznd_complex, geometry, N, N, NLEAF, EPS, 0
+  );
+  EXPECT_EQ(FRANK::type(A(0, 1)), "ZLowRank");
+  EXPECT_EQ(FRANK::get_n_rows(A), N);
+
+  FRANK::ZDense D(N, N);
+  FRANK::helmholtznd_complex(&D, N, N, D.stride, geometry, 0, 0);
+  FRANK::ZDense x(N, NRHS);
+  for (int64_t i=0; i<N; ++i) {
+    for (int64_t j=0; j<NRHS; ++j) x(i, j) = std::complex<double>(i%7, j+1);
+  }
+  FRANK::ZDense b(N, NRHS), b_check(N, NRHS);
+  const std::complex<double> one(1), zero(0);
+  FRANK::gemm(A, x, b, one, zero);
+  FRANK::gemm(D, x, b_check, one, zero);
+  double diff = 0, l2 = 0;
+  for (int64_t i=0; i<N; ++i) {
+    for (int64_t j=0; j<NRHS; ++j) {
+      diff += std::norm(b(i, j) - b_check(i, j));
+      l2 += std::norm(b_check(i, j));
+    }
+  }
+  EXPECT_LE(std::sqrt(diff / l2), EPS);
+  // Complex values cannot be stored through the real valued interface
+  const FRANK::MatrixInitializerComplexKernel initializer(
+    FRANK::helmholtznd_complex, geometry, 0, EPS, 0,
+    FRANK::AdmisType::PositionBased
+  );
+  FRANK::Dense real(4, 4);
+  EXPECT_DEATH(
+    initializer.fill_dense_representation(
+      real, FRANK::IndexRange(8, 4), FRANK::IndexRange(100, 4)
+    ),
+    "Complex kernel value"
+  );
+}
@@ -8,8 +8,8 @@
 
 class ArithmeticTests
     : public testing::TestWithParam<std::tuple<int64_t, int64_t>> {};
-//class MatMulOperatorTests
-//    : public testing::TestWithParam<std::tuple<int64_t, int64_t, int64_t>> {};
+class MatMulOperatorTests
+    : public testing::TestWithParam<std::tuple<int64_t, int64_t, int64_t>> {};
 class ArithmeticTests2
     : public testing::TestWithParam<std::tuple<int64_t, int64_t, double>> {};
 
@@ -160,8 +160,6 @@ INSTANTIATE_TEST_SUITE_P(
       return name;
     });
 
-/*
-// TODO implement
 TEST_P(MatMulOperatorTests, MultiplicationOperator) {
   int64_t m, n, k;
   std::tie(m, n, k) = GetParam();
@@ -173,7 +171,7 @@ TEST_P(MatMulOperatorTests, MultiplicationOperator) {
   const FRANK::Dense B(FRANK::laplacend, randx_B, k, n);
   const FRANK::Dense C_check = A * B;
   FRANK::Dense C(m, n);
-  FRANK::gemm(A, B, C, false, false, 1, 0);
+  FRANK::gemm(A, B, C, 1, 0);
 
   // Check result
   for (int64_t i = 0; i < m; ++i) {
@@ -183,6 +181,36 @@ TEST_P(MatMulOperatorTests, MultiplicationOperator) {
   }
 }
 
+TEST_P(MatMulOperatorTests, MultiplicationChain) {
+  int64_t m, n, k;
+  std::tie(m, n, k) = GetParam();
+  constexpr int64_t rank = 4;
+
+  FRANK::initialize();
+  const FRANK::Dense U(FRANK::random_uniform, {}, m, rank);
+  const FRANK::Dense S(FRANK::random_uniform, {}, rank, rank);
+  const FRANK::Dense V(FRANK::random_uniform, {}, rank, k);
+  const FRANK::Dense B(FRANK::random_uniform, {}, n, k);
+  const FRANK::MatrixProduct USVBt =
+    FRANK::MatrixProduct(U).times(S).times(V).times(B, true);
+  FRANK::Dense C(FRANK::random_uniform, {}, m, n);
+  FRANK::Dense C_check(C);
+  USVBt.evaluate(C, 0.5, 2);
+  const FRANK::Dense USVBt_check = FRANK::gemm(
+    FRANK::gemm(FRANK::gemm(U, S), V), B, 1, false, true
+  );
+  FRANK::gemm(FRANK::Dense(FRANK::identity, {}, m, m), USVBt_check, C_check, 0.5, 2);
+
+  // Check result and that the chosen order beats left-to-right evaluation
+  for (int64_t i = 0; i < m; ++i) {
+    for (int64_t j = 0; j < n; ++j) {
+      EXPECT_NEAR(C_check(i, j), C(i, j), 1e-12 * k);
+    }
+  }
+  EXPECT_LE(USVBt.cost(), m*rank*rank + m*rank*k + m*k*n);
+  EXPECT_LE(FRANK::l2_error(USVBt_check, FRANK::Dense(U * S * V * FRANK::transpose(B))), 1e-14);
+}
+
 INSTANTIATE_TEST_SUITE_P(
     Operator, MatMulOperatorTests,
     testing::Combine(testing::Values(16, 32, 64), testing::Values(16, 32, 64),
@@ -193,4 +221,4 @@ INSTANTIATE_TEST_SUITE_P(
                           std::to_string(std::get<2>(info.param)));
       return name;
     });
-*/
+
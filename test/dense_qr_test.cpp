@@ -1,3 +1,4 @@
+#include <algorithm>
 #include <cstdint>
 #include <string>
 #include <tuple>
@@ -11,6 +12,8 @@ class QRTests
     : public testing::TestWithParam<std::tuple<int64_t, int64_t, int64_t>> {};
 class TruncatedQRTests
     : public testing::TestWithParam<std::tuple<int64_t, int64_t, double>> {};
+class LargeQRTests
+    : public testing::TestWithParam<std::tuple<int64_t, int64_t>> {};
 
 TEST_P(QRTests, DenseQr) {
   int64_t m, n, k;
@@ -72,6 +75,31 @@ TEST_P(QRTests, DenseRq) {
   }
 }
 
+// Sizes beyond the small kernels, which go through LAPACK. Errors are relative
+// since the entries grow with the matrix size.
+TEST_P(LargeQRTests, DenseQrRq) {
+  int64_t m, n;
+  std::tie(m, n) = GetParam();
+  const int64_t k = std::min(m, n);
+
+  FRANK::initialize();
+  const std::vector<std::vector<double>> randx_A{FRANK::get_sorted_random_vector(m+n)};
+  FRANK::Dense A(FRANK::laplacend, randx_A, m, n, 0, m);
+  const FRANK::Dense A_copy(A);
+  FRANK::Dense Q(m, k), R(k, n);
+  FRANK::qr(A, Q, R);
+  EXPECT_LE(FRANK::l2_error(A_copy, FRANK::gemm(Q, R)), 1e-14);
+  FRANK::Dense QtQ = FRANK::gemm(Q, Q, 1, true, false);
+  EXPECT_LE(FRANK::l2_error(FRANK::Dense(FRANK::identity, {}, k, k), QtQ), 1e-14);
+
+  FRANK::Dense B(A_copy);
+  FRANK::Dense R2(m, k), Q2(k, n);
+  FRANK::rq(B, R2, Q2);
+  EXPECT_LE(FRANK::l2_error(A_copy, FRANK::gemm(R2, Q2)), 1e-14);
+  FRANK::Dense QQt = FRANK::gemm(Q2, Q2, 1, false, true);
+  EXPECT_LE(FRANK::l2_error(FRANK::Dense(FRANK::identity, {}, k, k), QQt), 1e-14);
+}
+
 TEST_P(TruncatedQRTests, ThresholdBasedTruncation) {
   int64_t m, n;
   double eps;
@@ -132,6 +160,10 @@ INSTANTIATE_TEST_SUITE_P(LAPACK, QRTests,
                                          std::make_tuple(16, 8, 16),
                                          std::make_tuple(16, 8, 8),
                                          std::make_tuple(8, 16, 8)));
+INSTANTIATE_TEST_SUITE_P(LAPACK, LargeQRTests,
+                         testing::Values(std::make_tuple(64, 64),
+                                         std::make_tuple(96, 48),
+                                         std::make_tuple(48, 96)));
 INSTANTIATE_TEST_SUITE_P(LAPACK, TruncatedQRTests,
                          testing::Values(std::make_tuple(32, 32, 1e-6),
                                          std::make_tuple(32, 24, 1e-6),
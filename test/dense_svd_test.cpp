@@ -28,9 +28,35 @@ TEST_P(SVDTests, DenseSvd) {
   }
 }
 
+TEST_P(SVDTests, DenseSvdRectangular) {
+  int64_t m, n;
+  std::tie(m, n) = GetParam();
+
+  FRANK::initialize();
+  const std::vector<std::vector<double>> randx_A{FRANK::get_sorted_random_vector(m+n)};
+  FRANK::Dense A(FRANK::laplacend, randx_A, m, n, 0, m);
+
+  const FRANK::Dense A_copy(A);
+  FRANK::Dense A_work(A);
+  const std::vector<double> S_check = FRANK::get_singular_values(A_work);
+  FRANK::Dense U, S, V;
+  std::tie(U, S, V) = FRANK::svd(A);
+  const FRANK::Dense A_rebuilt = FRANK::gemm(FRANK::gemm(U, S), V);
+
+  // Check result
+  for (int64_t i = 0; i < A.dim[0]; ++i) {
+    for (int64_t j = 0; j < A.dim[1]; ++j) {
+      EXPECT_NEAR(A_rebuilt(i, j), A_copy(i, j), 1e-11);
+    }
+  }
+  for (int64_t i = 0; i < S.dim[0]; ++i) {
+    EXPECT_NEAR(S(i, i), S_check[i], 1e-11);
+  }
+}
+
 INSTANTIATE_TEST_SUITE_P(
     LAPACK, SVDTests,
-    testing::Combine(testing::Values(8, 16), testing::Values(8, 16)),
+    testing::Combine(testing::Values(8, 16, 48), testing::Values(8, 16, 40)),
     [](const testing::TestParamInfo<SVDTests::ParamType>& info) {
       std::string name = ("m" + std::to_string(std::get<0>(info.param)) + "n" +
                           std::to_string(std::get<1>(info.param)));
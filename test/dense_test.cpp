@@ -3,8 +3,15 @@
 #include "gtest/gtest.h"
 
 #include <cstdint>
+#include <cstdio>
+#include <fstream>
+#include <iomanip>
+#include <string>
+#include <utility>
 #include <vector>
 
+#include <unistd.h>
+
 
 TEST(DenseTest, ConstructorHierarchical) {
   FRANK::initialize();
@@ -83,6 +90,31 @@ TEST(DenseTest, Resize) {
   }
 }
 
+TEST(DenseTest, ResizeRvalue) {
+  FRANK::initialize();
+  constexpr int64_t N = 256;
+  const FRANK::Dense D(FRANK::random_normal, {}, N, N);
+  FRANK::Dense D_copy(D);
+  const double* buffer = &D_copy;
+  const FRANK::Dense D_resized = FRANK::resize(std::move(D_copy), N-N/8, N/2);
+  // The buffer of the discarded matrix is reused
+  ASSERT_EQ(&D_resized, buffer);
+  for (int64_t i=0; i<D_resized.dim[0]; ++i) {
+    for (int64_t j=0; j<D_resized.dim[1]; ++j) {
+      ASSERT_EQ(D(i, j), D_resized(i, j));
+    }
+  }
+  // Truncating a shallow copy must not modify the shared buffer
+  FRANK::Dense D_shared = D.shallow_copy();
+  D_shared.truncate(N/4, N/4);
+  ASSERT_NE(&D_shared, &D);
+  for (int64_t i=0; i<N/4; ++i) {
+    for (int64_t j=0; j<N/4; ++j) {
+      ASSERT_EQ(D(i, j), D_shared(i, j));
+    }
+  }
+}
+
 TEST(DenseTest, Assign) {
   FRANK::initialize();
   constexpr int64_t N = 24;
@@ -95,6 +127,28 @@ TEST(DenseTest, Assign) {
   }
 }
 
+TEST(DenseTest, AssignReuse) {
+  FRANK::initialize();
+  constexpr int64_t N = 24;
+  const FRANK::Dense A(FRANK::random_normal, {}, N, N);
+  FRANK::Dense D(N, N);
+  const double* buffer = &D;
+  D = A;
+  ASSERT_EQ(&D, buffer);
+  // A shared buffer is not written through
+  FRANK::Dense B(N, N);
+  const FRANK::Dense B_view = B.shallow_copy();
+  B = A;
+  ASSERT_NE(&B, &B_view);
+  for (int64_t i=0; i<N; ++i) {
+    for (int64_t j=0; j<N; ++j) {
+      ASSERT_EQ(D(i, j), A(i, j));
+      ASSERT_EQ(B(i, j), A(i, j));
+      ASSERT_EQ(B_view(i, j), 0);
+    }
+  }
+}
+
 TEST(DenseTest, Copy) {
   FRANK::initialize();
   constexpr int64_t N = 42;
@@ -118,3 +172,111 @@ TEST(DenseTest, Copy) {
     }
   }
 }
+
+TEST(DenseTest, MemoryMapped) {
+  FRANK::initialize();
+  constexpr int64_t N = 256;
+  constexpr int64_t nblocks = 4;
+  const FRANK::Dense D(FRANK::random_normal, {}, N, N);
+  FRANK::Dense M(N, N, "", FRANK::MemoryAccess::Sequential);
+  EXPECT_TRUE(M.is_mapped());
+  EXPECT_FALSE(M.is_submatrix());
+  // Rows shorter than a page are not padded, longer ones are padded to a
+  // whole number of pages
+  const int64_t page_elements = sysconf(_SC_PAGESIZE) / sizeof(double);
+  const int64_t padded_stride = (
+    N < page_elements
+    ? N : (N + page_elements - 1) / page_elements * page_elements
+  );
+  EXPECT_EQ(M.stride, padded_stride);
+  // Longer rows start on page boundaries
+  const FRANK::Dense W(2, page_elements+1, "");
+  EXPECT_EQ(W.stride, 2*page_elements);
+  EXPECT_EQ(FRANK::norm(M), 0);
+  // Same size assignment writes into the file
+  M = D;
+  EXPECT_TRUE(M.is_mapped());
+  EXPECT_EQ(FRANK::l2_error(D, M), 0);
+  // Views share the mapping
+  const FRANK::Hierarchical MH = FRANK::split(M, nblocks, nblocks);
+  const FRANK::Hierarchical DH = FRANK::split(D, nblocks, nblocks);
+  EXPECT_EQ(FRANK::l2_error(DH, MH), 0);
+  FRANK::Dense block(std::move(FRANK::split(M, nblocks, nblocks)(1, 2)));
+  EXPECT_TRUE(block.is_mapped());
+  EXPECT_TRUE(block.is_submatrix());
+  block.advise(FRANK::MemoryAccess::WillNeed);
+  block = 0;
+  block.advise(FRANK::MemoryAccess::DontNeed);
+  EXPECT_EQ(M(N/nblocks, 2*N/nblocks), 0);
+  EXPECT_EQ(M(0, 0), D(0, 0));
+  // Operations take and return mapped matrices like any other
+  const FRANK::Dense MM = FRANK::gemm(M, M);
+  FRANK::Dense D_copy(D);
+  for (int64_t i=N/nblocks; i<2*N/nblocks; ++i) {
+    for (int64_t j=2*N/nblocks; j<3*N/nblocks; ++j) D_copy(i, j) = 0;
+  }
+  EXPECT_LE(FRANK::l2_error(FRANK::gemm(D_copy, D_copy), MM), 1e-14);
+  M.truncate(N/2, N/2);
+  EXPECT_FALSE(M.is_mapped());
+  EXPECT_EQ(M(N/2-1, N/2-1), D(N/2-1, N/2-1));
+}
+
+TEST(DenseTest, MemoryMappedHierarchical) {
+  FRANK::initialize();
+  constexpr int64_t N = 256;
+  int64_t nleaf = 32, nblocks = 2;
+  const std::vector<std::vector<double>> randx{FRANK::get_sorted_random_vector(N)};
+  FRANK::Dense D(N, N, "");
+  FRANK::laplacend(&D, N, N, D.stride, randx, 0, 0);
+  const FRANK::Dense D_check(FRANK::laplacend, randx, N, N);
+  EXPECT_EQ(FRANK::l2_error(D_check, D), 0);
+  FRANK::Hierarchical A(std::move(D), 16, nleaf, 1, nblocks, nblocks);
+  EXPECT_LE(FRANK::l2_error(D_check, A), 1e-8);
+}
+
+TEST(DenseTest, MatrixFile) {
+  FRANK::initialize();
+  constexpr int64_t N = 128;
+  int64_t nleaf = 16, nblocks = 2, rank = 8;
+  const std::vector<std::vector<double>> randx{FRANK::get_sorted_random_vector(N)};
+  const FRANK::Dense D(FRANK::laplacend, randx, N, N);
+  const std::string text_filename = testing::TempDir() + "FRANK_matrix.txt";
+  const std::string binary_filename = testing::TempDir() + "FRANK_matrix.bin";
+  for (const FRANK::MatrixLayout ordering : {
+    FRANK::MatrixLayout::RowMajor, FRANK::MatrixLayout::ColumnMajor
+  }) {
+    const bool row_major = ordering == FRANK::MatrixLayout::RowMajor;
+    std::ofstream text_file(text_filename);
+    text_file << N << " " << N << "\n" << std::setprecision(17);
+    for (int64_t i=0; i<N; ++i) {
+      for (int64_t j=0; j<N; ++j) {
+        text_file << (row_major ? D(i, j) : D(j, i)) << " ";
+      }
+      text_file << "\n";
+    }
+    text_file.close();
+    FRANK::convert_matrix_file(text_filename, binary_filename, ordering);
+    // Binary files store their layout, so the ordering passed is ignored
+    const FRANK::Dense B(
+      binary_filename, FRANK::MatrixLayout::RowMajor, N/2, N/4, N/4, N/2
+    );
+    const FRANK::Dense T(text_filename, ordering, N/2, N/4, N/4, N/2);
+    EXPECT_EQ(FRANK::l2_error(T, B), 0);
+    for (int64_t i=0; i<B.dim[0]; ++i) {
+      for (int64_t j=0; j<B.dim[1]; ++j) {
+        ASSERT_EQ(B(i, j), D(N/4+i, N/2+j));
+      }
+    }
+    const FRANK::Hierarchical H_file(
+      binary_filename, ordering, N, N, rank, nleaf, 1, nblocks, nblocks
+    );
+    const FRANK::Hierarchical H_kernel(
+      FRANK::laplacend, randx, N, N, rank, nleaf, 1, nblocks, nblocks
+    );
+    EXPECT_EQ(FRANK::l2_error(H_kernel, H_file), 0);
+  }
+  FRANK::write_matrix_file(D, binary_filename, FRANK::MatrixLayout::ColumnMajor);
+  EXPECT_EQ(FRANK::l2_error(D, FRANK::Dense(binary_filename, {}, N, N)), 0);
+  std::remove(text_filename.c_str());
+  std::remove(binary_filename.c_str());
+}
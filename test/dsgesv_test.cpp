@@ -0,0 +1,94 @@
+#include <cstdint>
+#include <string>
+#include <tuple>
+#include <vector>
+
+#include "FRANK/FRANK.h"
+#include "gtest/gtest.h"
+
+
+class DsgesvTest
+    : public testing::TestWithParam<std::tuple<int64_t, int64_t, double>> {
+ protected:
+  void SetUp() override {
+    FRANK::initialize();
+    std::tie(n, rank, admis) = GetParam();
+    randx.emplace_back(FRANK::get_sorted_random_vector(n));
+  }
+  int64_t n, rank;
+  const int64_t nleaf = 16, nblocks = 2;
+  double admis;
+  std::vector<std::vector<double>> randx;
+};
+
+TEST_P(DsgesvTest, HierarchicalRefinement) {
+  const FRANK::Hierarchical A(
+    FRANK::laplacend, randx, n, n, rank, nleaf, admis, nblocks, nblocks
+  );
+  const FRANK::Dense x(FRANK::random_uniform, {}, n, 2);
+  FRANK::Dense b(n, 2);
+  FRANK::gemm(A, x, b, 1, 0);
+
+  FRANK::Dense x_ir;
+  int64_t iter;
+  bool fallback, converged;
+  std::tie(x_ir, iter, fallback, converged) = FRANK::dsgesv(A, b);
+  // Single precision factors need a few corrections to reach the tolerance
+  EXPECT_FALSE(fallback);
+  EXPECT_TRUE(converged);
+  EXPECT_GT(iter, 0);
+  EXPECT_LE(iter, 10);
+  EXPECT_LE(FRANK::l2_error(x, x_ir), 1e-10);
+}
+
+TEST_P(DsgesvTest, FallbackOnStall) {
+  const FRANK::Hierarchical A(
+    FRANK::laplacend, randx, n, n, rank, nleaf, admis, nblocks, nblocks
+  );
+  const FRANK::Dense x(FRANK::random_uniform, {}, n, 1);
+  FRANK::Dense b(n);
+  FRANK::gemm(A, x, b, 1, 0);
+
+  FRANK::Dense x_ir;
+  int64_t iter;
+  bool fallback, converged;
+  // A tolerance of zero can not be reached, so refinement eventually stalls
+  std::tie(x_ir, iter, fallback, converged) = FRANK::dsgesv(A, b, 0, 5);
+  EXPECT_TRUE(fallback);
+  EXPECT_FALSE(converged);
+  EXPECT_LE(iter, 10);
+  EXPECT_LE(FRANK::l2_error(x, x_ir), 1e-10);
+}
+
+TEST(DsgesvIllConditionedTest, ReportsNoConvergence) {
+  FRANK::initialize();
+  // Upper bidiagonal with condition number of about 2^n, so that even the
+  // double precision residual stays far above the tolerance
+  constexpr int64_t n = 64;
+  FRANK::Dense A(n, n);
+  for (int64_t i=0; i<n; ++i) {
+    A(i, i) = 1;
+    if (i+1 < n) A(i, i+1) = 2;
+  }
+  const FRANK::Dense b(FRANK::random_uniform, {}, n, 1);
+
+  FRANK::Dense x_ir;
+  int64_t iter;
+  bool fallback, converged;
+  std::tie(x_ir, iter, fallback, converged) = FRANK::dsgesv(A, b);
+  EXPECT_TRUE(fallback);
+  EXPECT_FALSE(converged);
+}
+
+INSTANTIATE_TEST_SUITE_P(
+    LAPACK, DsgesvTest,
+    testing::Combine(testing::Values(128, 256), testing::Values(8, 16),
+                     testing::Values(0.0, 1.0)),
+    [](const testing::TestParamInfo<DsgesvTest::ParamType>& info) {
+      std::string name = (
+        "n" + std::to_string(std::get<0>(info.param))
+        + "rank" + std::to_string(std::get<1>(info.param))
+        + "admis" + std::to_string(int(std::get<2>(info.param)))
+      );
+      return name;
+    });
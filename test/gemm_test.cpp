@@ -726,6 +726,54 @@ TEST_P(GEMMTests, HierarchicalHierarchicalNewHierarchical) {
   EXPECT_LE(error, 10 * THRESHOLD);
 }
 
+TEST_P(GEMMTests, EmptyDenseDense) {
+  //E D D
+  const FRANK::Empty A(transA ? k : m, transA ? m : k);
+  const FRANK::Dense B(FRANK::laplacend, randx_B, transB ? n : k, transB ? k : n);
+  FRANK::Dense C(FRANK::laplacend, randx_C, m, n);
+  FRANK::Dense C_check(C);
+  C_check *= beta;
+
+  FRANK::gemm(A, B, C, alpha, beta, transA, transB);
+  // Check result
+  const double error = FRANK::l2_error(C_check, C);
+  EXPECT_LE(error, EPSILON);
+}
+
+TEST_P(GEMMTests, HierarchicalEmptyHierarchical) {
+  //H E H
+  const FRANK::Hierarchical A(FRANK::laplacend, randx_A, transA ? k : m, transA ? m : k,
+                              nleaf, THRESHOLD, admis, nblocks, nblocks, FRANK::AdmisType::PositionBased);
+  const FRANK::Empty B(transB ? n : k, transB ? k : n);
+  FRANK::Dense CD(FRANK::laplacend, randx_C, m, n);
+  FRANK::Hierarchical C(FRANK::laplacend, randx_C, m, n,
+                        nleaf, THRESHOLD, admis, nblocks, nblocks, FRANK::AdmisType::PositionBased);
+  FRANK::Dense C_check(CD);
+  C_check *= beta;
+
+  FRANK::gemm(A, B, C, alpha, beta, transA, transB);
+  // Check result
+  const double error = FRANK::l2_error(C_check, C);
+  EXPECT_LE(error, 10 * THRESHOLD);
+}
+
+TEST_P(GEMMTests, ZeroRankLowrankDenseLowrank) {
+  //LR(rank 0) D LR
+  const FRANK::LowRank A(
+    FRANK::Dense(transA ? k : m, 0), FRANK::Dense(0, 0), FRANK::Dense(0, transA ? m : k)
+  );
+  const FRANK::Dense B(FRANK::laplacend, randx_B, transB ? n : k, transB ? k : n);
+  FRANK::Dense CD(FRANK::laplacend, randx_C, m, n, 0, 2 * std::max(m, n));
+  FRANK::LowRank C(CD, THRESHOLD);
+  FRANK::Dense C_check(CD);
+  C_check *= beta;
+
+  FRANK::gemm(A, B, C, alpha, beta, transA, transB);
+  // Check result
+  const double error = FRANK::l2_error(C_check, C);
+  EXPECT_LE(error, 10 * THRESHOLD);
+}
+
 INSTANTIATE_TEST_SUITE_P(GEMM, GEMMTests,
                          testing::Combine(testing::Values(16, 32),
                                           testing::Values(16, 32),
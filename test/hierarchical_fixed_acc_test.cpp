@@ -4,6 +4,8 @@
 #include <tuple>
 
 #include "FRANK/FRANK.h"
+#include "FRANK/classes/initialization_helpers/cluster_tree.h"
+#include "FRANK/classes/initialization_helpers/matrix_initializer_kernel.h"
 #include "gtest/gtest.h"
 
 
@@ -26,6 +28,22 @@ class HierarchicalFixedAccuracyTest
 };
 
 
+int64_t count_low_rank_blocks(const FRANK::Hierarchical& A) {
+  int64_t count = 0;
+  for (int64_t i=0; i<A.dim[0]; ++i) {
+    for (int64_t j=0; j<A.dim[1]; ++j) {
+      if (FRANK::type(A(i, j)) == "LowRank") {
+        ++count;
+      } else if (FRANK::type(A(i, j)) == "Hierarchical") {
+        count += count_low_rank_blocks(
+          FRANK::Hierarchical(FRANK::MatrixProxy(A(i, j)))
+        );
+      }
+    }
+  }
+  return count;
+}
+
 TEST_P(HierarchicalFixedAccuracyTest, ConstructionByKernel) {
   const FRANK::Dense D(FRANK::laplacend, randx_A, n_rows, n_cols);
   const FRANK::Hierarchical A(FRANK::laplacend, randx_A, n_rows, n_cols,
@@ -36,6 +54,73 @@ TEST_P(HierarchicalFixedAccuracyTest, ConstructionByKernel) {
   EXPECT_LE(error, eps);
 }
 
+TEST_P(HierarchicalFixedAccuracyTest, ConstructionBySharedGeometry) {
+  const FRANK::Dense D(FRANK::laplacend, randx_A, n_rows, n_cols);
+  const FRANK::Geometry geometry(std::move(randx_A));
+  const FRANK::Geometry geometry_copy(geometry);
+  // Copies share the points instead of copying them
+  EXPECT_EQ(&geometry.coords(), &geometry_copy.coords());
+  const FRANK::MatrixInitializerKernel initializer(
+    FRANK::laplacend, geometry, admis, eps, 0, admis_type
+  );
+  EXPECT_EQ(&initializer.get_geometry().coords(), &geometry.coords());
+  const FRANK::Hierarchical A(FRANK::laplacend, geometry, n_rows, n_cols,
+                              nleaf, eps, admis, nb_row, nb_col, admis_type);
+
+  // Check compression error
+  const double error = FRANK::l2_error(D, A);
+  EXPECT_LE(error, eps);
+}
+
+TEST_P(HierarchicalFixedAccuracyTest, UpdatePoints) {
+  const FRANK::ClusterTree node(
+    {0, n_rows}, {0, n_cols}, nb_row, nb_col, nleaf
+  );
+  FRANK::MatrixInitializerKernel initializer(
+    FRANK::laplacend, randx_A, admis, eps, 0, admis_type
+  );
+  initializer.find_admissible_blocks(node);
+  FRANK::Hierarchical A(node, initializer, false);
+
+  // Move a few points by a small distance, keeping them sorted
+  const std::vector<int64_t> changed{n_rows/2, 3, 4};
+  for (const int64_t i : changed) randx_A[0][i] += 1e-4;
+  const FRANK::MatrixInitializerKernel moved(
+    FRANK::laplacend, randx_A, admis, eps, 0, admis_type
+  );
+  const FRANK::UpdateStatistics statistics = FRANK::update_points(
+    A, node, moved, changed, false
+  );
+  const FRANK::Dense D(FRANK::laplacend, randx_A, n_rows, n_cols);
+  EXPECT_LE(FRANK::l2_error(D, A), eps);
+  EXPECT_EQ(statistics.n_elements, n_rows*n_cols);
+  EXPECT_LT(statistics.n_rebuilt_elements, statistics.n_elements);
+  EXPECT_GT(statistics.n_dense, 0);
+}
+
+TEST_P(HierarchicalFixedAccuracyTest, WarmStartConstruction) {
+  const FRANK::ClusterTree node(
+    {0, n_rows}, {0, n_cols}, nb_row, nb_col, nleaf
+  );
+  FRANK::MatrixInitializerKernel initializer(
+    FRANK::laplacend, randx_A, admis, eps, 0, admis_type
+  );
+  initializer.find_admissible_blocks(node);
+  const FRANK::Hierarchical previous(node, initializer, false);
+
+  // Slightly stretched geometry, with the same admissible blocks
+  for (double& x : randx_A[0]) x *= 1.001;
+  FRANK::MatrixInitializerKernel stretched(
+    FRANK::laplacend, randx_A, admis, eps, 0, admis_type
+  );
+  stretched.find_admissible_blocks(node);
+  const FRANK::Hierarchical A(node, stretched, previous, false);
+  const FRANK::Dense D(FRANK::laplacend, randx_A, n_rows, n_cols);
+  EXPECT_LE(FRANK::l2_error(D, A), eps);
+  // The small change keeps the previous bases accurate enough for all blocks
+  EXPECT_EQ(stretched.get_n_warm_starts(), count_low_rank_blocks(previous));
+}
+
 TEST_P(HierarchicalFixedAccuracyTest, ConstructionByDenseMatrix) {
   const FRANK::Dense D(FRANK::laplacend, randx_A, n_rows, n_cols);
   FRANK::Dense D_copy(D);
@@ -47,6 +132,25 @@ TEST_P(HierarchicalFixedAccuracyTest, ConstructionByDenseMatrix) {
   EXPECT_LE(error, eps);
 }
 
+TEST_P(HierarchicalFixedAccuracyTest, ConstructionLikeStructure) {
+  const FRANK::Hierarchical A(FRANK::laplacend, randx_A, n_rows, n_cols,
+                              nleaf, eps, admis, nb_row, nb_col, admis_type);
+  const FRANK::Hierarchical Z(A, FRANK::FillType::Zero);
+  const FRANK::Hierarchical I(A, FRANK::FillType::Identity);
+  const FRANK::Hierarchical Z_check(FRANK::zeros, randx_A, n_rows, n_cols,
+                                    nleaf, eps, admis, nb_row, nb_col, admis_type);
+
+  // Check content
+  EXPECT_DOUBLE_EQ(FRANK::norm(FRANK::Dense(Z)), 0);
+  EXPECT_DOUBLE_EQ(
+    FRANK::l2_error(FRANK::Dense(FRANK::identity, {}, n_rows, n_cols), I), 0
+  );
+  // Block structure must match the one built from the kernel
+  FRANK::Hierarchical Z_sum(Z);
+  Z_sum += Z_check;
+  EXPECT_DOUBLE_EQ(FRANK::norm(FRANK::Dense(Z_sum)), 0);
+}
+
 TEST_P(HierarchicalFixedAccuracyTest, LUFactorization) {
   FRANK::Hierarchical A(FRANK::laplacend, randx_A, n_rows, n_cols,
                         nleaf, eps, admis, nb_row, nb_col, admis_type);
@@ -90,6 +194,39 @@ TEST_P(HierarchicalFixedAccuracyTest, GramSchmidtQRFactorization) {
 }
 
 
+TEST_P(HierarchicalFixedAccuracyTest, BlockedHouseholderQRFactorization) {
+  FRANK::Hierarchical A(FRANK::laplacend, randx_A, n_rows, n_cols,
+                        nleaf, eps, admis, nb_row, nb_col, admis_type);
+  const FRANK::Hierarchical D(FRANK::laplacend, randx_A, n_rows, n_cols,
+                              nleaf, nleaf, nb_row, nb_row, nb_col, FRANK::AdmisType::PositionBased);
+  FRANK::Hierarchical T(A.dim[1], 1);
+  FRANK::blocked_householder_blr_qr(A, T);
+
+  // Q has the same nested structure, so the update of its diagonal blocks
+  // multiplies Identity with Hierarchical blocks
+  FRANK::Hierarchical Q(FRANK::identity, randx_A, n_rows, n_cols,
+                        nleaf, eps, admis, nb_row, nb_col, admis_type);
+  FRANK::left_multiply_blocked_reflector(A, T, Q, false);
+
+  // Residual
+  FRANK::Hierarchical QR(Q);
+  //R is taken from upper triangular part of A
+  FRANK::Hierarchical R(nb_col, nb_col);
+  for(int64_t i = 0; i < nb_col; i++) {
+    for(int64_t j = i; j < nb_col; j++) {
+      R(i, j) = A(i, j);
+    }
+  }
+  FRANK::trmm(R, QR, FRANK::Side::Right, FRANK::Mode::Upper, 'n', 'n', 1.);
+  const double residual = FRANK::l2_error(D, QR);
+  EXPECT_LE(residual, eps);
+
+  // Orthogonality
+  FRANK::left_multiply_blocked_reflector(A, T, Q, true);
+  const double orthogonality = FRANK::l2_error(FRANK::Dense(FRANK::identity, {}, n_cols, n_cols), Q);
+  EXPECT_LE(orthogonality, eps);
+}
+
 INSTANTIATE_TEST_SUITE_P(HierarchicalTest, HierarchicalFixedAccuracyTest,
                          testing::Combine(testing::Values(128, 256),
                                           testing::Values(32),
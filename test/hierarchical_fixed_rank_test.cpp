@@ -4,6 +4,8 @@
 #include <tuple>
 
 #include "FRANK/FRANK.h"
+#include "FRANK/classes/initialization_helpers/cluster_tree.h"
+#include "FRANK/classes/initialization_helpers/matrix_initializer_kernel.h"
 #include "gtest/gtest.h"
 
 
@@ -54,6 +56,30 @@ TEST_P(HierarchicalFixedRankTest, ConstructionByDenseMatrix) {
 }
 
 
+TEST_P(HierarchicalFixedRankTest, WarmStartConstruction) {
+  const FRANK::ClusterTree node(
+    {0, n_rows}, {0, n_cols}, nb_row, nb_col, nleaf
+  );
+  FRANK::MatrixInitializerKernel initializer(
+    FRANK::laplacend, randx_A, admis, 0, rank, admis_type
+  );
+  initializer.find_admissible_blocks(node);
+  const FRANK::Hierarchical previous(node, initializer, true);
+  const FRANK::Dense D_previous(FRANK::laplacend, randx_A, n_rows, n_cols);
+  const double previous_error = FRANK::l2_error(D_previous, previous);
+
+  for (double& x : randx_A[0]) x *= 1.001;
+  FRANK::MatrixInitializerKernel stretched(
+    FRANK::laplacend, randx_A, admis, 0, rank, admis_type
+  );
+  stretched.find_admissible_blocks(node);
+  FRANK::Hierarchical A(node, stretched, previous, true);
+  const FRANK::Dense D(FRANK::laplacend, randx_A, n_rows, n_cols);
+  // Same accuracy as building from scratch, up to a small factor
+  EXPECT_LE(FRANK::l2_error(D, A), 10 * previous_error + 1e-12);
+  expect_uniform_rank(A, rank);
+}
+
 INSTANTIATE_TEST_SUITE_P(HierarchicalTest, HierarchicalFixedRankTest,
                          testing::Combine(testing::Values(128, 256),
                                           testing::Values(32),
@@ -0,0 +1,157 @@
+#include <algorithm>
+#include <cstdint>
+#include <vector>
+#include <string>
+#include <tuple>
+
+#include "FRANK/FRANK.h"
+#include "gtest/gtest.h"
+
+class IdentityDiagonalTests
+    : public testing::TestWithParam<std::tuple<int64_t, int64_t, double, double, bool>> {
+ protected:
+  void SetUp() override {
+    FRANK::initialize();
+    FRANK::setGlobalValue("FRANK_LRA", "rounded_addition");
+    std::tie(m, n, alpha, beta, trans) = GetParam();
+    randx = { FRANK::get_sorted_random_vector(4 * std::max(m, n)) };
+  }
+  int64_t m, n;
+  double alpha, beta;
+  bool trans;
+  std::vector<std::vector<double>> randx;
+};
+
+constexpr double THRESHOLD = 1e-6;
+constexpr double EPSILON = 1e-14;
+
+TEST_P(IdentityDiagonalTests, IdentityDenseDense) {
+  //I D D
+  const FRANK::Dense B(FRANK::laplacend, randx, trans ? n : m, trans ? m : n, 0, 2 * m);
+  FRANK::Dense C(FRANK::laplacend, randx, m, n);
+  FRANK::Dense C_check(C);
+  FRANK::gemm(FRANK::Identity(m), B, C, alpha, beta, false, trans);
+  FRANK::gemm(FRANK::Dense(FRANK::identity, {}, m, m), B, C_check, alpha, beta, false, trans);
+
+  const double error = FRANK::l2_error(C_check, C);
+  EXPECT_LE(error, EPSILON);
+}
+
+TEST_P(IdentityDiagonalTests, DenseIdentityDense) {
+  //D I D
+  const FRANK::Dense A(FRANK::laplacend, randx, trans ? n : m, trans ? m : n, 0, 2 * m);
+  FRANK::Dense C(FRANK::laplacend, randx, m, n);
+  FRANK::Dense C_check(C);
+  FRANK::gemm(A, FRANK::Identity(n), C, alpha, beta, trans, false);
+  FRANK::gemm(A, FRANK::Dense(FRANK::identity, {}, n, n), C_check, alpha, beta, trans, false);
+
+  const double error = FRANK::l2_error(C_check, C);
+  EXPECT_LE(error, EPSILON);
+}
+
+TEST_P(IdentityDiagonalTests, IdentityLowrankLowrank) {
+  //I LR LR
+  const FRANK::Dense BD(FRANK::laplacend, randx, trans ? n : m, trans ? m : n, 0, 2 * m);
+  const FRANK::LowRank B(BD, THRESHOLD);
+  const FRANK::Dense CD(FRANK::laplacend, randx, m, n, 0, 2 * m);
+  FRANK::LowRank C(CD, THRESHOLD);
+  FRANK::Dense C_check(CD);
+  FRANK::gemm(FRANK::Identity(m), B, C, alpha, beta, false, trans);
+  FRANK::gemm(FRANK::Dense(FRANK::identity, {}, m, m), BD, C_check, alpha, beta, false, trans);
+
+  const double error = FRANK::l2_error(C_check, C);
+  EXPECT_LE(error, 10 * THRESHOLD);
+}
+
+TEST_P(IdentityDiagonalTests, IdentityDenseLowrank) {
+  //I D LR
+  const FRANK::Dense B(FRANK::laplacend, randx, trans ? n : m, trans ? m : n, 0, 2 * m);
+  const FRANK::Dense CD(FRANK::laplacend, randx, m, n, 0, 2 * m);
+  FRANK::LowRank C(CD, THRESHOLD);
+  FRANK::Dense C_check(CD);
+  FRANK::gemm(FRANK::Identity(m), B, C, alpha, beta, false, trans);
+  FRANK::gemm(FRANK::Dense(FRANK::identity, {}, m, m), B, C_check, alpha, beta, false, trans);
+
+  const double error = FRANK::l2_error(C_check, C);
+  EXPECT_LE(error, 10 * THRESHOLD);
+}
+
+TEST_P(IdentityDiagonalTests, IdentityHierarchical) {
+  //I H H, H I H, I D H, I H D, I LR H, I H LR
+  // Nothing is admissible, so all leaves are Dense and the products are exact
+  const int64_t nleaf = 4, admis = 4 * std::max(m, n);
+  const FRANK::Hierarchical B(
+    FRANK::laplacend, randx, trans ? n : m, trans ? m : n, 0, nleaf, admis,
+    2, 2, FRANK::AdmisType::PositionBased, 0, 2 * m
+  );
+  const FRANK::Dense BD(B);
+  const FRANK::Hierarchical C0(FRANK::laplacend, randx, m, n, 0, nleaf, admis);
+  const FRANK::Dense CD0(C0);
+
+  FRANK::Dense C_check(CD0);
+  FRANK::gemm(FRANK::Dense(FRANK::identity, {}, m, m), BD, C_check, alpha, beta, false, trans);
+  FRANK::Hierarchical C(C0);
+  FRANK::gemm(FRANK::Identity(m), B, C, alpha, beta, false, trans);
+  EXPECT_LE(FRANK::l2_error(C_check, C), EPSILON);
+  C = C0;
+  FRANK::gemm(B, FRANK::Identity(n), C, alpha, beta, trans, false);
+  EXPECT_LE(FRANK::l2_error(C_check, C), EPSILON);
+  C = C0;
+  FRANK::gemm(FRANK::Identity(m), BD, C, alpha, beta, false, trans);
+  EXPECT_LE(FRANK::l2_error(C_check, C), EPSILON);
+  FRANK::Dense CD(CD0);
+  FRANK::gemm(FRANK::Identity(m), B, CD, alpha, beta, false, trans);
+  EXPECT_LE(FRANK::l2_error(C_check, CD), EPSILON);
+
+  const FRANK::LowRank BL(BD, THRESHOLD);
+  FRANK::Dense CL_check(CD0);
+  FRANK::gemm(FRANK::Dense(FRANK::identity, {}, m, m), FRANK::Dense(BL), CL_check, alpha, beta, false, trans);
+  C = C0;
+  FRANK::gemm(FRANK::Identity(m), BL, C, alpha, beta, false, trans);
+  EXPECT_LE(FRANK::l2_error(CL_check, C), EPSILON);
+
+  FRANK::LowRank CL(CD0, THRESHOLD);
+  FRANK::gemm(FRANK::Identity(m), B, CL, alpha, beta, false, trans);
+  EXPECT_LE(FRANK::l2_error(C_check, CL), 10 * THRESHOLD);
+}
+
+TEST_P(IdentityDiagonalTests, DiagonalDenseDense) {
+  //Diag D D, D Diag D
+  const FRANK::Diagonal Dm(FRANK::Dense(FRANK::random_uniform, {}, m, 1));
+  const FRANK::Diagonal Dn(FRANK::Dense(FRANK::random_uniform, {}, 1, n));
+  const FRANK::Dense B(FRANK::laplacend, randx, trans ? n : m, trans ? m : n, 0, 2 * m);
+  FRANK::Dense C(FRANK::laplacend, randx, m, n);
+  FRANK::Dense C_check(C);
+  FRANK::gemm(Dm, B, C, alpha, beta, false, trans);
+  FRANK::gemm(FRANK::Dense(Dm), B, C_check, alpha, beta, false, trans);
+  EXPECT_LE(FRANK::l2_error(C_check, C), EPSILON);
+
+  FRANK::gemm(B, Dn, C, alpha, beta, trans, false);
+  FRANK::gemm(B, FRANK::Dense(Dn), C_check, alpha, beta, trans, false);
+  EXPECT_LE(FRANK::l2_error(C_check, C), EPSILON);
+}
+
+TEST_P(IdentityDiagonalTests, AdditionAndTrmm) {
+  FRANK::Dense A(FRANK::laplacend, randx, m, m);
+  FRANK::Dense A_check(A);
+  A += FRANK::Identity(m);
+  A_check += FRANK::Dense(FRANK::identity, {}, m, m);
+  EXPECT_LE(FRANK::l2_error(A_check, A), EPSILON);
+
+  const FRANK::Diagonal D(FRANK::Dense(FRANK::random_uniform, {}, m, 1));
+  FRANK::Dense B(FRANK::laplacend, randx, m, n);
+  FRANK::Dense B_check(B);
+  FRANK::trmm(D, B, FRANK::Side::Left, FRANK::Mode::Upper, 'n', 'n', alpha);
+  FRANK::trmm(FRANK::Dense(D), B_check, FRANK::Side::Left, FRANK::Mode::Upper, 'n', 'n', alpha);
+  EXPECT_LE(FRANK::l2_error(B_check, B), EPSILON);
+
+  FRANK::trmm(FRANK::Identity(m), B, FRANK::Side::Left, FRANK::Mode::Lower, 't', 'u', alpha);
+  B_check *= alpha;
+  EXPECT_LE(FRANK::l2_error(B_check, B), EPSILON);
+}
+
+INSTANTIATE_TEST_SUITE_P(
+    Identity, IdentityDiagonalTests,
+    testing::Combine(testing::Values(16, 32), testing::Values(16, 24),
+                     testing::Values(1.0, -1.0), testing::Values(0.0, 1.0, 0.5),
+                     testing::Values(true, false)));
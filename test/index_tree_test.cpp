@@ -0,0 +1,153 @@
+#include "FRANK/FRANK.h"
+#include "FRANK/classes/initialization_helpers/cluster_tree.h"
+#include "FRANK/classes/initialization_helpers/index_tree.h"
+#include "FRANK/classes/initialization_helpers/matrix_initializer_kernel.h"
+
+#include "gtest/gtest.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <random>
+#include <tuple>
+#include <vector>
+
+
+class IndexTreeTest : public testing::Test {
+ protected:
+  static constexpr int64_t N = 1000;
+  int64_t nleaf = 32;
+  std::vector<std::vector<double>> x, x_original;
+  void SetUp() override {
+    FRANK::initialize();
+    // A dense cluster next to a sparse one
+    std::mt19937 generator(0);
+    std::uniform_real_distribution<double> distribution(0, 1);
+    x.resize(2);
+    for (int64_t i=0; i<N; ++i) {
+      const double scale = i % 4 == 0 ? 16 : 1;
+      for (std::vector<double>& axis : x) {
+        axis.push_back(scale * distribution(generator));
+      }
+    }
+    x_original = x;
+  }
+  void check_permutation(const std::vector<int64_t>& perm) {
+    std::vector<int64_t> sorted(perm);
+    std::sort(sorted.begin(), sorted.end());
+    for (int64_t i=0; i<N; ++i) {
+      ASSERT_EQ(sorted[i], i);
+      for (size_t d=0; d<x.size(); ++d) {
+        EXPECT_EQ(x[d][i], x_original[d][perm[i]]);
+      }
+    }
+  }
+  void check_tree(const FRANK::IndexTree& node) {
+    if (node.is_leaf()) {
+      EXPECT_LE(node.range.n, nleaf);
+      EXPECT_GT(node.range.n, 0);
+      return;
+    }
+    int64_t start = node.range.start;
+    for (const FRANK::IndexTree& child : node.children) {
+      EXPECT_EQ(child.range.start, start);
+      start += child.range.n;
+      check_tree(child);
+    }
+    EXPECT_EQ(start, node.range.start + node.range.n);
+  }
+};
+
+TEST_F(IndexTreeTest, PrincipalAxisBisection) {
+  std::vector<int64_t> perm;
+  const FRANK::IndexTree tree = FRANK::geometric_bisection(x, perm, nleaf);
+  check_permutation(perm);
+  check_tree(tree);
+  EXPECT_EQ(tree.depth(), 5);
+  EXPECT_EQ(tree.max_leaf_size(), 32);
+}
+
+TEST_F(IndexTreeTest, LongestAxisBisection) {
+  std::vector<int64_t> perm;
+  const FRANK::IndexTree tree = FRANK::geometric_bisection(
+    x, perm, nleaf, FRANK::BisectionType::LongestAxis
+  );
+  check_permutation(perm);
+  check_tree(tree);
+  EXPECT_EQ(tree.depth(), 5);
+  // Clusters are split like IndexRange::split()
+  const FRANK::IndexTree& node = tree.children[0].children[0].children[0];
+  EXPECT_EQ(node.children[0].range.n, 63);
+  EXPECT_EQ(node.children[1].range.n, 62);
+}
+
+TEST_F(IndexTreeTest, HierarchicalConstruction) {
+  for (const int64_t nleaf_test : {nleaf, int64_t(62)}) {
+    // With nleaf = 62, the last level has clusters of 32 and 31 points
+    x = x_original;
+    std::vector<int64_t> perm;
+    const FRANK::IndexTree tree = FRANK::geometric_bisection(x, perm, nleaf_test);
+    const FRANK::ClusterTree cluster_tree(tree, tree);
+    const double eps = 1e-8, admis = 1;
+    FRANK::MatrixInitializerKernel initializer(
+      FRANK::laplacend, x, admis, eps, 0, FRANK::AdmisType::GeometryBased
+    );
+    initializer.find_admissible_blocks(cluster_tree);
+    const FRANK::Hierarchical A(cluster_tree, initializer, false);
+    const FRANK::Dense D(FRANK::laplacend, x, N, N);
+    EXPECT_LE(FRANK::l2_error(D, A), eps);
+
+    // Row i of the permuted matrix belongs to point perm[i]
+    const FRANK::Dense D_original(FRANK::laplacend, x_original, N, N);
+    for (int64_t i=0; i<N; i+=97) {
+      for (int64_t j=0; j<N; j+=89) {
+        EXPECT_EQ(D(i, j), D_original(perm[i], perm[j]));
+      }
+    }
+
+    // The matrix can be used like one built from uniform splits
+    const FRANK::Dense x_solution(FRANK::random_uniform, {}, N);
+    FRANK::Dense b(N);
+    FRANK::gemm(A, x_solution, b, 1, 0);
+    FRANK::Hierarchical A_copy(A), L, U;
+    std::tie(L, U) = FRANK::getrf(A_copy);
+    FRANK::trsm(L, b, FRANK::Mode::Lower);
+    FRANK::trsm(U, b, FRANK::Mode::Upper);
+    EXPECT_LE(FRANK::l2_error(x_solution, b), 1e-6);
+  }
+}
+
+void expect_same_admissibility(
+  const FRANK::ClusterTree& node,
+  const FRANK::MatrixInitializer& expected, const FRANK::MatrixInitializer& cached,
+  int64_t& n_admissible
+) {
+  EXPECT_EQ(expected.is_admissible(node), cached.is_admissible(node));
+  n_admissible += expected.is_admissible(node);
+  for (const FRANK::ClusterTree& child : node) {
+    expect_same_admissibility(child, expected, cached, n_admissible);
+  }
+}
+
+TEST_F(IndexTreeTest, PrecomputedAdmissibility) {
+  std::vector<int64_t> perm;
+  const FRANK::IndexTree tree = FRANK::geometric_bisection(x, perm, nleaf);
+  const FRANK::ClusterTree cluster_tree(tree, tree);
+  const double admis = 1;
+  const FRANK::MatrixInitializerKernel expected(
+    FRANK::laplacend, x, admis, 0, 0, FRANK::AdmisType::GeometryBased
+  );
+  FRANK::MatrixInitializerKernel cached(
+    FRANK::laplacend, x, admis, 0, 0, FRANK::AdmisType::GeometryBased
+  );
+  cached.find_admissible_blocks(cluster_tree);
+  int64_t n_admissible = 0;
+  expect_same_admissibility(cluster_tree, expected, cached, n_admissible);
+  EXPECT_GT(n_admissible, 0);
+  // Reusing the initializer for another tree replaces the cached results
+  const FRANK::IndexTree other_tree = FRANK::geometric_bisection(x, perm, 2*nleaf);
+  const FRANK::ClusterTree other_cluster_tree(other_tree, other_tree);
+  cached.find_admissible_blocks(other_cluster_tree);
+  n_admissible = 0;
+  expect_same_admissibility(other_cluster_tree, expected, cached, n_admissible);
+  EXPECT_GT(n_admissible, 0);
+}
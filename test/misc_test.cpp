@@ -1,4 +1,6 @@
+#include <algorithm>
 #include <cstdint>
+#include <random>
 #include <vector>
 #include <string>
 #include <tuple>
@@ -253,3 +255,59 @@ INSTANTIATE_TEST_SUITE_P(MakeZeroTests, MakeZeroTests,
                          testing::Combine(testing::Values(64),
                                           testing::Values(32, 64, 128)
                                           ));
+
+class MortonIndexTests : public testing::TestWithParam<std::tuple<int64_t, int64_t>> {};
+
+TEST_P(MortonIndexTests, SortByMortonIndex) {
+  int64_t dim, n;
+  std::tie(dim, n) = GetParam();
+  constexpr int64_t level = 6;
+  std::vector<std::vector<double>> x;
+  for (int64_t d=0; d<dim; ++d) {
+    x.push_back(FRANK::get_sorted_random_vector(n));
+    std::shuffle(x[d].begin(), x[d].end(), std::mt19937(d));
+  }
+  const std::vector<std::vector<double>> x_original(x);
+  std::vector<int64_t> perm(n);
+  FRANK::sortByMortonIndex(x, level, perm);
+
+  // Boxes of a 2^level grid over the normalized points, interleaved bit by bit
+  std::vector<double> bmin(dim);
+  double bsize = 0;
+  for (int64_t d=0; d<dim; ++d) {
+    const auto minmax = std::minmax_element(x_original[d].begin(), x_original[d].end());
+    bmin[d] = *minmax.first - 0.5;
+    bsize = std::max(bsize, *minmax.second - *minmax.first);
+  }
+  bsize += 1;
+  const auto box = [&](const int64_t i) {
+    int64_t index = 0;
+    for (int64_t d=0; d<dim; ++d) {
+      const int64_t position = (x_original[d][i] - bmin[d]) / bsize * (1 << level);
+      for (int64_t b=0; b<level; ++b) {
+        index |= ((position >> b) & 1) << (dim*b + d);
+      }
+    }
+    return index;
+  };
+  std::vector<bool> found(n, false);
+  for (int64_t i=0; i<n; ++i) {
+    ASSERT_FALSE(found[perm[i]]);
+    found[perm[i]] = true;
+    for (int64_t d=0; d<dim; ++d) {
+      EXPECT_EQ(x[d][i], x_original[d][perm[i]]);
+    }
+    if (i > 0) {
+      EXPECT_LE(box(perm[i-1]), box(perm[i]));
+      // Points in the same box keep their order
+      if (box(perm[i-1]) == box(perm[i])) {
+        EXPECT_LT(perm[i-1], perm[i]);
+      }
+    }
+  }
+}
+
+INSTANTIATE_TEST_SUITE_P(MortonIndexTests, MortonIndexTests,
+                         testing::Combine(testing::Values(1, 2, 3, 4),
+                                          testing::Values(1000, 1 << 17)
+                                          ));
@@ -0,0 +1,152 @@
+#include <cmath>
+#include <cstdint>
+#include <tuple>
+#include <vector>
+
+#include "FRANK/FRANK.h"
+#include "gtest/gtest.h"
+
+
+FRANK::Dense random_orthonormal(const int64_t m, const int64_t k) {
+  FRANK::Dense A(FRANK::random_normal, {}, m, k);
+  FRANK::Dense Q(m, k), R(k, k);
+  FRANK::qr(A, Q, R);
+  return Q;
+}
+
+TEST(MixedPrecisionLowRankTest, PrecisionPerTriplet) {
+  FRANK::initialize();
+  constexpr int64_t m = 64, n = 48, k = 16;
+  // Singular values 2^(-4i) span double, single and bfloat16 precision
+  FRANK::Dense S(k, k);
+  for (int64_t i=0; i<k; ++i) S(i, i) = std::pow(2, -4*i);
+  const FRANK::Dense U = random_orthonormal(m, k);
+  const FRANK::Dense VT = random_orthonormal(n, k);
+  const FRANK::Dense V(FRANK::transpose(VT));
+  const FRANK::LowRank A(U, S, V);
+
+  const double tol = 1e-10;
+  const FRANK::MixedPrecisionLowRank B(A, tol);
+  EXPECT_EQ(B.total_rank(), k);
+  EXPECT_GT(B.rank[0], 0);
+  EXPECT_GT(B.rank[1], 0);
+  EXPECT_GT(B.rank[2], 0);
+  EXPECT_LE(std::sqrt(FRANK::norm(FRANK::Dense(A) - FRANK::Dense(B))), tol);
+  EXPECT_LT(FRANK::get_memory_usage(B, false), FRANK::get_memory_usage(A, false));
+
+  // Products use the singular vectors in their stored precision
+  const FRANK::Dense x(FRANK::random_normal, {}, n, 2);
+  FRANK::Dense Ax(m, 2), Bx(m, 2);
+  FRANK::gemm(A, x, Ax, 1, 0);
+  FRANK::gemm(B, x, Bx, 1, 0);
+  EXPECT_LE(FRANK::l2_error(Ax, Bx), 1e-9);
+}
+
+TEST(MixedPrecisionLowRankTest, AdaptPrecisionHierarchical) {
+  FRANK::initialize();
+  constexpr int64_t n = 512, nleaf = 32, rank = 16, nblocks = 2;
+  const std::vector<std::vector<double>> randx{FRANK::get_sorted_random_vector(n)};
+  const FRANK::Hierarchical A(
+    FRANK::laplacend, randx, n, n, rank, nleaf, 0, nblocks, nblocks
+  );
+  for (const double eps : {1e-4, 1e-8}) {
+    const FRANK::MatrixProxy B = FRANK::adapt_precision(A, eps);
+    EXPECT_LE(FRANK::l2_error(A, B), eps);
+    EXPECT_LT(FRANK::get_memory_usage(B), FRANK::get_memory_usage(A));
+
+    const FRANK::Dense x(FRANK::random_uniform, {}, n);
+    FRANK::Dense Ax(n), Bx(n);
+    FRANK::gemm(A, x, Ax, 1, 0);
+    FRANK::gemm(B, x, Bx, 1, 0);
+    EXPECT_LE(FRANK::l2_error(Ax, Bx), eps);
+  }
+}
+
+TEST(MixedPrecisionLowRankTest, ProductsFromStoredFactors) {
+  FRANK::initialize();
+  constexpr int64_t m = 64, n = 48, k = 16, l = 24, r = 8;
+  FRANK::Dense S(k, k);
+  for (int64_t i=0; i<k; ++i) S(i, i) = std::pow(2, -4*i);
+  const FRANK::Dense VT = random_orthonormal(n, k);
+  const FRANK::LowRank A(random_orthonormal(m, k), S, FRANK::transpose(VT));
+  const FRANK::MixedPrecisionLowRank B(A, 1e-10);
+  ASSERT_GT(B.rank[2], 0);
+
+  for (const bool trans : {false, true}) {
+    // op(B) is p x q
+    const int64_t p = trans ? n : m, q = trans ? m : n;
+    const FRANK::Dense X(FRANK::random_normal, {}, q, l);
+    const FRANK::Dense Y(FRANK::random_normal, {}, l, p);
+    const FRANK::LowRank XLR(FRANK::Dense(FRANK::random_normal, {}, q, l), r);
+    const FRANK::LowRank YLR(FRANK::Dense(FRANK::random_normal, {}, l, p), r);
+    const FRANK::Dense C0(FRANK::random_normal, {}, p, l);
+    const FRANK::Dense D0(FRANK::random_normal, {}, l, q);
+    // Apply the same product with the LowRank and the MixedPrecisionLowRank
+    // operand on the left (or right) of other, both starting from C
+    const auto check = [&](
+      const FRANK::Matrix& other, const FRANK::Matrix& C, const bool left
+    ) {
+      FRANK::MatrixProxy C_ref(C), C_mp(C);
+      if (left) {
+        FRANK::gemm(A, other, C_ref, -1, 0.5, trans, false);
+        FRANK::gemm(B, other, C_mp, -1, 0.5, trans, false);
+      } else {
+        FRANK::gemm(other, A, C_ref, -1, 0.5, false, trans);
+        FRANK::gemm(other, B, C_mp, -1, 0.5, false, trans);
+      }
+      EXPECT_LE(FRANK::l2_error(C_ref, C_mp), 1e-9);
+    };
+    // Accuracy based outputs, so that sums are truncated the same way whatever
+    // order they are formed in
+    const FRANK::LowRank CLR(C0, 1e-12), DLR(D0, 1e-12);
+    const FRANK::Hierarchical CH = FRANK::split(C0, 2, 2, true);
+    const FRANK::Hierarchical DH = FRANK::split(D0, 2, 2, true);
+    check(X, C0, true);
+    check(X, CLR, true);
+    check(X, CH, true);
+    check(XLR, C0, true);
+    check(XLR, CLR, true);
+    check(XLR, CH, true);
+    const FRANK::Hierarchical XH = FRANK::split(X, 2, 2, true);
+    check(XH, C0, true);
+    check(XH, CLR, true);
+    check(Y, D0, false);
+    check(Y, DLR, false);
+    check(Y, DH, false);
+    check(YLR, D0, false);
+    check(YLR, DLR, false);
+    check(YLR, DH, false);
+    const FRANK::Hierarchical YH = FRANK::split(Y, 2, 2, true);
+    check(YH, D0, false);
+    check(YH, DLR, false);
+  }
+}
+
+TEST(MixedPrecisionLowRankTest, TrsmWithAdaptedFactors) {
+  FRANK::initialize();
+  constexpr int64_t n = 256, nleaf = 16, rank = 8, nblocks = 2;
+  const std::vector<std::vector<double>> randx{FRANK::get_sorted_random_vector(n)};
+  FRANK::Hierarchical A(
+    FRANK::laplacend, randx, n, n, rank, nleaf, 0, nblocks, nblocks
+  );
+  const FRANK::Hierarchical B(A);
+  const FRANK::Dense x(FRANK::random_uniform, {}, n);
+  FRANK::Dense b(n);
+  FRANK::gemm(A, x, b, 1, 0);
+  FRANK::MatrixProxy L, U;
+  std::tie(L, U) = FRANK::getrf(A);
+  const FRANK::MatrixProxy L_mp = FRANK::adapt_precision(L, 1e-12);
+  const FRANK::MatrixProxy U_mp = FRANK::adapt_precision(U, 1e-12);
+  EXPECT_LT(FRANK::get_memory_usage(L_mp), FRANK::get_memory_usage(L));
+
+  FRANK::trsm(L_mp, b, FRANK::Mode::Lower);
+  FRANK::trsm(U_mp, b, FRANK::Mode::Upper);
+  EXPECT_LE(FRANK::l2_error(x, b), 1e-6);
+
+  // A Hierarchical right hand side reaches the LowRank and Hierarchical
+  // products of the off-diagonal blocks
+  FRANK::Hierarchical X_ref(B), X_mp(B);
+  FRANK::trsm(L, X_ref, FRANK::Mode::Lower);
+  FRANK::trsm(L_mp, X_mp, FRANK::Mode::Lower);
+  EXPECT_LE(FRANK::l2_error(X_ref, X_mp), 1e-8);
+}
@@ -0,0 +1,120 @@
+#include "FRANK/FRANK.h"
+#include "FRANK/classes/initialization_helpers/cluster_tree.h"
+#include "FRANK/classes/initialization_helpers/index_range.h"
+#include "FRANK/classes/initialization_helpers/matrix_initializer_kernel.h"
+
+#include "gtest/gtest.h"
+
+#include <cstdint>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+
+class OutOfCoreTest : public testing::Test {
+ protected:
+  static constexpr int64_t N = 256;
+  static constexpr int64_t rank = 8;
+  int64_t nleaf = 16, nblocks = 4;
+  double admis = 0;
+  std::vector<std::vector<double>> randx;
+  FRANK::Dense x, b;
+  FRANK::Hierarchical A;
+  void SetUp() override {
+    FRANK::initialize();
+    randx = {FRANK::get_sorted_random_vector(N)};
+    x = FRANK::Dense(FRANK::random_uniform, {}, N);
+    b = FRANK::Dense(N);
+    A = FRANK::Hierarchical(
+      FRANK::laplacend, randx, N, N, rank, nleaf, admis, nblocks, nblocks
+    );
+    FRANK::gemm(A, x, b, 1, 1);
+  }
+};
+
+TEST_F(OutOfCoreTest, GetrfTrsm) {
+  // In-memory reference with the same block operations
+  FRANK::Hierarchical A_copy(A), L, U;
+  std::tie(L, U) = FRANK::getrf(A_copy);
+  FRANK::Dense b_check(b);
+  FRANK::trsm(L, b_check, FRANK::Mode::Lower);
+  FRANK::trsm(U, b_check, FRANK::Mode::Upper);
+
+  // A quarter of the matrix fits into memory
+  const uint64_t budget = FRANK::get_memory_usage(A) / 4;
+  FRANK::OutOfCoreHierarchical A_ooc(std::move(A), budget);
+  FRANK::getrf(A_ooc);
+  FRANK::trsm(A_ooc, b, FRANK::Mode::Lower);
+  FRANK::trsm(A_ooc, b, FRANK::Mode::Upper);
+  EXPECT_LE(FRANK::l2_error(b_check, b), 1e-12);
+  EXPECT_LE(FRANK::l2_error(x, b), 1e-6);
+
+  const FRANK::OutOfCoreStatistics stats = A_ooc.get_statistics();
+  EXPECT_GT(stats.bytes_written, 0);
+  EXPECT_GT(stats.bytes_read, 0);
+  EXPECT_GT(stats.blocks_read, 0);
+  EXPECT_GT(stats.hits, 0);
+  EXPECT_GE(stats.stall_time, 0);
+  EXPECT_LE(stats.peak_memory, budget);
+}
+
+TEST_F(OutOfCoreTest, ConstructionFromClusterTree) {
+  const FRANK::MatrixInitializerKernel initializer(
+    FRANK::laplacend, randx, admis, 0, rank, FRANK::AdmisType::PositionBased
+  );
+  const FRANK::ClusterTree cluster_tree(
+    {0, N}, {0, N}, nblocks, nblocks, nleaf
+  );
+  const uint64_t budget = FRANK::get_memory_usage(A) / 4;
+  FRANK::OutOfCoreHierarchical A_ooc(cluster_tree, initializer, true, budget);
+  EXPECT_GT(A_ooc.get_statistics().bytes_written, 0);
+  EXPECT_EQ(A_ooc.get_n_rows(1), N / nblocks);
+  FRANK::getrf(A_ooc);
+  FRANK::trsm(A_ooc, b, FRANK::Mode::Lower);
+  FRANK::trsm(A_ooc, b, FRANK::Mode::Upper);
+  EXPECT_LE(FRANK::l2_error(x, b), 1e-6);
+}
+
+TEST_F(OutOfCoreTest, NestedHierarchical) {
+  // Three levels of Hierarchical blocks, leaves are spilled individually
+  nblocks = 2;
+  A = FRANK::Hierarchical(
+    FRANK::laplacend, randx, N, N, rank, nleaf, admis, nblocks, nblocks
+  );
+  b = FRANK::Dense(N);
+  FRANK::gemm(A, x, b, 1, 1);
+  FRANK::Hierarchical A_copy(A), L, U;
+  std::tie(L, U) = FRANK::getrf(A_copy);
+  FRANK::Dense b_check(b);
+  FRANK::trsm(L, b_check, FRANK::Mode::Lower);
+  FRANK::trsm(U, b_check, FRANK::Mode::Upper);
+
+  const uint64_t budget = FRANK::get_memory_usage(A) / 4;
+  FRANK::OutOfCoreHierarchical A_ooc(std::move(A), budget);
+  FRANK::getrf(A_ooc);
+  FRANK::trsm(A_ooc, b, FRANK::Mode::Lower);
+  FRANK::trsm(A_ooc, b, FRANK::Mode::Upper);
+  EXPECT_LE(FRANK::l2_error(b_check, b), 1e-12);
+  EXPECT_LE(FRANK::l2_error(x, b), 1e-6);
+
+  const FRANK::OutOfCoreStatistics stats = A_ooc.get_statistics();
+  EXPECT_GT(stats.bytes_written, 0);
+  EXPECT_GT(stats.blocks_read, 0);
+  EXPECT_GT(stats.hits, 0);
+  // Resident leaves never exceed the budget
+  EXPECT_GT(stats.peak_memory, 0);
+  EXPECT_LE(stats.peak_memory, budget);
+}
+
+TEST_F(OutOfCoreTest, UnlimitedBudget) {
+  const uint64_t budget = FRANK::get_memory_usage(A) * 100;
+  FRANK::OutOfCoreHierarchical A_ooc(std::move(A), budget);
+  FRANK::getrf(A_ooc);
+  FRANK::trsm(A_ooc, b, FRANK::Mode::Lower);
+  FRANK::trsm(A_ooc, b, FRANK::Mode::Upper);
+  EXPECT_LE(FRANK::l2_error(x, b), 1e-6);
+  // Nothing is ever spilled
+  const FRANK::OutOfCoreStatistics stats = A_ooc.get_statistics();
+  EXPECT_EQ(stats.bytes_written, 0);
+  EXPECT_EQ(stats.misses, 0);
+}
@@ -0,0 +1,64 @@
+#include "FRANK/FRANK.h"
+
+#include "gtest/gtest.h"
+
+#include <cstdint>
+#include <random>
+#include <tuple>
+#include <vector>
+
+
+class PermutedHierarchicalTest : public testing::Test {
+ protected:
+  static constexpr int64_t N = 1000;
+  int64_t nleaf = 32;
+  std::vector<std::vector<double>> x;
+  void SetUp() override {
+    FRANK::initialize();
+    // Unsorted points, a dense cluster next to a sparse one
+    std::mt19937 generator(0);
+    std::uniform_real_distribution<double> distribution(0, 1);
+    x.resize(2);
+    for (int64_t i=0; i<N; ++i) {
+      const double scale = i % 4 == 0 ? 16 : 1;
+      for (std::vector<double>& axis : x) {
+        axis.push_back(scale * distribution(generator));
+      }
+    }
+  }
+};
+
+TEST_F(PermutedHierarchicalTest, Reorder) {
+  std::vector<std::vector<double>> x_permuted(x);
+  std::vector<int64_t> perm;
+  FRANK::geometric_bisection(x_permuted, perm, nleaf);
+  const FRANK::PermutedHierarchical A(FRANK::Hierarchical(1, 1), perm);
+  // Enough columns to be reordered by several threads
+  const FRANK::Dense B(FRANK::random_uniform, {}, N, 100);
+  FRANK::Dense B_copy(B);
+  A.to_permuted(B_copy);
+  for (int64_t i=0; i<N; ++i) {
+    EXPECT_EQ(B_copy(i, 0), B(perm[i], 0));
+    EXPECT_EQ(B_copy(i, 99), B(perm[i], 99));
+  }
+  A.to_original(B_copy);
+  EXPECT_EQ(FRANK::l2_error(B, B_copy), 0);
+}
+
+TEST_F(PermutedHierarchicalTest, MultiplyAndSolve) {
+  const double eps = 1e-8;
+  FRANK::PermutedHierarchical A(FRANK::laplacend, x, nleaf, eps);
+  // Right hand sides and solutions in the original order of the points
+  const FRANK::Dense D(FRANK::laplacend, x, N, N);
+  const FRANK::Dense X(FRANK::random_uniform, {}, N, 2);
+  FRANK::Dense B(N, 2), B_check(N, 2);
+  FRANK::gemm(D, X, B_check, 1, 0);
+  FRANK::gemm(A, X, B, 1, 0);
+  EXPECT_LE(FRANK::l2_error(B_check, B), eps);
+
+  FRANK::PermutedHierarchical L, U;
+  std::tie(L, U) = FRANK::getrf(A);
+  FRANK::trsm(L, B, FRANK::Mode::Lower);
+  FRANK::trsm(U, B, FRANK::Mode::Upper);
+  EXPECT_LE(FRANK::l2_error(X, B), 1e-6);
+}
@@ -0,0 +1,173 @@
+#include "FRANK/FRANK.h"
+
+#include "gtest/gtest.h"
+
+#include <cstdint>
+#include <cstdio>
+#include <string>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+#include <sys/wait.h>
+#include <unistd.h>
+
+
+class SerializationTest : public testing::Test {
+ protected:
+  static constexpr int64_t N = 256;
+  static constexpr int64_t rank = 8;
+  int64_t nleaf = 16, nblocks = 4;
+  double admis = 0;
+  std::vector<std::vector<double>> randx;
+  FRANK::Hierarchical A;
+  std::string filename;
+  void SetUp() override {
+    FRANK::initialize();
+    randx = {FRANK::get_sorted_random_vector(N)};
+    A = FRANK::Hierarchical(
+      FRANK::laplacend, randx, N, N, rank, nleaf, admis, nblocks, nblocks
+    );
+    filename = testing::TempDir() + "FRANK_serialization.bin";
+  }
+  void TearDown() override {
+    std::remove(filename.c_str());
+  }
+};
+
+TEST_F(SerializationTest, Buffer) {
+  const FRANK::LowRank LR(FRANK::Dense(FRANK::laplacend, randx, N/2, N/2, 0, N/2), rank);
+  std::vector<char> buffer;
+  FRANK::serialize(A, buffer);
+  FRANK::serialize(LR, buffer);
+  const char* position = buffer.data();
+  const FRANK::Hierarchical A_copy(FRANK::deserialize(position));
+  const FRANK::LowRank LR_copy(FRANK::deserialize(position));
+  EXPECT_EQ(position, buffer.data() + buffer.size());
+  EXPECT_EQ(FRANK::l2_error(A, A_copy), 0);
+  EXPECT_EQ(FRANK::l2_error(LR, LR_copy), 0);
+}
+
+TEST_F(SerializationTest, SaveLoad) {
+  FRANK::save(A, filename);
+  FRANK::Hierarchical A_loaded(FRANK::load(filename, true));
+  EXPECT_EQ(FRANK::l2_error(A, A_loaded), 0);
+  // Modifying the loaded matrix does not change the file
+  FRANK::Hierarchical L, U;
+  std::tie(L, U) = FRANK::getrf(A_loaded);
+  const FRANK::Hierarchical A_reloaded(FRANK::load(filename, true));
+  EXPECT_EQ(FRANK::l2_error(A, A_reloaded), 0);
+  // Dense matrices are views into the file
+  const FRANK::Dense D(FRANK::laplacend, randx, N, N);
+  FRANK::save(D, filename, false);
+  const FRANK::Dense D_loaded(FRANK::load(filename));
+  EXPECT_TRUE(D_loaded.is_mapped());
+  EXPECT_FALSE(D_loaded.is_submatrix());
+  EXPECT_EQ(FRANK::l2_error(D, D_loaded), 0);
+  // Releasing a modified private view keeps the modification
+  FRANK::Dense D_modified(FRANK::load(filename));
+  D_modified = 0;
+  D_modified.advise(FRANK::MemoryAccess::DontNeed);
+  EXPECT_EQ(FRANK::norm(D_modified), 0);
+}
+
+TEST_F(SerializationTest, CheckpointResume) {
+  FRANK::Hierarchical A_copy(A), L_check, U_check;
+  std::tie(L_check, U_check) = FRANK::getrf(A_copy);
+
+  // With an interval of nblocks, only the final checkpoint is written
+  FRANK::Hierarchical A_full(A);
+  FRANK::getrf(A_full, filename, nblocks);
+  std::vector<FRANK::MatrixProxy> saved;
+  int64_t step;
+  std::tie(saved, step) = FRANK::load_checkpoint(filename, true);
+  ASSERT_EQ(saved.size(), 2);
+  EXPECT_EQ(step, nblocks);
+
+  // Checkpoint after the first block column, as if interrupted
+  std::remove(filename.c_str());
+  {
+    FRANK::Hierarchical L(nblocks, nblocks), U(A);
+    std::tie(L(0, 0), U(0, 0)) = FRANK::getrf(U(0, 0));
+    for (int64_t i=1; i<nblocks; ++i) {
+      L(i, 0) = std::move(U(i, 0));
+      U(i, 0) = FRANK::Empty(
+        FRANK::get_n_rows(L(i, 0)), FRANK::get_n_cols(L(i, 0))
+      );
+      FRANK::trsm(U(0, 0), L(i, 0), FRANK::Mode::Upper, FRANK::Side::Right);
+      L(0, i) = FRANK::Empty(FRANK::get_n_rows(U(0, i)), FRANK::get_n_cols(U(0, i)));
+      FRANK::trsm(L(0, 0), U(0, i), FRANK::Mode::Lower, FRANK::Side::Left);
+    }
+    for (int64_t i=1; i<nblocks; ++i) {
+      for (int64_t j=1; j<nblocks; ++j) {
+        FRANK::gemm(L(i, 0), U(0, j), U(i, j), -1, 1);
+        L(i, j) = FRANK::Empty(FRANK::get_n_rows(U(i, j)), FRANK::get_n_cols(U(i, j)));
+      }
+    }
+    FRANK::save_checkpoint({&L, &U}, 1, filename, true, FRANK::fingerprint(A));
+  }
+  EXPECT_EQ(FRANK::checkpoint_fingerprint(filename), FRANK::fingerprint(A));
+  // Resuming continues after the first block column
+  FRANK::Hierarchical A_resumed(A), L, U;
+  std::tie(L, U) = FRANK::getrf(A_resumed, filename);
+  EXPECT_EQ(FRANK::l2_error(L_check, L), 0);
+  EXPECT_EQ(FRANK::l2_error(U_check, U), 0);
+  // A completed checkpoint returns the factors directly
+  FRANK::Hierarchical A_done(A), L_done, U_done;
+  std::tie(L_done, U_done) = FRANK::getrf(A_done, filename);
+  EXPECT_EQ(FRANK::l2_error(L_check, L_done), 0);
+  EXPECT_EQ(FRANK::l2_error(U_check, U_done), 0);
+  // A checkpoint of a different matrix is ignored and overwritten
+  std::vector<std::vector<double>> randx_B(randx);
+  for (double& x : randx_B[0]) x *= 2;
+  const FRANK::Hierarchical B(
+    FRANK::laplacend, randx_B, N, N, rank, nleaf, admis, nblocks, nblocks
+  );
+  EXPECT_NE(FRANK::fingerprint(B), FRANK::fingerprint(A));
+  FRANK::Hierarchical B_copy(B), B_work(B), L_B_check, U_B_check, L_B, U_B;
+  std::tie(L_B_check, U_B_check) = FRANK::getrf(B_copy);
+  std::tie(L_B, U_B) = FRANK::getrf(B_work, filename);
+  EXPECT_EQ(FRANK::l2_error(L_B_check, L_B), 0);
+  EXPECT_EQ(FRANK::l2_error(U_B_check, U_B), 0);
+  EXPECT_EQ(FRANK::checkpoint_fingerprint(filename), FRANK::fingerprint(B));
+}
+
+TEST_F(SerializationTest, SharedMemory) {
+  const std::string name = "/FRANK_serialization_test_" + std::to_string(getpid());
+  const FRANK::Dense x(FRANK::random_uniform, {}, N);
+  FRANK::Dense b(N);
+  FRANK::gemm(A, x, b, 1, 1);
+  FRANK::Hierarchical A_copy(A), L, U;
+  std::tie(L, U) = FRANK::getrf(A_copy);
+  FRANK::publish({&A, &L, &U}, name);
+
+  // Another process multiplies and solves with read-only views
+  const pid_t pid = fork();
+  ASSERT_NE(pid, -1);
+  if (pid == 0) {
+    std::vector<FRANK::MatrixProxy> shared = FRANK::attach(name, true);
+    if (shared.size() != 3) _exit(1);
+    FRANK::Dense b_shared(N);
+    FRANK::gemm(shared[0], x, b_shared, 1, 1);
+    if (FRANK::l2_error(b, b_shared) != 0) _exit(2);
+    FRANK::trsm(shared[1], b_shared, FRANK::Mode::Lower);
+    FRANK::trsm(shared[2], b_shared, FRANK::Mode::Upper);
+    if (FRANK::l2_error(x, b_shared) > 1e-6) _exit(3);
+    _exit(0);
+  }
+  int status;
+  ASSERT_EQ(waitpid(pid, &status, 0), pid);
+  ASSERT_TRUE(WIFEXITED(status));
+  EXPECT_EQ(WEXITSTATUS(status), 0);
+
+  std::vector<FRANK::MatrixProxy> shared = FRANK::attach(name);
+  std::vector<FRANK::MatrixProxy> modified = FRANK::attach(name);
+  FRANK::unpublish(name);
+  // Attached matrices stay valid after the object is removed
+  EXPECT_EQ(FRANK::l2_error(A, shared[0]), 0);
+  // Attached matrices are copy-on-write, so writes stay private to them
+  std::tie(L, U) = FRANK::getrf(modified[0]);
+  modified[1] *= 2;
+  EXPECT_EQ(FRANK::l2_error(A, shared[0]), 0);
+  EXPECT_EQ(FRANK::l2_error(L, shared[1]), 0);
+}
@@ -0,0 +1,110 @@
+#include <algorithm>
+#include <cstdint>
+#include <string>
+#include <tuple>
+#include <vector>
+
+#include "FRANK/FRANK.h"
+#include "FRANK/operations/small_kernels.h"
+#include "gtest/gtest.h"
+
+// The small kernels are compared against the BLAS/LAPACK versions by padding
+// one dimension of the operands beyond SMALL_KERNEL_MAX_DIM with zeros, which
+// does not change the result of the operation.
+class SmallKernelTests
+    : public testing::TestWithParam<std::tuple<int64_t, int64_t, bool, bool>> {
+ protected:
+  void SetUp() override {
+    FRANK::initialize();
+    std::tie(m, n, TransA, TransB) = GetParam();
+  }
+  int64_t m, n;
+  bool TransA, TransB;
+};
+
+constexpr int64_t PAD = FRANK::SMALL_KERNEL_MAX_DIM + 8;
+constexpr double EPSILON = 1e-12;
+
+FRANK::Dense pad(const FRANK::Dense& A, const int64_t n_rows, const int64_t n_cols) {
+  FRANK::Dense out(n_rows, n_cols);
+  for (int64_t i=0; i<A.dim[0]; ++i) {
+    for (int64_t j=0; j<A.dim[1]; ++j) {
+      out(i, j) = A(i, j);
+    }
+  }
+  return out;
+}
+
+TEST_P(SmallKernelTests, Gemm) {
+  const int64_t k = n/2 + 1;
+  const FRANK::Dense A(FRANK::random_normal, {}, TransA ? k : m, TransA ? m : k);
+  const FRANK::Dense B(FRANK::random_normal, {}, TransB ? n : k, TransB ? k : n);
+  FRANK::Dense C(FRANK::random_normal, {}, m, n);
+  FRANK::Dense C_check(C);
+  FRANK::gemm(A, B, C, 2, 0.5, TransA, TransB);
+  const FRANK::Dense A_pad = TransA ? pad(A, PAD, m) : pad(A, m, PAD);
+  const FRANK::Dense B_pad = TransB ? pad(B, n, PAD) : pad(B, PAD, n);
+  FRANK::gemm(A_pad, B_pad, C_check, 2, 0.5, TransA, TransB);
+  EXPECT_LE(FRANK::l2_error(C_check, C), EPSILON);
+}
+
+TEST_P(SmallKernelTests, Trmm) {
+  const FRANK::Dense A(FRANK::random_normal, {}, m, m);
+  const FRANK::Mode uplo = TransB ? FRANK::Mode::Upper : FRANK::Mode::Lower;
+  const char trans = TransA ? 't' : 'n';
+  const char diag = TransB ? 'n' : 'u';
+  FRANK::Dense B(FRANK::random_normal, {}, m, n);
+  FRANK::Dense B_check = pad(B, m, PAD);
+  FRANK::trmm(A, B, FRANK::Side::Left, uplo, trans, diag, 1.5);
+  FRANK::trmm(A, B_check, FRANK::Side::Left, uplo, trans, diag, 1.5);
+  EXPECT_LE(FRANK::l2_error(resize(B_check, m, n), B), EPSILON);
+
+  FRANK::Dense C(FRANK::random_normal, {}, n, m);
+  FRANK::Dense C_check = pad(C, PAD, m);
+  FRANK::trmm(A, C, FRANK::Side::Right, uplo, trans, diag, 1.5);
+  FRANK::trmm(A, C_check, FRANK::Side::Right, uplo, trans, diag, 1.5);
+  EXPECT_LE(FRANK::l2_error(resize(C_check, n, m), C), EPSILON);
+}
+
+TEST_P(SmallKernelTests, Trsm) {
+  // Diagonally dominant to keep the solves well conditioned
+  FRANK::Dense A(FRANK::random_uniform, {}, m, m);
+  for (int64_t i=0; i<m; ++i) A(i, i) += m;
+  const FRANK::Mode uplo = TransB ? FRANK::Mode::Upper : FRANK::Mode::Lower;
+  const FRANK::Side side = TransA ? FRANK::Side::Right : FRANK::Side::Left;
+  const int64_t n_rows = TransA ? n : m;
+  const int64_t n_cols = TransA ? m : n;
+  FRANK::Dense B(FRANK::random_normal, {}, n_rows, n_cols);
+  FRANK::Dense B_check = TransA ? pad(B, PAD, n_cols) : pad(B, n_rows, PAD);
+  FRANK::trsm(A, B, uplo, side);
+  FRANK::trsm(A, B_check, uplo, side);
+  EXPECT_LE(FRANK::l2_error(resize(B_check, n_rows, n_cols), B), EPSILON);
+}
+
+TEST_P(SmallKernelTests, Qr) {
+  // The padded LAPACK version needs as many columns in Q as there are in A
+  const int64_t n_cols = std::min(m, n);
+  const int64_t k = n_cols;
+  FRANK::Dense A(FRANK::random_normal, {}, m, n_cols);
+  FRANK::Dense A_check = pad(A, PAD, n_cols);
+  FRANK::Dense Q(m, k), R(k, n_cols);
+  FRANK::Dense Q_check(PAD, k), R_check(k, n_cols);
+  FRANK::qr(A, Q, R);
+  FRANK::qr(A_check, Q_check, R_check);
+  EXPECT_LE(FRANK::l2_error(R_check, R), EPSILON);
+  EXPECT_LE(FRANK::l2_error(resize(Q_check, m, k), Q), EPSILON);
+}
+
+INSTANTIATE_TEST_SUITE_P(
+    BLAS, SmallKernelTests,
+    testing::Combine(testing::Values(1, 4, 13, 32), testing::Values(1, 8, 32),
+                     testing::Values(true, false), testing::Values(true, false)),
+    [](const testing::TestParamInfo<SmallKernelTests::ParamType>& info) {
+      std::string name = (
+        "m" + std::to_string(std::get<0>(info.param))
+        + "n" + std::to_string(std::get<1>(info.param))
+        + (std::get<2>(info.param) ? "T" : "N")
+        + (std::get<3>(info.param) ? "T" : "N")
+      );
+      return name;
+    });
@@ -0,0 +1,139 @@
+#include "FRANK/FRANK.h"
+#include "solve_server_protocol.h"
+
+#include "gtest/gtest.h"
+
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <signal.h>
+#include <sys/socket.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+
+// Drives solve_server over its socket protocol. The server is started as a
+// child process with a Laplace kernel matrix of size N.
+class SolveServerTest : public testing::Test {
+ protected:
+  static constexpr int64_t N = 256;
+  static constexpr int64_t max_batch = 8;
+  std::string socket_path;
+  pid_t server = -1;
+  void SetUp() override {
+    FRANK::initialize();
+    socket_path = testing::TempDir() + "FRANK_solve_server_" + std::to_string(getpid());
+    server = fork();
+    ASSERT_NE(server, -1);
+    if (server == 0) {
+      freopen("/dev/null", "w", stdout);
+      execl(
+        SOLVE_SERVER_PATH, SOLVE_SERVER_PATH, socket_path.c_str(),
+        std::to_string(N).c_str(), "32", "1e-8",
+        std::to_string(max_batch).c_str(), "200", static_cast<char*>(nullptr)
+      );
+      _exit(127);
+    }
+  }
+  void TearDown() override {
+    if (server > 0) {
+      kill(server, SIGKILL);
+      waitpid(server, nullptr, 0);
+    }
+    unlink(socket_path.c_str());
+  }
+  // Connect once the server has factorized the matrix and is listening
+  int connect_to_server() {
+    const sockaddr_un address = socket_address(socket_path);
+    for (int attempt=0; attempt<600; ++attempt) {
+      const int connection = socket(AF_UNIX, SOCK_STREAM, 0);
+      if (
+        connect(connection, reinterpret_cast<const sockaddr*>(&address), sizeof(address)) == 0
+      ) {
+        return connection;
+      }
+      close(connection);
+      std::this_thread::sleep_for(std::chrono::milliseconds(100));
+    }
+    return -1;
+  }
+  // Send a request and return the header of the reply, with the result in x
+  MessageHeader request(
+    const int connection, const Operation operation, const FRANK::Dense& rhs,
+    FRANK::Dense& x
+  ) {
+    const MessageHeader header{operation, rhs.dim[0], rhs.dim[1]};
+    MessageHeader reply{operation, -1, 0};
+    const uint64_t n_bytes = rhs.dim[0]*rhs.dim[1]*sizeof(double);
+    x = FRANK::Dense(rhs.dim[0], rhs.dim[1]);
+    if (
+      write_all(connection, &header, sizeof(header))
+      && write_all(connection, &rhs, n_bytes)
+      && read_all(connection, &reply, sizeof(reply))
+      && reply.n_rows == rhs.dim[0]
+    ) {
+      read_all(connection, &x, n_bytes);
+    }
+    return reply;
+  }
+  // Shut the server down and return its exit status
+  int shutdown_server() {
+    const int connection = connect_to_server();
+    const MessageHeader header{Operation::Shutdown, 0, 0};
+    MessageHeader reply;
+    write_all(connection, &header, sizeof(header));
+    read_all(connection, &reply, sizeof(reply));
+    close(connection);
+    int status = -1;
+    waitpid(server, &status, 0);
+    server = -1;
+    return status;
+  }
+};
+
+TEST_F(SolveServerTest, SolveAndMatvec) {
+  const int connection = connect_to_server();
+  ASSERT_NE(connection, -1);
+  const FRANK::Dense x(FRANK::random_uniform, {}, N, 2);
+  FRANK::Dense b, x_solved;
+  EXPECT_EQ(request(connection, Operation::Matvec, x, b).n_rows, N);
+  EXPECT_EQ(request(connection, Operation::Solve, b, x_solved).n_rows, N);
+  EXPECT_LE(FRANK::l2_error(x, x_solved), 1e-6);
+  close(connection);
+  const int status = shutdown_server();
+  EXPECT_TRUE(WIFEXITED(status));
+  EXPECT_EQ(WEXITSTATUS(status), 0);
+}
+
+TEST_F(SolveServerTest, RejectsMalformedHeaders) {
+  for (const MessageHeader& header : std::vector<MessageHeader>{
+    {Operation::Solve, N, int64_t(1) << 40},
+    {Operation::Solve, N, max_batch + 1},
+    {Operation::Matvec, N + 1, 1},
+    {Operation::Matvec, N, 0}
+  }) {
+    const int connection = connect_to_server();
+    ASSERT_NE(connection, -1);
+    MessageHeader reply;
+    ASSERT_TRUE(write_all(connection, &header, sizeof(header)));
+    ASSERT_TRUE(read_all(connection, &reply, sizeof(reply)));
+    EXPECT_EQ(reply.n_rows, -1);
+    // The connection is closed after an invalid request
+    EXPECT_FALSE(read_all(connection, &reply, sizeof(reply)));
+    close(connection);
+  }
+  // The server keeps serving other clients
+  const int connection = connect_to_server();
+  ASSERT_NE(connection, -1);
+  const FRANK::Dense x(FRANK::random_uniform, {}, N, max_batch);
+  FRANK::Dense b;
+  EXPECT_EQ(request(connection, Operation::Matvec, x, b).n_rows, N);
+  close(connection);
+  const int status = shutdown_server();
+  EXPECT_TRUE(WIFEXITED(status));
+  EXPECT_EQ(WEXITSTATUS(status), 0);
+}
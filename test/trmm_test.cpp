@@ -286,7 +286,7 @@ INSTANTIATE_TEST_SUITE_P(TRMMTests, TRMMTests,
                                           testing::Values(32, 64, 128),
                                           testing::Values(FRANK::Side::Left, FRANK::Side::Right),
                                           testing::Values(FRANK::Mode::Upper, FRANK::Mode::Lower),
-                                          testing::Values('n'),
+                                          testing::Values('n', 't'),
                                           testing::Values('u', 'n'),
                                           testing::Values(1.0, 2.0)
                                           ));